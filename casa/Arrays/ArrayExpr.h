@@ -0,0 +1,378 @@
+//# ArrayExpr.h: Lazily evaluated element-wise array expressions
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_ARRAYEXPR_H
+#define CASA_ARRAYEXPR_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicMath/Functors.h>
+#include <functional>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+//    Lazily evaluated element-wise array expressions.
+// </summary>
+// <reviewed reviewer="" date="" tests="tArrayExpr">
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+//   <li> <linkto group="ArrayMath.h#Array mathematical operations">ArrayMath</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// The operators and functions in ArrayMath.h create a new Array for
+// each operation. Thus an expression like <src>a*b + c*d - e</src>
+// results in four passes through the data and four temporary arrays.
+// <br>The classes and functions in this file build such an expression
+// as a tree of lightweight objects (expression templates) without
+// evaluating it. The expression is evaluated element by element in a
+// single loop when it is assigned to an array, so no temporary arrays
+// are needed.
+//
+// An expression is started by wrapping an array with the function
+// <src>arrayExpr</src>. Thereafter the usual arithmetic operators and
+// mathematical functions can be used on it, where the other operand
+// can be an expression, an array or a scalar. The shapes of array
+// operands must be equal (an exception is thrown otherwise).
+// The ordinary Array operators are not affected, so existing code
+// behaves as before.
+//
+// The result can be obtained in the following ways:
+// <ul>
+//  <li> <src>expr.evaluate(array)</src> stores the result in an existing
+//       array (e.g. a Vector or a section of an array).
+//       It is resized if empty, otherwise its shape must be equal.
+//  <li> The expression can be converted to an Array, for instance by
+//       assigning it to an Array or passing it as a <src>const Array&</src>.
+//       The result array is created and filled in one pass.
+//  <li> <src>sum(expr)</src> sums the elements without creating an array.
+// </ul>
+// An array operand which is not contiguous (e.g. an array section) is
+// copied to a contiguous array when the expression is created, so the
+// evaluation loop can always use plain indexing. The result array does
+// not need to be contiguous.
+// <br>Elements are evaluated in order and element i only uses element i
+// of each operand, so the result array can also be an operand.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Vector<Double> a(n), b(n), c(n), d(n), e(n), res(n);
+//   ...
+//   // Evaluate in one loop without temporary arrays.
+//   (arrayExpr(a)*b + arrayExpr(c)*d - e).evaluate (res);
+//   // Create a new array.
+//   Array<Double> arr = sqrt(arrayExpr(a) * 2.);
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Avoid the memory allocations and memory bandwidth of temporary arrays
+// in expressions of several array operations.
+// </motivation>
+//
+// <group name="Array expression templates">
+
+
+// Leaf of an expression holding an array.
+// It references the array data; a non-contiguous array is copied.
+template<typename T> class ArrayExprLeaf
+{
+public:
+  typedef T value_type;
+  explicit ArrayExprLeaf (const Array<T>& arr)
+    : itsArray (arr.contiguousStorage()  ?  arr : arr.copy()),
+      itsData  (itsArray.data())
+  {}
+  const IPosition& shape() const
+    { return itsArray.shape(); }
+  Bool isScalar() const
+    { return False; }
+  T operator[] (size_t i) const
+    { return itsData[i]; }
+private:
+  Array<T> itsArray;
+  const T* itsData;
+};
+
+// Leaf of an expression holding a scalar.
+template<typename T> class ArrayExprScalar
+{
+public:
+  typedef T value_type;
+  explicit ArrayExprScalar (const T& value)
+    : itsValue (value)
+  {}
+  const IPosition& shape() const
+    { return itsShape; }
+  Bool isScalar() const
+    { return True; }
+  T operator[] (size_t) const
+    { return itsValue; }
+private:
+  T         itsValue;
+  IPosition itsShape;
+};
+
+// Node applying a unary operator to an expression.
+template<typename E, typename Op> class ArrayExprUnary
+{
+public:
+  typedef typename Op::result_type value_type;
+  ArrayExprUnary (const E& expr, Op op)
+    : itsExpr (expr),
+      itsOp   (op)
+  {}
+  const IPosition& shape() const
+    { return itsExpr.shape(); }
+  Bool isScalar() const
+    { return itsExpr.isScalar(); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsExpr[i]); }
+private:
+  E  itsExpr;
+  Op itsOp;
+};
+
+// Node applying a binary operator to two expressions.
+// The shapes are checked if both operands are arrays.
+template<typename L, typename R, typename Op> class ArrayExprBinary
+{
+public:
+  typedef typename Op::result_type value_type;
+  ArrayExprBinary (const L& left, const R& right, Op op, const char* name)
+    : itsLeft  (left),
+      itsRight (right),
+      itsOp    (op)
+  {
+    if (!left.isScalar()  &&  !right.isScalar()  &&
+        !left.shape().isEqual (right.shape())) {
+      throwArrayShapes (name);
+    }
+  }
+  const IPosition& shape() const
+    { return itsLeft.isScalar()  ?  itsRight.shape() : itsLeft.shape(); }
+  Bool isScalar() const
+    { return itsLeft.isScalar()  &&  itsRight.isScalar(); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsLeft[i], itsRight[i]); }
+private:
+  L  itsLeft;
+  R  itsRight;
+  Op itsOp;
+};
+
+
+// The expression object used by the operators and functions.
+// It wraps a node and evaluates it on request.
+template<typename E> class ArrayExpr
+{
+public:
+  typedef typename E::value_type value_type;
+
+  explicit ArrayExpr (const E& expr)
+    : itsExpr (expr)
+  {}
+
+  // Get the shape of the result.
+  const IPosition& shape() const
+    { return itsExpr.shape(); }
+
+  // Get the number of elements in the result.
+  size_t nelements() const
+    { return shape().product(); }
+
+  // Evaluate element i (in storage order).
+  value_type operator[] (size_t i) const
+    { return itsExpr[i]; }
+
+  Bool isScalar() const
+    { return itsExpr.isScalar(); }
+
+  // Evaluate the expression and store the result in the given array.
+  // It is resized if empty, otherwise the shape must be equal.
+  void evaluate (Array<value_type>& result) const
+  {
+    if (result.nelements() == 0) {
+      result.resize (shape());
+    } else if (! result.shape().isEqual (shape())) {
+      throwArrayShapes ("ArrayExpr::evaluate");
+    }
+    size_t n = result.nelements();
+    if (result.contiguousStorage()) {
+      value_type* data = result.data();
+      for (size_t i=0; i<n; ++i) {
+        data[i] = itsExpr[i];
+      }
+    } else {
+      typename Array<value_type>::iterator iter = result.begin();
+      for (size_t i=0; i<n; ++i, ++iter) {
+        *iter = itsExpr[i];
+      }
+    }
+  }
+
+  // Evaluate the expression into a new (contiguous) array.
+  operator Array<value_type>() const
+  {
+    Array<value_type> result (shape(), ArrayInitPolicy::NO_INIT);
+    evaluate (result);
+    return result;
+  }
+
+private:
+  E itsExpr;
+};
+
+
+// Start an expression from an array.
+template<typename T>
+inline ArrayExpr<ArrayExprLeaf<T> > arrayExpr (const Array<T>& arr)
+{
+  return ArrayExpr<ArrayExprLeaf<T> > (ArrayExprLeaf<T>(arr));
+}
+
+// Sum the elements of an expression without creating an array.
+template<typename E>
+inline typename E::value_type sum (const ArrayExpr<E>& expr)
+{
+  typename E::value_type result = typename E::value_type();
+  size_t n = expr.nelements();
+  for (size_t i=0; i<n; ++i) {
+    result += expr[i];
+  }
+  return result;
+}
+
+
+// Define a binary operator or function for combinations of
+// expressions, arrays and scalars.
+#define ARRAYEXPR_BINARY(NAME, FUNCTOR)                                     \
+template<typename L, typename R>                                            \
+inline ArrayExpr<ArrayExprBinary<ArrayExpr<L>, ArrayExpr<R>,                \
+                 FUNCTOR<typename L::value_type> > >                        \
+NAME (const ArrayExpr<L>& left, const ArrayExpr<R>& right)                  \
+{                                                                           \
+  typedef FUNCTOR<typename L::value_type> Op;                               \
+  typedef ArrayExprBinary<ArrayExpr<L>, ArrayExpr<R>, Op> Node;             \
+  return ArrayExpr<Node> (Node(left, right, Op(), #NAME));                  \
+}                                                                           \
+template<typename L, typename T>                                            \
+inline ArrayExpr<ArrayExprBinary<ArrayExpr<L>, ArrayExprLeaf<T>,            \
+                 FUNCTOR<T> > >                                             \
+NAME (const ArrayExpr<L>& left, const Array<T>& right)                      \
+{                                                                           \
+  typedef FUNCTOR<T> Op;                                                    \
+  typedef ArrayExprBinary<ArrayExpr<L>, ArrayExprLeaf<T>, Op> Node;         \
+  return ArrayExpr<Node> (Node(left, ArrayExprLeaf<T>(right), Op(), #NAME)); \
+}                                                                           \
+template<typename T, typename R>                                            \
+inline ArrayExpr<ArrayExprBinary<ArrayExprLeaf<T>, ArrayExpr<R>,            \
+                 FUNCTOR<T> > >                                             \
+NAME (const Array<T>& left, const ArrayExpr<R>& right)                      \
+{                                                                           \
+  typedef FUNCTOR<T> Op;                                                    \
+  typedef ArrayExprBinary<ArrayExprLeaf<T>, ArrayExpr<R>, Op> Node;         \
+  return ArrayExpr<Node> (Node(ArrayExprLeaf<T>(left), right, Op(), #NAME)); \
+}                                                                           \
+template<typename L>                                                        \
+inline ArrayExpr<ArrayExprBinary<ArrayExpr<L>,                              \
+                 ArrayExprScalar<typename L::value_type>,                   \
+                 FUNCTOR<typename L::value_type> > >                        \
+NAME (const ArrayExpr<L>& left, const typename L::value_type& right)        \
+{                                                                           \
+  typedef typename L::value_type T;                                         \
+  typedef FUNCTOR<T> Op;                                                    \
+  typedef ArrayExprBinary<ArrayExpr<L>, ArrayExprScalar<T>, Op> Node;       \
+  return ArrayExpr<Node> (Node(left, ArrayExprScalar<T>(right), Op(),       \
+                               #NAME));                                     \
+}                                                                           \
+template<typename R>                                                        \
+inline ArrayExpr<ArrayExprBinary<ArrayExprScalar<typename R::value_type>,   \
+                 ArrayExpr<R>,                                              \
+                 FUNCTOR<typename R::value_type> > >                        \
+NAME (const typename R::value_type& left, const ArrayExpr<R>& right)        \
+{                                                                           \
+  typedef typename R::value_type T;                                         \
+  typedef FUNCTOR<T> Op;                                                    \
+  typedef ArrayExprBinary<ArrayExprScalar<T>, ArrayExpr<R>, Op> Node;       \
+  return ArrayExpr<Node> (Node(ArrayExprScalar<T>(left), right, Op(),       \
+                               #NAME));                                     \
+}
+
+// Define a unary operator or function on an expression.
+#define ARRAYEXPR_UNARY(NAME, FUNCTOR)                                      \
+template<typename E>                                                        \
+inline ArrayExpr<ArrayExprUnary<ArrayExpr<E>,                               \
+                 FUNCTOR<typename E::value_type> > >                        \
+NAME (const ArrayExpr<E>& expr)                                             \
+{                                                                           \
+  typedef FUNCTOR<typename E::value_type> Op;                               \
+  typedef ArrayExprUnary<ArrayExpr<E>, Op> Node;                            \
+  return ArrayExpr<Node> (Node(expr, Op()));                                \
+}
+
+ARRAYEXPR_BINARY (operator+, std::plus)
+ARRAYEXPR_BINARY (operator-, std::minus)
+ARRAYEXPR_BINARY (operator*, std::multiplies)
+ARRAYEXPR_BINARY (operator/, std::divides)
+ARRAYEXPR_BINARY (min, Min)
+ARRAYEXPR_BINARY (max, Max)
+ARRAYEXPR_BINARY (atan2, Atan2)
+ARRAYEXPR_BINARY (fmod, Fmod)
+
+ARRAYEXPR_UNARY (operator-, std::negate)
+ARRAYEXPR_UNARY (sin, Sin)
+ARRAYEXPR_UNARY (sinh, Sinh)
+ARRAYEXPR_UNARY (asin, Asin)
+ARRAYEXPR_UNARY (cos, Cos)
+ARRAYEXPR_UNARY (cosh, Cosh)
+ARRAYEXPR_UNARY (acos, Acos)
+ARRAYEXPR_UNARY (tan, Tan)
+ARRAYEXPR_UNARY (tanh, Tanh)
+ARRAYEXPR_UNARY (atan, Atan)
+ARRAYEXPR_UNARY (square, Sqr)
+ARRAYEXPR_UNARY (cube, Pow3)
+ARRAYEXPR_UNARY (sqrt, Sqrt)
+ARRAYEXPR_UNARY (exp, Exp)
+ARRAYEXPR_UNARY (log, Log)
+ARRAYEXPR_UNARY (log10, Log10)
+ARRAYEXPR_UNARY (abs, Abs)
+ARRAYEXPR_UNARY (floor, Floor)
+ARRAYEXPR_UNARY (ceil, Ceil)
+
+#undef ARRAYEXPR_BINARY
+#undef ARRAYEXPR_UNARY
+
+// </group>
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -32,12 +32,14 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/BasicMath/Functors.h>
 #include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayParallel.h>
 //# Needed to get the proper Complex typedef's
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <numeric>
 #include <functional>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -72,6 +74,13 @@ template<class T> class Matrix;
 // way.
 // <br> Similar to the standard transform function these functions do not check
 // if the shapes match. The user is responsible for that.
+// <br>Large contiguous arrays can be transformed (and reduced by sum,
+// mean, variance and minMax) in parallel as described in
+// <linkto class=ArrayParallel>ArrayParallel</linkto>.
+// <br>Note that each operator creates a temporary result array. For
+// expressions of several operations the lazily evaluated expressions in
+// <linkto group="ArrayExpr.h#Array expression templates">ArrayExpr.h</linkto>
+// can be used to evaluate them in a single pass without temporaries.
 // </synopsis>
 //
 // <example>
@@ -207,8 +216,19 @@ inline void arrayContTransform (const Array<L>& left, const Array<R>& right,
 {
   DebugAssert (result.contiguousStorage(), AipsError);
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
-    std::transform (left.cbegin(), left.cend(), right.cbegin(),
-                    result.cbegin(), op);
+    size_t n = left.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    const L* l = left.data();
+    const R* r = right.data();
+    RES* res = result.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      std::transform (l+st, l+end, r+st, res+st, op);
+    }
   } else {
     std::transform (left.begin(), left.end(), right.begin(),
                     result.cbegin(), op);
@@ -223,8 +243,18 @@ inline void arrayContTransform (const Array<L>& left, R right,
 {
   DebugAssert (result.contiguousStorage(), AipsError);
   if (left.contiguousStorage()) {
-    myrtransform (left.cbegin(), left.cend(),
-                 result.cbegin(), right, op);
+    size_t n = left.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    const L* l = left.data();
+    RES* res = result.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      myrtransform (l+st, l+end, res+st, right, op);
+    }
     ////    std::transform (left.cbegin(), left.cend(),
     ////                    result.cbegin(), bind2nd(op, right));
   } else {
@@ -243,8 +273,18 @@ inline void arrayContTransform (L left, const Array<R>& right,
 {
   DebugAssert (result.contiguousStorage(), AipsError);
   if (right.contiguousStorage()) {
-    myltransform (right.cbegin(), right.cend(),
-                  result.cbegin(), left, op);
+    size_t n = right.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    const R* r = right.data();
+    RES* res = result.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      myltransform (r+st, r+end, res+st, left, op);
+    }
     ////    std::transform (right.cbegin(), right.cend(),
     ////                    result.cbegin(), bind1st(op, left));
   } else {
@@ -263,7 +303,18 @@ inline void arrayContTransform (const Array<T>& arr,
 {
   DebugAssert (result.contiguousStorage(), AipsError);
   if (arr.contiguousStorage()) {
-    std::transform (arr.cbegin(), arr.cend(), result.cbegin(), op);
+    size_t n = arr.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    const T* a = arr.data();
+    RES* res = result.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      std::transform (a+st, a+end, res+st, op);
+    }
   } else {
     std::transform (arr.begin(), arr.end(), result.cbegin(), op);
   }
@@ -321,7 +372,18 @@ inline void arrayTransformInPlace (Array<L>& left, const Array<R>& right,
                                    BinaryOperator op)
 {
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
-    transformInPlace (left.cbegin(), left.cend(), right.cbegin(), op);
+    size_t n = left.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    L* l = left.data();
+    const R* r = right.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      transformInPlace (l+st, l+end, r+st, op);
+    }
   } else {
     transformInPlace (left.begin(), left.end(), right.begin(), op);
   }
@@ -333,7 +395,17 @@ template<typename L, typename R, typename BinaryOperator>
 inline void arrayTransformInPlace (Array<L>& left, R right, BinaryOperator op)
 {
   if (left.contiguousStorage()) {
-    myiptransform (left.cbegin(), left.cend(), right, op);
+    size_t n = left.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    L* l = left.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      myiptransform (l+st, l+end, right, op);
+    }
     ////    transformInPlace (left.cbegin(), left.cend(), bind2nd(op, right));
   } else {
     myiptransform (left.begin(), left.end(), right, op);
@@ -348,13 +420,166 @@ template<typename T, typename UnaryOperator>
 inline void arrayTransformInPlace (Array<T>& arr, UnaryOperator op)
 {
   if (arr.contiguousStorage()) {
-    transformInPlace (arr.cbegin(), arr.cend(), op);
+    size_t n = arr.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    T* a = arr.data();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads()) if (nchunk > 1)
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      transformInPlace (a+st, a+end, op);
+    }
   } else {
     transformInPlace (arr.begin(), arr.end(), op);
   }
 }
 // </group>
 
+// Functions to reduce a contiguous block of data.
+// They are used by functions like sum, minMax and variance for contiguous
+// arrays. For the real and complex floating point types the data are
+// reduced in several independent partial results which are combined at
+// the end. Unlike a loop with a single accumulator (which has to preserve
+// the order of the floating point operations) the compiler can vectorise
+// such a loop. Note that therefore the result can differ slightly from a
+// sequential reduction.
+// <br>For other types the elements are reduced sequentially.
+// <group>
+template<typename T>
+inline T arrayContSum (const T* data, size_t n, T init)
+{
+  return std::accumulate (data, data+n, init, std::plus<T>());
+}
+template<typename T>
+inline T arrayContSumSqrDiff (const T* data, size_t n, T init, T base)
+{
+  return std::accumulate (data, data+n, init, SumSqrDiff<T>(base));
+}
+template<typename T>
+inline void arrayContMinMax (T& minVal, T& maxVal, const T* data, size_t n,
+                             T init)
+{
+  T minv = init;
+  T maxv = minv;
+  for (size_t i=0; i<n; ++i) {
+    if (data[i] < minv) {
+      minv = data[i];
+    } else if (data[i] > maxv) {
+      maxv = data[i];
+    }
+  }
+  minVal = minv;
+  maxVal = maxv;
+}
+template<typename T>
+inline void arrayContMinMax (T& minVal, T& maxVal, const T* data, size_t n)
+  { arrayContMinMax (minVal, maxVal, data, n, data[0]); }
+
+// The blocked implementations using 8 partial results.
+template<typename T>
+inline T arrayContSumBlocked (const T* data, size_t n, T init)
+{
+  T part[8];
+  for (uInt k=0; k<8; ++k) {
+    part[k] = T();
+  }
+  size_t i = 0;
+  for (; i+8<=n; i+=8) {
+    for (uInt k=0; k<8; ++k) {
+      part[k] += data[i+k];
+    }
+  }
+  for (; i<n; ++i) {
+    part[0] += data[i];
+  }
+  return init + (((part[0] + part[1]) + (part[2] + part[3])) +
+                 ((part[4] + part[5]) + (part[6] + part[7])));
+}
+template<typename T>
+inline T arrayContSumSqrDiffBlocked (const T* data, size_t n, T init, T base)
+{
+  T part[8];
+  for (uInt k=0; k<8; ++k) {
+    part[k] = T();
+  }
+  size_t i = 0;
+  for (; i+8<=n; i+=8) {
+    for (uInt k=0; k<8; ++k) {
+      T diff = data[i+k] - base;
+      part[k] += diff*diff;
+    }
+  }
+  for (; i<n; ++i) {
+    T diff = data[i] - base;
+    part[0] += diff*diff;
+  }
+  return init + (((part[0] + part[1]) + (part[2] + part[3])) +
+                 ((part[4] + part[5]) + (part[6] + part[7])));
+}
+template<typename T>
+inline void arrayContMinMaxBlocked (T& minVal, T& maxVal,
+                                    const T* data, size_t n, T init)
+{
+  T minv[8], maxv[8];
+  for (uInt k=0; k<8; ++k) {
+    minv[k] = maxv[k] = init;
+  }
+  size_t i = 0;
+  for (; i+8<=n; i+=8) {
+    for (uInt k=0; k<8; ++k) {
+      T v = data[i+k];
+      minv[k] = (v < minv[k]  ?  v : minv[k]);
+      maxv[k] = (v > maxv[k]  ?  v : maxv[k]);
+    }
+  }
+  for (; i<n; ++i) {
+    minv[0] = (data[i] < minv[0]  ?  data[i] : minv[0]);
+    maxv[0] = (data[i] > maxv[0]  ?  data[i] : maxv[0]);
+  }
+  for (uInt k=1; k<8; ++k) {
+    if (minv[k] < minv[0]) minv[0] = minv[k];
+    if (maxv[k] > maxv[0]) maxv[0] = maxv[k];
+  }
+  minVal = minv[0];
+  maxVal = maxv[0];
+}
+
+inline Float arrayContSum (const Float* data, size_t n, Float init)
+  { return arrayContSumBlocked (data, n, init); }
+inline Double arrayContSum (const Double* data, size_t n, Double init)
+  { return arrayContSumBlocked (data, n, init); }
+inline Complex arrayContSum (const Complex* data, size_t n, Complex init)
+  { return arrayContSumBlocked (data, n, init); }
+inline DComplex arrayContSum (const DComplex* data, size_t n, DComplex init)
+  { return arrayContSumBlocked (data, n, init); }
+inline Float arrayContSumSqrDiff (const Float* data, size_t n,
+                                  Float init, Float base)
+  { return arrayContSumSqrDiffBlocked (data, n, init, base); }
+inline Double arrayContSumSqrDiff (const Double* data, size_t n,
+                                   Double init, Double base)
+  { return arrayContSumSqrDiffBlocked (data, n, init, base); }
+inline Complex arrayContSumSqrDiff (const Complex* data, size_t n,
+                                    Complex init, Complex base)
+  { return arrayContSumSqrDiffBlocked (data, n, init, base); }
+inline DComplex arrayContSumSqrDiff (const DComplex* data, size_t n,
+                                     DComplex init, DComplex base)
+  { return arrayContSumSqrDiffBlocked (data, n, init, base); }
+inline void arrayContMinMax (Float& minVal, Float& maxVal,
+                             const Float* data, size_t n, Float init)
+  { arrayContMinMaxBlocked (minVal, maxVal, data, n, init); }
+inline void arrayContMinMax (Double& minVal, Double& maxVal,
+                             const Double* data, size_t n, Double init)
+  { arrayContMinMaxBlocked (minVal, maxVal, data, n, init); }
+inline void arrayContMinMax (Float& minVal, Float& maxVal,
+                             const Float* data, size_t n)
+  { arrayContMinMaxBlocked (minVal, maxVal, data, n, data[0]); }
+inline void arrayContMinMax (Double& minVal, Double& maxVal,
+                             const Double* data, size_t n)
+  { arrayContMinMaxBlocked (minVal, maxVal, data, n, data[0]); }
+// </group>
+
 // 
 // Element by element arithmetic modifying left in-place. left and other
 // must be conformant.
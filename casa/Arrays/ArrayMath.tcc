@@ -756,27 +756,43 @@ template<class T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
     throw(ArrayError("void minMax(T &min, T &max, const Array<T> &array) - "
                      "Array has no elements"));	
   }
-  T minv = array.data()[0];
-  T maxv = minv;
   if (array.contiguousStorage()) {
-    typename Array<T>::const_contiter iterEnd = array.cend();
-    for (typename Array<T>::const_contiter iter = array.cbegin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
+    // Large arrays can be done in parallel in chunks.
+    const T* data = array.data();
+    size_t n = array.nelements();
+    size_t nchunk = ArrayParallel::nchunks (n);
+    if (nchunk == 1) {
+      arrayContMinMax (minVal, maxVal, data, n);
+      return;
     }
-  } else {
-    typename Array<T>::const_iterator iterEnd = array.end();
-    for (typename Array<T>::const_iterator iter = array.begin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
+    // All chunks start from the first element like the sequential loop,
+    // so a chunk starting with a NaN does not lose its other values.
+    std::vector<T> minv(nchunk), maxv(nchunk);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads())
+#endif
+    for (Int64 i=0; i<Int64(nchunk); ++i) {
+      size_t st, end;
+      ArrayParallel::chunk (i, nchunk, n, st, end);
+      arrayContMinMax (minv[i], maxv[i], data+st, end-st, data[0]);
+    }
+    minVal = minv[0];
+    maxVal = maxv[0];
+    for (size_t i=1; i<nchunk; ++i) {
+      if (minv[i] < minVal) minVal = minv[i];
+      if (maxv[i] > maxVal) maxVal = maxv[i];
+    }
+    return;
+  }
+  T minv = array.data()[0];
+  T maxv = minv;
+  typename Array<T>::const_iterator iterEnd = array.end();
+  for (typename Array<T>::const_iterator iter = array.begin();
+       iter!=iterEnd; ++iter) {
+    if (*iter < minv) {
+      minv = *iter;
+    } else if (*iter > maxv) {
+      maxv = *iter;
     }
   }
   maxVal = maxv;
@@ -1041,9 +1057,27 @@ template<class T> Array<T> fmod(const Array<T> &a, const T &b)
 // </thrown>
 template<class T> T sum(const Array<T> &a)
 {
-  return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), std::plus<T>()) :
-    std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
+  if (! a.contiguousStorage()) {
+    return std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
+  }
+  // Large arrays can be summed in parallel in chunks, where the partial
+  // sums are added pairwise.
+  const T* data = a.data();
+  size_t n = a.nelements();
+  size_t nchunk = ArrayParallel::nchunks (n);
+  if (nchunk == 1) {
+    return arrayContSum (data, n, T());
+  }
+  std::vector<T> parts(nchunk);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads())
+#endif
+  for (Int64 i=0; i<Int64(nchunk); ++i) {
+    size_t st, end;
+    ArrayParallel::chunk (i, nchunk, n, st, end);
+    parts[i] = arrayContSum (data+st, end-st, T());
+  }
+  return ArrayParallel::pairwiseSum (parts);
 }
 
 // <thrown>
@@ -1087,9 +1121,30 @@ template<class T> T variance(const Array<T> &a, T mean)
 	throw(ArrayError("::variance(const Array<T> &,T) - Need at least 2 "
 			 "elements"));
     }
-    T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), casacore::SumSqrDiff<T>(mean)) :
-      std::accumulate(a.begin(),  a.end(),  T(), casacore::SumSqrDiff<T>(mean));
+    T sum;
+    if (! a.contiguousStorage()) {
+      sum = std::accumulate(a.begin(),  a.end(),  T(),
+                            casacore::SumSqrDiff<T>(mean));
+    } else {
+      // Large arrays can be done in parallel in chunks.
+      const T* data = a.data();
+      size_t n = a.nelements();
+      size_t nchunk = ArrayParallel::nchunks (n);
+      if (nchunk == 1) {
+        sum = arrayContSumSqrDiff (data, n, T(), mean);
+      } else {
+        std::vector<T> parts(nchunk);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(ArrayParallel::nthreads())
+#endif
+        for (Int64 i=0; i<Int64(nchunk); ++i) {
+          size_t st, end;
+          ArrayParallel::chunk (i, nchunk, n, st, end);
+          parts[i] = arrayContSumSqrDiff (data+st, end-st, T(), mean);
+        }
+        sum = ArrayParallel::pairwiseSum (parts);
+      }
+    }
     return T(sum/(1.0*a.nelements() - 1));
 }
 
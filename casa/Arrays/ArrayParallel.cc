@@ -0,0 +1,75 @@
+//# ArrayParallel.cc: Settings for parallel evaluation of array operations
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Arrays/ArrayParallel.h>
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+uInt   ArrayParallel::theirNThreads  = 1;
+size_t ArrayParallel::theirThreshold = 1048576;
+
+void ArrayParallel::setNThreads (uInt nthreads)
+{
+  theirNThreads = nthreads;
+}
+
+uInt ArrayParallel::nthreads()
+{
+#ifdef _OPENMP
+  if (theirNThreads == 0) {
+    return omp_get_max_threads();
+  }
+  return theirNThreads;
+#else
+  return 1;
+#endif
+}
+
+void ArrayParallel::setThreshold (size_t nelements)
+{
+  theirThreshold = nelements;
+}
+
+size_t ArrayParallel::threshold()
+{
+  return theirThreshold;
+}
+
+size_t ArrayParallel::nchunksLarge (size_t nelements)
+{
+  if (nthreads() == 1) {
+    return 1;
+  }
+  return (nelements + ChunkSize - 1) / ChunkSize;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,136 @@
+//# ArrayParallel.h: Settings for parallel evaluation of array operations
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_ARRAYPARALLEL_H
+#define CASA_ARRAYPARALLEL_H
+
+#include <casacore/casa/aips.h>
+#include <cstddef>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Settings for the parallel evaluation of array operations.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tArrayMath">
+// </reviewed>
+
+// <synopsis>
+// The transform functions in ArrayMath.h (thus all element-wise
+// operators and functions) and the reductions sum, mean, variance
+// and minMax can process a large contiguous array in parallel using
+// OpenMP. The array is split in chunks of a fixed size which are
+// processed by the threads.
+// <br>Parallel evaluation is opt-in; by default a single thread is used.
+// It can be enabled by setting the maximum number of threads, where 0
+// means all available cores. Only arrays with at least
+// <src>threshold()</src> elements are processed in parallel, because
+// for smaller arrays the overhead of starting the threads dominates.
+// If casacore is built without OpenMP, operations are always sequential.
+//
+// Partial reductions are done per chunk and merged pairwise in a fixed
+// order. Because the chunk size is fixed, the result of a parallel
+// reduction does not depend on the number of threads used. It can
+// differ slightly from a sequential reduction, because the additions are
+// done in another order.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   // Use all cores for arrays of at least 1M elements.
+//   ArrayParallel::setNThreads (0);
+//   Array<Float> cube(IPosition(3,1000,1000,500));
+//   ...
+//   Float total = sum(cube);
+// </srcblock>
+// </example>
+
+class ArrayParallel
+{
+public:
+  // The number of elements in a chunk.
+  enum {ChunkSize = 65536};
+
+  // Set the maximum number of threads to use.
+  // 1 means sequential evaluation (the default); 0 means all cores.
+  static void setNThreads (uInt nthreads);
+
+  // Get the maximum number of threads to use (always > 0).
+  static uInt nthreads();
+
+  // Set the minimum number of elements of an array to be processed
+  // in parallel (default 1048576).
+  static void setThreshold (size_t nelements);
+  static size_t threshold();
+
+  // Get the number of chunks to split an array with the given number of
+  // elements in. It is 1 if the array is not processed in parallel.
+  static size_t nchunks (size_t nelements)
+  {
+    if (nelements < theirThreshold  ||  nelements <= size_t(ChunkSize)) {
+      return 1;
+    }
+    return nchunksLarge (nelements);
+  }
+
+  // Get the start and end of the given chunk.
+  static void chunk (size_t chunkNr, size_t nchunks, size_t nelements,
+                     size_t& start, size_t& end)
+  {
+    start = chunkNr * size_t(ChunkSize);
+    end   = (chunkNr == nchunks-1  ?  nelements : start + ChunkSize);
+  }
+
+  // Sum the partial results pairwise in a fixed order.
+  template<typename T>
+  static T pairwiseSum (std::vector<T>& parts)
+  {
+    size_t n = parts.size();
+    for (size_t step=1; step<n; step*=2) {
+      for (size_t i=0; i+step<n; i+=2*step) {
+        parts[i] += parts[i+step];
+      }
+    }
+    return parts[0];
+  }
+
+private:
+  // Get the number of chunks for an array exceeding the threshold.
+  static size_t nchunksLarge (size_t nelements);
+
+  static uInt   theirNThreads;
+  static size_t theirThreshold;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -75,13 +75,19 @@ template<class T> Array<T> partialSums (const Array<T>& array,
   }
   // Loop through all data and assemble as needed.
   IPosition pos(ndim, 0);
+  // Keep the inner loops contiguous (and vectorisable): either sum the
+  // contiguous data into a single output element or add them to the
+  // contiguous output elements.
   while (True) {
     if (cont) {
-      T tmp = *res;
+      *res = arrayContSum (data, n0, *res);
+      data += n0;
+    } else if (incr0 == 1) {
       for (uInt i=0; i<n0; i++) {
-	tmp += *data++;
+	res[i] += data[i];
       }
-      *res = tmp;
+      data += n0;
+      res += n0;
     } else {
       for (uInt i=0; i<n0; i++) {
 	*res += *data++;
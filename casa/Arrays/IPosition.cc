@@ -35,22 +35,6 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-IPosition::IPosition (uInt length)
-: size_p (length),
-  data_p (buffer_p)
-{
-    if (length > BufferLength) {
-	allocateBuffer();
-    }
-}
-
-IPosition::~IPosition()
-{
-    if (data_p != &buffer_p[0]) {
-        delete [] data_p;
-    }
-}
-
 void IPosition::allocateBuffer()
 {
     if (size_p <= BufferLength) {
@@ -114,19 +98,6 @@ IPosition::IPosition (uInt length, ssize_t val0, ssize_t val1, ssize_t val2,
     DebugAssert(ok(), AipsError);
 }
 
-IPosition::IPosition (const IPosition& other)
-: size_p (other.size_p),
-  data_p (buffer_p)
-{
-    if (size_p > BufferLength) {
-	allocateBuffer();
-    }
-    for (uInt i=0; i<size_p; i++) {
-	data_p[i] = other.data_p[i];
-    }
-    DebugAssert(ok(), AipsError);
-}
-
 IPosition IPosition::nonDegenerate (uInt startingAxis) const
 {
     if (startingAxis >= size_p) {
@@ -202,23 +173,14 @@ void IPosition::resize (uInt newSize, Bool copy)
 // <thrown>
 //    <item> ArrayConformanceError
 // </thrown>
-IPosition& IPosition::operator= (const IPosition& other)
+void IPosition::resizeForAssign (const IPosition& other)
 {
     DebugAssert(ok(), AipsError);
-    if (&other == this) {
-	return *this;
-    }
-    if (size_p == 0) {
-	this->resize (other.nelements(), False);
-    } else if (! conform(other)) {
+    if (size_p != 0) {
 	throw(ArrayConformanceError("IPosition::operator=(const IPosition&  - "
 				    "this and other differ in length"));
     }
-    for (uInt i=0; i<size_p; i++) {
-	data_p[i] = other.data_p[i];
-    }
-    DebugAssert(ok(), AipsError);
-    return *this;
+    resize (other.nelements(), False);
 }
 
 IPosition& IPosition::operator= (ssize_t value)
@@ -440,11 +402,6 @@ void IPosition::operator /= (ssize_t val)
     }
 }
 
-Bool IPosition::isEqual (const IPosition& other) const
-{
-    return isEqual (other, nelements());
-}
-
 Bool IPosition::isEqual (const IPosition& other,
 			 Bool skipDegeneratedAxes) const
 {
@@ -73,6 +73,9 @@ template<class T> class Vector;
 // to define its shape, etc.).
 // <p>
 // Unlike Vectors, IPositions always use copy semantics.
+// IPositions with up to 8 elements keep their values in an internal
+// buffer, so constructing, copying and resizing them does not need
+// heap allocation.
 // <srcblock>
 // IPosition ip1(5);                         // An IPosition of length 5
 // ip1(0) = 11; ip1(1) = 5; ... ip1(4) = 6;  // Indices 0-based
@@ -407,7 +410,19 @@ private:
     // Throw an index error exception.
     void throwIndexError() const;
 
-    enum { BufferLength = 4 };
+    // Copy the data of other, which must have the same length.
+    void copyData (const IPosition& other)
+    {
+        for (uInt i=0; i<size_p; ++i) {
+            data_p[i] = other.data_p[i];
+        }
+    }
+
+    // Resize an empty IPosition before assignment of other; throw an
+    // exception if this is not empty.
+    void resizeForAssign (const IPosition& other);
+
+    enum { BufferLength = 8 };
     uInt size_p;
     ssize_t buffer_p[BufferLength];
     // When the iposition is length BufferSize or less data is just buffer_p,
@@ -524,6 +539,54 @@ inline IPosition::IPosition()
   data_p (buffer_p)
 {}
 
+inline IPosition::IPosition (uInt length)
+: size_p (length),
+  data_p (buffer_p)
+{
+    if (length > BufferLength) {
+	allocateBuffer();
+    }
+}
+
+inline IPosition::IPosition (const IPosition& other)
+: size_p (other.size_p),
+  data_p (buffer_p)
+{
+    if (size_p > BufferLength) {
+	allocateBuffer();
+    }
+    copyData (other);
+}
+
+inline IPosition::~IPosition()
+{
+    if (data_p != &buffer_p[0]) {
+        delete [] data_p;
+    }
+}
+
+inline IPosition& IPosition::operator= (const IPosition& other)
+{
+    if (size_p != other.size_p) {
+        resizeForAssign (other);
+    }
+    copyData (other);
+    return *this;
+}
+
+inline Bool IPosition::isEqual (const IPosition& other) const
+{
+    if (size_p != other.size_p) {
+        return False;
+    }
+    for (uInt i=0; i<size_p; ++i) {
+        if (data_p[i] != other.data_p[i]) {
+            return False;
+        }
+    }
+    return True;
+}
+
 inline IPosition IPosition::makeAxisPath (uInt nrdim)
 {
     return makeAxisPath (nrdim, IPosition());
@@ -0,0 +1,131 @@
+//# tArrayExpr.cc: Test program for the lazily evaluated array expressions
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/casa/Arrays/ArrayExpr.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+void doArith()
+{
+  IPosition shape(3,4,5,6);
+  Array<Double> a(shape), b(shape), c(shape), d(shape), e(shape);
+  indgen (a, 1.);
+  indgen (b, 2., 0.5);
+  indgen (c, -3.);
+  indgen (d, 1., 2.);
+  indgen (e, 7.);
+  // Compare with the (eager) ArrayMath operators.
+  Array<Double> exp = a*b + c*d - e;
+  Array<Double> res = arrayExpr(a)*b + arrayExpr(c)*d - e;
+  AlwaysAssertExit (allNear (res, exp, 1e-13));
+  // Evaluate into an existing array.
+  Array<Double> res2(shape);
+  (arrayExpr(a)*b + arrayExpr(c)*d - e).evaluate (res2);
+  AlwaysAssertExit (allNear (res2, exp, 1e-13));
+  // Scalars and unary operators.
+  exp = sqrt(2.*a + 1.) - b/3.;
+  res = sqrt(2.*arrayExpr(a) + 1.) - arrayExpr(b)/3.;
+  AlwaysAssertExit (allNear (res, exp, 1e-13));
+  exp = -abs(c) + max(a, e) + min(c, 0.);
+  res = -abs(arrayExpr(c)) + max(arrayExpr(a), e) + min(arrayExpr(c), 0.);
+  AlwaysAssertExit (allNear (res, exp, 1e-13));
+  // Sum without creating an array.
+  AlwaysAssertExit (near (sum(arrayExpr(a)*b), sum(a*b), 1e-13));
+  // The result can also be an operand.
+  Array<Double> acopy = a.copy();
+  (arrayExpr(a)*a + 1.).evaluate (a);
+  AlwaysAssertExit (allNear (a, acopy*acopy + 1., 1e-13));
+  // An empty result is resized.
+  Array<Double> empty;
+  (arrayExpr(b) + c).evaluate (empty);
+  AlwaysAssertExit (allNear (empty, b+c, 1e-13));
+}
+
+void doSections()
+{
+  // Non-contiguous operands and result.
+  Matrix<Float> m(10,8);
+  indgen (m);
+  Matrix<Float> msec = m(Slice(1,4,2), Slice(0,3,3));
+  Matrix<Float> exp = msec * msec + 2.f;
+  Matrix<Float> res(msec.shape());
+  (arrayExpr(msec) * msec + 2.f).evaluate (res);
+  AlwaysAssertExit (allEQ (res, exp));
+  // Write into a section of an array.
+  Matrix<Float> m2(m.copy());
+  Matrix<Float> sec2 = m2(Slice(1,4,2), Slice(0,3,3));
+  (arrayExpr(msec) * 3.f).evaluate (sec2);
+  AlwaysAssertExit (allEQ (sec2, msec * 3.f));
+  AlwaysAssertExit (m2(0,0) == m(0,0)  &&  m2(1,1) == m(1,1));
+  // Vector operands.
+  Vector<Float> col = m.column(2);
+  Vector<Float> vres(col.nelements());
+  (arrayExpr(col) - m.column(1)).evaluate (vres);
+  AlwaysAssertExit (allEQ (vres, Float(m.nrow())));
+}
+
+void doErrors()
+{
+  Vector<Int> v1(3, 1);
+  Vector<Int> v2(4, 2);
+  Bool caught = False;
+  try {
+    Array<Int> res = arrayExpr(v1) + v2;
+  } catch (const ArrayConformanceError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+  caught = False;
+  try {
+    (arrayExpr(v1) * 2).evaluate (v2);
+  } catch (const ArrayConformanceError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+}
+
+int main()
+{
+  try {
+    doArith();
+    doSections();
+    doErrors();
+  } catch (const AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -29,6 +29,7 @@
 #include <casacore/casa/Arrays/Cube.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayPartMath.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
@@ -422,6 +423,105 @@ void testMinMax1()
   AlwaysAssertExit (maxpos == IPosition(3,2,2,2));
 }
 
+void testContReductions()
+{
+  // Test the blocked reductions of contiguous arrays for various lengths
+  // (also not a multiple of the block size) against a sequential loop.
+  for (uInt n=1; n<40; n+=3) {
+    Vector<Double> a(n);
+    Vector<Float> f(n);
+    Vector<Complex> c(n);
+    for (uInt i=0; i<n; ++i) {
+      a[i] = (i*7)%11 - 4.5;
+      f[i] = a[i];
+      c[i] = Complex(a[i], -2.*a[i]);
+    }
+    a[n/2] = -100;
+    f[n-1] = 200;
+    Double sa=0, sf=0, sv=0, mx=a[0];
+    Complex sc, svc;
+    for (uInt i=0; i<n; ++i) {
+      sa += a[i];
+      sf += f[i];
+      sc += c[i];
+      mx = std::max (mx, a[i]);
+    }
+    Double ma = sa/n;
+    Complex mc = sc/Float(n);
+    for (uInt i=0; i<n; ++i) {
+      sv += (a[i]-ma) * (a[i]-ma);
+      svc += (c[i]-mc) * (c[i]-mc);
+    }
+    AlwaysAssertExit (near (sum(a), sa, 1e-12));
+    AlwaysAssertExit (near (Double(sum(f)), sf, 1e-6));
+    AlwaysAssertExit (abs(sum(c) - sc) < 1e-4);
+    AlwaysAssertExit (near (mean(a), ma, 1e-12));
+    if (n > 1) {
+      AlwaysAssertExit (near (variance(a), sv/(n-1), 1e-12));
+      AlwaysAssertExit (abs(variance(c, mc) - svc/Float(n-1)) <
+                        1e-4 * abs(svc));
+    }
+    AlwaysAssertExit (min(a) == -100  &&  max(f) == 200);
+    Double mina, maxa;
+    minMax (mina, maxa, a);
+    AlwaysAssertExit (mina == -100  &&  maxa == mx);
+  }
+  // partialSums over the first (contiguous) axis or the other axes.
+  Cube<Double> cube(5,4,3);
+  indgen (cube);
+  Matrix<Double> ps1 = partialSums (cube, IPosition(1,0));
+  Vector<Double> ps2 = partialSums (cube, IPosition(2,1,2));
+  for (uInt j=0; j<4; ++j) {
+    for (uInt k=0; k<3; ++k) {
+      AlwaysAssertExit (ps1(j,k) == sum(cube.xyPlane(k).column(j)));
+    }
+  }
+  for (uInt i=0; i<5; ++i) {
+    AlwaysAssertExit (ps2(i) == sum(cube.yzPlane(i)));
+  }
+}
+
+void testParallel()
+{
+  // Process a large array in parallel (if OpenMP is used) and compare
+  // with the sequential results.
+  Vector<Double> a(300001);
+  indgen (a, -1000., 0.01);
+  a[1234] = -5000;
+  a[299000] = 7000;
+  Double seqSum = sum(a);
+  Double seqVar = variance(a);
+  Vector<Double> seqRes = sqrt(abs(a)) + a*2.;
+  ArrayParallel::setNThreads (4);
+  ArrayParallel::setThreshold (100000);
+  AlwaysAssertExit (near (sum(a), seqSum, 1e-10));
+  AlwaysAssertExit (near (variance(a), seqVar, 1e-10));
+  Double mina, maxa;
+  minMax (mina, maxa, a);
+  AlwaysAssertExit (mina == -5000  &&  maxa == 7000);
+  Vector<Double> res = sqrt(abs(a)) + a*2.;
+  AlwaysAssertExit (allEQ (res, seqRes));
+  res -= a;
+  res += 1.;
+  AlwaysAssertExit (allNear (res, seqRes - a + 1., 1e-12));
+  // A NaN at the start of a chunk must not hide the other values in it.
+  Vector<Float> f(4*65536, 1.f);
+  setNaN (f[65536]);
+  f[65537] = -5;
+  ArrayParallel::setThreshold (1);
+  Float minf, maxf;
+  minMax (minf, maxf, f);
+  AlwaysAssertExit (minf == -5  &&  maxf == 1);
+  ArrayParallel::setThreshold (100000);
+  // The result does not depend on the number of threads.
+  ArrayParallel::setNThreads (3);
+  Double sum3 = sum(a);
+  ArrayParallel::setNThreads (2);
+  AlwaysAssertExit (sum(a) == sum3);
+  ArrayParallel::setNThreads (1);
+  ArrayParallel::setThreshold (1048576);
+}
+
 void testExpand()
 {
   // Test linear expansion.
@@ -614,6 +714,8 @@ int main()
     testMakeComplex<Float,Complex>();
     testMakeComplex<Double,DComplex>();
     testMinMax1();
+    testContReductions();
+    testParallel();
     testExpand();
   } catch (AipsError x) {
     cout << "Unexpected exception: " << x.getMesg() << endl;
@@ -0,0 +1,129 @@
+//# tIPositionPerf.cc: Test program for performance of IPosition
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayPosIter.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/iostream.h>
+#include <cstdlib>
+
+#include <casacore/casa/namespace.h>
+
+// Test performance of IPosition in nested-loop iteration.
+// IPositions with up to 8 elements do not use the heap, so the timings
+// for ndim <= 8 should be much lower than for ndim = 10.
+
+// Make a shape with about nrElem elements.
+IPosition makeShape (uInt ndim, Int64 nrElem)
+{
+  IPosition shape(ndim, 1);
+  Int64 n = nrElem;
+  for (uInt i=0; i<ndim  &&  n>1; ++i) {
+    shape[i] = (i == ndim-1  ?  n : 4);
+    n /= shape[i];
+  }
+  return shape;
+}
+
+// Iterate by hand, copying, comparing and assigning an IPosition per step
+// like the iteration in many casacore classes.
+Int64 iterateCopy (const IPosition& shape)
+{
+  uInt ndim = shape.nelements();
+  IPosition pos(ndim, 0);
+  IPosition last(shape - 1);
+  Int64 nstep = 0;
+  while (True) {
+    IPosition cursor(pos);
+    if (cursor.isEqual (last)) {
+      break;
+    }
+    nstep++;
+    for (uInt i=0; i<ndim; ++i) {
+      if (++cursor[i] < shape[i]) {
+        break;
+      }
+      cursor[i] = 0;
+    }
+    pos = cursor;
+  }
+  return nstep+1;
+}
+
+// Iterate using the ArrayPositionIterator.
+Int64 iteratePosIter (const IPosition& shape)
+{
+  ArrayPositionIterator iter(shape, 0);
+  Int64 nstep = 0;
+  for (; !iter.pastEnd(); iter.next()) {
+    nstep += iter.pos()[0] >= 0;
+  }
+  return nstep;
+}
+
+void doIt (uInt ndim, Int64 nrElem)
+{
+  IPosition shape = makeShape (ndim, nrElem);
+  Int64 nelem = shape.product();
+  Int64 nstep;
+  {
+    Timer tim;
+    nstep = iterateCopy (shape);
+    cout << "ndim=" << ndim << ' ';
+    tim.show ("copy    ");
+  }
+  AlwaysAssertExit (nstep == nelem);
+  {
+    Timer tim;
+    nstep = iteratePosIter (shape);
+    cout << "ndim=" << ndim << ' ';
+    tim.show ("PosIter ");
+  }
+  AlwaysAssertExit (nstep == nelem);
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    Int64 nrElem = 10000000;
+    if (argc > 1) {
+      nrElem = atoi(argv[1]);
+    }
+    cout << "Iterate over " << nrElem << " elements" << endl;
+    for (uInt ndim=1; ndim<=8; ++ndim) {
+      doIt (ndim, nrElem);
+    }
+    doIt (10, nrElem);
+  } catch (const AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  } 
+  cout << "OK" << endl;
+  return 0;               // successfully executed
+}
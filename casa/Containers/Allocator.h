@@ -32,6 +32,7 @@
 #include <casacore/casa/config.h>
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/Containers/ArrayArena.h>
 
 #include <memory>
 #include <typeinfo>
@@ -150,16 +151,13 @@ struct casacore_allocator: public std11_allocator<T> {
     if (elements > this->max_size()) {
       throw std::bad_alloc();
     }
-    void *memptr = 0;
-    int result = posix_memalign(&memptr, ALIGNMENT, sizeof(T) * elements);
-    if (result != 0) {
-      throw std::bad_alloc();
-    }
-    return static_cast<pointer>(memptr);
+    // Small blocks can be recycled by the ArrayArena of the thread.
+    return static_cast<pointer>(ArrayArena::allocate(sizeof(T) * elements,
+                                                     ALIGNMENT));
   }
 
-  void deallocate(pointer ptr, size_type) {
-    free(ptr);
+  void deallocate(pointer ptr, size_type elements) {
+    ArrayArena::deallocate(ptr, sizeof(T) * elements, ALIGNMENT);
   }
 };
 
@@ -0,0 +1,181 @@
+//# ArrayArena.cc: Thread-local recycling of small array storage
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Containers/ArrayArena.h>
+#include <cstdlib>
+#include <new>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The size classes are 64 bytes and 8 classes per power of 2 above it
+//# (thus 72, 80, ..., 128, 144, ..., 256, etc.) up to MaxBlockSize.
+//# A free block keeps the pointer to the next free block in its
+//# first bytes.
+//# All thread-local data are PODs, so no construction is needed.
+#define ARRAYARENA_NCLASS (1 + 14*8)
+
+static __thread void*  theirFreeList[ARRAYARENA_NCLASS];
+static __thread size_t theirCachedBytes = 0;
+static __thread uInt   theirNScope = 0;
+static __thread ArrayArenaStatistics theirStatistics;
+static size_t theirMaxCachedBytes = 64*1024*1024;
+
+
+uInt ArrayArena::sizeClass (size_t nbytes)
+{
+  if (nbytes <= 64) {
+    return 0;
+  }
+  // Find e such that 2^e < nbytes <= 2^(e+1).
+  uInt e = 6;
+  while ((size_t(1) << (e+1)) < nbytes) {
+    ++e;
+  }
+  size_t step = size_t(1) << (e-3);
+  size_t k = (nbytes - (size_t(1) << e) + step - 1) / step;
+  return 1 + (e-6)*8 + (k-1);
+}
+
+size_t ArrayArena::classSize (uInt sizeClass)
+{
+  if (sizeClass == 0) {
+    return 64;
+  }
+  uInt e = (sizeClass-1) / 8 + 6;
+  uInt k = (sizeClass-1) % 8 + 1;
+  return (size_t(1) << e) + k * (size_t(1) << (e-3));
+}
+
+size_t ArrayArena::roundedSize (size_t nbytes)
+{
+  if (nbytes == 0  ||  nbytes > size_t(MaxBlockSize)) {
+    return nbytes;
+  }
+  return classSize (sizeClass (nbytes));
+}
+
+void* ArrayArena::allocateHeap (size_t nbytes, size_t alignment)
+{
+  void* ptr = 0;
+  if (posix_memalign (&ptr, alignment, nbytes) != 0) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void ArrayArena::deallocateHeap (void* ptr)
+{
+  free (ptr);
+}
+
+void* ArrayArena::allocateSmall (size_t nbytes)
+{
+  uInt cl = sizeClass (nbytes);
+  theirStatistics.nallocate++;
+  void* ptr = theirFreeList[cl];
+  if (ptr != 0) {
+    theirFreeList[cl] = *static_cast<void**>(ptr);
+    theirCachedBytes -= classSize(cl);
+    theirStatistics.nreused++;
+    return ptr;
+  }
+  return allocateHeap (classSize(cl), CASA_DEFAULT_ALIGNMENT);
+}
+
+void ArrayArena::deallocateSmall (void* ptr, size_t nbytes)
+{
+  theirStatistics.ndeallocate++;
+  if (theirNScope > 0) {
+    uInt cl = sizeClass (nbytes);
+    size_t sz = classSize(cl);
+    if (theirCachedBytes + sz <= theirMaxCachedBytes) {
+      *static_cast<void**>(ptr) = theirFreeList[cl];
+      theirFreeList[cl] = ptr;
+      theirCachedBytes += sz;
+      theirStatistics.ncached++;
+      return;
+    }
+  }
+  deallocateHeap (ptr);
+}
+
+void ArrayArena::startScope()
+{
+  theirNScope++;
+}
+
+void ArrayArena::endScope()
+{
+  if (--theirNScope == 0) {
+    release();
+  }
+}
+
+void ArrayArena::release()
+{
+  for (uInt i=0; i<ARRAYARENA_NCLASS; ++i) {
+    void* ptr = theirFreeList[i];
+    while (ptr != 0) {
+      void* next = *static_cast<void**>(ptr);
+      deallocateHeap (ptr);
+      ptr = next;
+    }
+    theirFreeList[i] = 0;
+  }
+  theirCachedBytes = 0;
+}
+
+Bool ArrayArena::isActive()
+{
+  return theirNScope > 0;
+}
+
+ArrayArenaStatistics ArrayArena::statistics()
+{
+  return theirStatistics;
+}
+
+void ArrayArena::resetStatistics()
+{
+  theirStatistics.nallocate   = 0;
+  theirStatistics.nreused     = 0;
+  theirStatistics.ndeallocate = 0;
+  theirStatistics.ncached     = 0;
+}
+
+size_t ArrayArena::maxCachedBytes()
+{
+  return theirMaxCachedBytes;
+}
+
+void ArrayArena::setMaxCachedBytes (size_t nbytes)
+{
+  theirMaxCachedBytes = nbytes;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,201 @@
+//# ArrayArena.h: Thread-local recycling of small array storage
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_ARRAYARENA_H
+#define CASA_ARRAYARENA_H
+
+#include <casacore/casa/aips.h>
+#include <cstddef>
+
+#ifndef CASA_DEFAULT_ALIGNMENT
+# define CASA_DEFAULT_ALIGNMENT (32UL) // AVX/AVX2 alignment
+#endif
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Statistics of the ArrayArena of a thread.
+// </summary>
+struct ArrayArenaStatistics
+{
+  // Number of small blocks allocated.
+  uInt64 nallocate;
+  // Number of those served from the arena (without going to the heap).
+  uInt64 nreused;
+  // Number of small blocks deallocated.
+  uInt64 ndeallocate;
+  // Number of those kept in the arena for reuse.
+  uInt64 ncached;
+};
+
+
+// <summary>
+// Thread-local recycling of small blocks of array storage.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tArrayArena">
+// </reviewed>
+
+// <synopsis>
+// The storage of Arrays and Blocks using the default (aligned) allocator
+// is obtained via this class. Blocks up to <src>MaxBlockSize</src> bytes
+// are rounded up to a size class (at most 12.5% larger). Normally they
+// are allocated from and freed to the heap as before.
+// <br>However, while an <linkto class=ArrayArenaScope>ArrayArenaScope</linkto>
+// object exists in a thread, freed blocks are kept in per size class
+// free lists of that thread and are reused by subsequent allocations of
+// the same size class in that thread. This makes the many short-lived
+// arrays created in a loop (e.g. per row in table processing) much
+// cheaper, because no heap allocation and no locking are needed.
+// When the last ArrayArenaScope in the thread is destructed, the
+// kept blocks are returned to the heap.
+// <br>Because all blocks are allocated in the same way, it does not
+// matter in which thread or scope a block is freed. At most
+// <src>maxCachedBytes()</src> bytes are kept per thread.
+// <p>
+// The allocation counts of the current thread can be obtained to see
+// the effect of an arena.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   {
+//     ArrayArenaScope arena;
+//     for (uInt i=0; i<tab.nrow(); ++i) {
+//       Array<Complex> data = dataCol(i);     // storage is recycled
+//       ...
+//     }
+//   }
+//   cout << ArrayArena::statistics().nreused << endl;
+// </srcblock>
+// </example>
+
+class ArrayArena
+{
+public:
+  // Blocks up to this size (in bytes) are handled by the arena.
+  enum {MaxBlockSize = 1048576};
+
+  // Allocate a block with the given size and alignment.
+  // Small blocks are handled by the arena.
+  static void* allocate (size_t nbytes, size_t alignment)
+  {
+    if (nbytes > 0  &&  nbytes <= size_t(MaxBlockSize)  &&
+        alignment <= size_t(CASA_DEFAULT_ALIGNMENT)) {
+      return allocateSmall (nbytes);
+    }
+    return allocateHeap (nbytes, alignment);
+  }
+
+  // Free a block allocated with the given size and alignment.
+  static void deallocate (void* ptr, size_t nbytes, size_t alignment)
+  {
+    if (nbytes > 0  &&  nbytes <= size_t(MaxBlockSize)  &&
+        alignment <= size_t(CASA_DEFAULT_ALIGNMENT)) {
+      deallocateSmall (ptr, nbytes);
+    } else {
+      deallocateHeap (ptr);
+    }
+  }
+
+  // Is an arena active in the current thread?
+  static Bool isActive();
+
+  // Get or reset the allocation statistics of the current thread.
+  // <group>
+  static ArrayArenaStatistics statistics();
+  static void resetStatistics();
+  // </group>
+
+  // Get or set the maximum number of bytes kept per thread
+  // (default 64 MB).
+  // <group>
+  static size_t maxCachedBytes();
+  static void setMaxCachedBytes (size_t nbytes);
+  // </group>
+
+  // Get the size of the size class the given block size is rounded to.
+  static size_t roundedSize (size_t nbytes);
+
+private:
+  friend class ArrayArenaScope;
+
+  static void* allocateSmall (size_t nbytes);
+  static void deallocateSmall (void* ptr, size_t nbytes);
+  static void* allocateHeap (size_t nbytes, size_t alignment);
+  static void deallocateHeap (void* ptr);
+
+  // Start or end a scope in the current thread.
+  static void startScope();
+  static void endScope();
+
+  // Release all blocks kept in the current thread.
+  static void release();
+
+  // Get the size class index of a small block.
+  static uInt sizeClass (size_t nbytes);
+  // Get the size of a size class.
+  static size_t classSize (uInt sizeClass);
+};
+
+
+// <summary>
+// Activate an ArrayArena in the current thread.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tArrayArena">
+// </reviewed>
+
+// <synopsis>
+// While an object of this class exists, the storage of small arrays freed
+// in the current thread is kept and reused as explained in class
+// <linkto class=ArrayArena>ArrayArena</linkto>.
+// Scopes can be nested; the kept storage is released when the outermost
+// scope ends.
+// </synopsis>
+
+class ArrayArenaScope
+{
+public:
+  ArrayArenaScope()
+    { ArrayArena::startScope(); }
+  ~ArrayArenaScope()
+    { ArrayArena::endScope(); }
+private:
+  // Copying is not possible.
+  ArrayArenaScope (const ArrayArenaScope&);
+  ArrayArenaScope& operator= (const ArrayArenaScope&);
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,156 @@
+//# tArrayArena.cc: Test program for class ArrayArena
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Containers/ArrayArena.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+
+#include <casacore/casa/namespace.h>
+
+void testSizeClasses()
+{
+  // Blocks are rounded up to at most 12.5% (or 64 bytes).
+  AlwaysAssertExit (ArrayArena::roundedSize(0) == 0);
+  AlwaysAssertExit (ArrayArena::roundedSize(1) == 64);
+  AlwaysAssertExit (ArrayArena::roundedSize(64) == 64);
+  AlwaysAssertExit (ArrayArena::roundedSize(65) == 72);
+  AlwaysAssertExit (ArrayArena::roundedSize(128) == 128);
+  AlwaysAssertExit (ArrayArena::roundedSize(129) == 144);
+  AlwaysAssertExit (ArrayArena::roundedSize(1000) == 1024);
+  AlwaysAssertExit (ArrayArena::roundedSize(ArrayArena::MaxBlockSize) ==
+                    size_t(ArrayArena::MaxBlockSize));
+  AlwaysAssertExit (ArrayArena::roundedSize(ArrayArena::MaxBlockSize+1) ==
+                    size_t(ArrayArena::MaxBlockSize+1));
+  for (size_t n=1; n<=ArrayArena::MaxBlockSize; n+=n/7+1) {
+    size_t sz = ArrayArena::roundedSize(n);
+    AlwaysAssertExit (sz >= n  &&  sz % 8 == 0);
+    AlwaysAssertExit (sz <= 64  ||  sz <= n + n/8 + 8);
+  }
+}
+
+void testNoScope()
+{
+  // Without a scope, nothing is kept.
+  AlwaysAssertExit (! ArrayArena::isActive());
+  ArrayArena::resetStatistics();
+  for (uInt i=0; i<10; ++i) {
+    Array<Float> arr(IPosition(2,4,5), Float(i));
+    AlwaysAssertExit (allEQ (arr, Float(i)));
+  }
+  ArrayArenaStatistics stats = ArrayArena::statistics();
+  AlwaysAssertExit (stats.nallocate == 10);
+  AlwaysAssertExit (stats.ndeallocate == 10);
+  AlwaysAssertExit (stats.nreused == 0);
+  AlwaysAssertExit (stats.ncached == 0);
+}
+
+void testScope()
+{
+  ArrayArena::resetStatistics();
+  {
+    ArrayArenaScope arena;
+    AlwaysAssertExit (ArrayArena::isActive());
+    Array<Double> sumArr(IPosition(2,10,10), 0.);
+    for (uInt i=0; i<100; ++i) {
+      // The temporaries in this loop reuse the storage of the previous ones.
+      Array<Double> arr(IPosition(2,10,10), Double(i));
+      sumArr = sumArr + arr;
+    }
+    AlwaysAssertExit (allEQ (sumArr, 4950.));
+  }
+  AlwaysAssertExit (! ArrayArena::isActive());
+  ArrayArenaStatistics stats = ArrayArena::statistics();
+  AlwaysAssertExit (stats.nallocate == stats.ndeallocate);
+  AlwaysAssertExit (stats.nreused > 100);
+  AlwaysAssertExit (stats.ncached >= stats.nreused);
+  cout << "allocations: " << stats.nallocate
+       << "  reused: " << stats.nreused << endl;
+}
+
+void testNested()
+{
+  ArrayArena::resetStatistics();
+  {
+    ArrayArenaScope outer;
+    {
+      ArrayArenaScope inner;
+      Block<Int> blk(100, 1);
+    }
+    // The block is still kept after the inner scope.
+    AlwaysAssertExit (ArrayArena::isActive());
+    Block<Int> blk(100, 2);
+    AlwaysAssertExit (blk[99] == 2);
+    AlwaysAssertExit (ArrayArena::statistics().nreused == 1);
+  }
+  AlwaysAssertExit (! ArrayArena::isActive());
+  // The kept blocks have been released, so no reuse anymore.
+  ArrayArena::resetStatistics();
+  Block<Int> blk(100, 3);
+  AlwaysAssertExit (ArrayArena::statistics().nreused == 0);
+}
+
+void testLimits()
+{
+  ArrayArena::resetStatistics();
+  size_t maxCached = ArrayArena::maxCachedBytes();
+  ArrayArena::setMaxCachedBytes (1000);
+  {
+    ArrayArenaScope arena;
+    // Too large to be kept.
+    { Block<Char> blk(2000); }
+    // Too large to be handled by the arena.
+    { Block<Char> blk(ArrayArena::MaxBlockSize + 1); }
+    { Block<Char> blk(500); }
+    { Block<Char> blk(500); }
+  }
+  ArrayArena::setMaxCachedBytes (maxCached);
+  ArrayArenaStatistics stats = ArrayArena::statistics();
+  AlwaysAssertExit (stats.nallocate == 3);
+  AlwaysAssertExit (stats.ncached == 2);
+  AlwaysAssertExit (stats.nreused == 1);
+}
+
+int main()
+{
+  try {
+    testSizeClasses();
+    testNoScope();
+    testScope();
+    testNested();
+    testLimits();
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
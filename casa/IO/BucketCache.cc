@@ -30,6 +30,11 @@
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -61,8 +66,13 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_LRU           (cacheSize, uInt(0)),
   its_LRUCounter    (0),
   its_Buffer        (0),
+  its_NThread       (1),
   its_NrOfFree      (0),
-  its_FirstFree     (-1)
+  its_FirstFree     (-1),
+  its_PrefetchSize  (0),
+  its_LastMiss      (-1),
+  its_MissStride    (0),
+  its_LastPrefetch  (-1)
 {
     initStatistics();
     // The bucketsize must be set.
@@ -113,6 +123,17 @@ void BucketCache::clear (uInt fromSlot, Bool doFlush)
     if (fromSlot == 0) {
 	its_LRUCounter = 0;
 	initStatistics();
+        // Forget the prefetch state.
+        if (its_LastPrefetch >= 0) {
+            for (uInt i=0; i<its_SlotNr.nelements(); i++) {
+                if (its_SlotNr[i] == -2) {
+                    its_SlotNr[i] = -1;
+                }
+            }
+        }
+        its_LastMiss     = -1;
+        its_MissStride   = 0;
+        its_LastPrefetch = -1;
     }
     if (fromSlot < its_CacheSizeUsed) {
 	its_CacheSizeUsed = fromSlot;
@@ -125,14 +146,56 @@ Bool BucketCache::flush (uInt fromSlot)
     if (fromSlot == 0  &&  its_NewNrOfBuckets > 0) {
 	initializeBuckets (its_NewNrOfBuckets - 1);
     }
-    Bool hasWritten = False;
+    // Collect the dirty buckets in order of bucket number, so buckets
+    // adjacent in the file can be written in a single IO operation.
+    Block<uInt> bucketNrs(its_CacheSizeUsed);
+    uInt nslot = 0;
     for (uInt i=fromSlot; i<its_CacheSizeUsed; i++) {
 	if (its_Dirty[i]) {
-	    writeBucket (i);
-	    hasWritten = True;
+	    bucketNrs[nslot++] = its_BucketNr[i];
 	}
     }
-    return hasWritten;
+    if (nslot == 1) {
+        writeBucket (its_SlotNr[bucketNrs[0]]);
+    } else if (nslot > 1) {
+        std::sort (bucketNrs.storage(), bucketNrs.storage() + nslot);
+        // Convert as many buckets (in parallel) as fit in 1 MB or as
+        // threads are used. Thereafter write them; consecutive buckets
+        // are written at once.
+        uInt nbuf = std::max (its_NThread,
+                              std::max (1u, 1048576u / its_BucketSize));
+        nbuf = std::min (nbuf, nslot);
+        if (its_MultiBuffer.nelements() < size_t(nbuf) * its_BucketSize) {
+            its_MultiBuffer.resize (size_t(nbuf) * its_BucketSize,
+                                    False, False);
+        }
+        char* buf = its_MultiBuffer.storage();
+        for (uInt first=0; first<nslot; first+=nbuf) {
+            Int nr = std::min (nbuf, nslot-first);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(its_NThread) if (its_NThread > 1)
+#endif
+            for (Int k=0; k<nr; k++) {
+                its_WriteCallBack (its_Owner, buf + size_t(k)*its_BucketSize,
+                                   its_Cache[its_SlotNr[bucketNrs[first+k]]]);
+            }
+            Int st = 0;
+            for (Int k=0; k<nr; k++) {
+                its_Dirty[its_SlotNr[bucketNrs[first+k]]] = 0;
+                nwrite_p++;
+                if (k+1 == nr
+                ||  bucketNrs[first+k+1] != bucketNrs[first+k] + 1) {
+                    its_file->seek (its_StartOffset +
+                                    Int64(bucketNrs[first+st]) *
+                                    its_BucketSize);
+                    its_file->write (buf + size_t(st)*its_BucketSize,
+                                     (k+1-st) * its_BucketSize);
+                    st = k+1;
+                }
+            }
+        }
+    }
+    return nslot > 0;
 }
 
 void BucketCache::resize (uInt cacheSize)
@@ -182,6 +245,19 @@ void BucketCache::resync (uInt nrBucket, uInt nrOfFreeBucket,
 }
 
 
+void BucketCache::setPrefetch (uInt nrBucket)
+{
+    its_PrefetchSize = nrBucket;
+    its_LastPrefetch = -1;
+}
+
+
+void BucketCache::setNThread (uInt nthread)
+{
+    its_NThread = std::max (nthread, 1u);
+}
+
+
 uInt BucketCache::nBucket() const
 {
     return its_NewNrOfBuckets;
@@ -221,6 +297,9 @@ char* BucketCache::getBucket (uInt bucketNr)
     // Read the bucket when it is already in the file.
     // Otherwise get a new initialized bucket.
     if (bucketNr < its_CurNrOfBuckets) {
+        if (its_PrefetchSize > 0) {
+            doPrefetch (bucketNr);
+        }
 	getSlot (bucketNr);
 	readBucket (its_ActualSlot);
     }else{
@@ -234,6 +313,92 @@ char* BucketCache::getBucket (uInt bucketNr)
     return its_Cache[its_ActualSlot];
 }
 
+void BucketCache::getBuckets (uInt nrBucket, const uInt* bucketNrs,
+                              char** data, Bool dirty)
+{
+    if (nrBucket > its_CacheSize) {
+        throw AipsError ("BucketCache::getBuckets: " +
+                         String::toString(nrBucket) +
+                         " buckets do not fit in cache of size " +
+                         String::toString(its_CacheSize));
+    }
+    if (its_MultiBuffer.nelements() < size_t(nrBucket) * its_BucketSize) {
+        its_MultiBuffer.resize (size_t(nrBucket) * its_BucketSize,
+                                False, False);
+    }
+    char* buf = its_MultiBuffer.storage();
+    // Initialize new buckets first, so all buckets can be read hereafter.
+    Int64 lastNew = -1;
+    for (uInt i=0; i<nrBucket; i++) {
+        if (bucketNrs[i] >= its_NewNrOfBuckets) {
+            throw (indexError<Int> (bucketNrs[i]));
+        }
+        if (bucketNrs[i] >= its_CurNrOfBuckets) {
+            lastNew = std::max (lastNew, Int64(bucketNrs[i]));
+        }
+    }
+    if (lastNew >= 0) {
+        if (! its_file->isWritable()) {
+            throw AipsError ("BucketCache::getBuckets: bucket " +
+                             String::toString(lastNew) +
+                             " exceeds nr of buckets");
+        }
+        initializeBuckets (lastNew);
+    }
+    // Find the buckets to read and get a slot for them.
+    // The slots get the most recent LRU, so they cannot be reused by
+    // other buckets in this call (because nrBucket <= cacheSize).
+    // Consecutive buckets are read in a single IO operation.
+    Block<uInt> readInx(nrBucket);
+    uInt nread = 0;
+    uInt nrun  = 0;
+    for (uInt i=0; i<nrBucket; i++) {
+        uInt bucketNr = bucketNrs[i];
+        naccess_p++;
+        if (its_SlotNr[bucketNr] >= 0) {
+            its_ActualSlot = its_SlotNr[bucketNr];
+            setLRU();
+            data[i] = its_Cache[its_ActualSlot];
+        } else {
+            if (its_PrefetchSize > 0) {
+                doPrefetch (bucketNr);
+            }
+            getSlot (bucketNr);
+            if (nrun > 0  &&  bucketNr != bucketNrs[readInx[nread-1]] + 1) {
+                uInt first = bucketNrs[readInx[nread-nrun]];
+                its_file->seek (its_StartOffset + Int64(first)*its_BucketSize);
+                its_file->read (buf + size_t(nread-nrun)*its_BucketSize,
+                                nrun*its_BucketSize);
+                nrun = 0;
+            }
+            readInx[nread++] = i;
+            nrun++;
+            nread_p++;
+        }
+        if (dirty) {
+            its_Dirty[its_ActualSlot] = 1;
+        }
+    }
+    if (nrun > 0) {
+        uInt first = bucketNrs[readInx[nread-nrun]];
+        its_file->seek (its_StartOffset + Int64(first)*its_BucketSize);
+        its_file->read (buf + size_t(nread-nrun)*its_BucketSize,
+                        nrun*its_BucketSize);
+    }
+    // Convert the buckets read (in parallel).
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(its_NThread) if (nread > 1)
+#endif
+    for (Int k=0; k<Int(nread); k++) {
+        uInt slotNr = its_SlotNr[bucketNrs[readInx[k]]];
+        its_Cache[slotNr] = its_ReadCallBack (its_Owner,
+                                              buf + size_t(k)*its_BucketSize);
+    }
+    for (uInt k=0; k<nread; k++) {
+        data[readInx[k]] = its_Cache[its_SlotNr[bucketNrs[readInx[k]]]];
+    }
+}
+
 void BucketCache::extend (uInt nrBucket)
 {
     its_NewNrOfBuckets += nrBucket;
@@ -368,6 +533,56 @@ void BucketCache::readBucket (uInt slotNr)
     its_Cache[slotNr] = its_ReadCallBack (its_Owner, its_Buffer);
     nread_p++;
 }
+void BucketCache::doPrefetch (uInt bucketNr)
+{
+    // A slotnr -2 means that the bucket has been prefetched.
+    if (its_SlotNr[bucketNr] == -2) {
+        nprefUsed_p++;
+    }
+    // Only prefetch if the last misses had the same stride.
+    Int64 stride = Int64(bucketNr) - its_LastMiss;
+    Bool sameStride = (its_LastMiss >= 0  &&  stride != 0  &&
+                       stride == its_MissStride);
+    its_LastMiss   = bucketNr;
+    its_MissStride = stride;
+    if (!sameStride) {
+        its_LastPrefetch = -1;
+        return;
+    }
+    // Continue after the buckets already prefetched for this pattern.
+    Int64 k = 1;
+    if (its_LastPrefetch >= 0) {
+        k = std::max (k, (its_LastPrefetch - Int64(bucketNr)) / stride + 1);
+    }
+    // Consecutive buckets are prefetched in a single request.
+    Int64 startNr = -1;
+    Int64 endNr   = -1;
+    for (; k<=Int64(its_PrefetchSize); k++) {
+        Int64 nr = bucketNr + k*stride;
+        if (nr < 0  ||  nr >= Int64(its_CurNrOfBuckets)) {
+            break;
+        }
+        its_LastPrefetch = nr;
+        if (its_SlotNr[nr] == -1) {
+            its_SlotNr[nr] = -2;
+            nprefetch_p++;
+            if (startNr >= 0  &&  nr == endNr+1) {
+                endNr = nr;
+            } else {
+                if (startNr >= 0) {
+                    its_file->prefetch (its_StartOffset + startNr*its_BucketSize,
+                                        (endNr-startNr+1) * its_BucketSize);
+                }
+                startNr = endNr = nr;
+            }
+        }
+    }
+    if (startNr >= 0) {
+        its_file->prefetch (its_StartOffset + startNr*its_BucketSize,
+                            (endNr-startNr+1) * its_BucketSize);
+    }
+}
+
 void BucketCache::initializeBuckets (uInt bucketNr)
 {
     // Initialize this bucket and all uninitialized ones before it.
@@ -403,6 +618,10 @@ void BucketCache::showStatistics (ostream& os) const
     if (nwrite_p > 0) {
 	os << "#writes:   " << nwrite_p << endl;
     }
+    if (nprefetch_p > 0) {
+	os << "#prefetch: " << nprefetch_p << "         (" << nprefUsed_p
+           << " used)" << endl;
+    }
     os << "#accesses: " << naccess_p;
     if (naccess_p > 0) {
 	os << "        hit-rate:  "
@@ -418,6 +637,8 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nprefetch_p = 0;
+    nprefUsed_p = 0;
 }
 
 } //# NAMESPACE CASACORE - END
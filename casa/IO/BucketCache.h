@@ -141,6 +141,24 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // for example, be used to have tiled arrays with different tile shapes
 // in the same file.
 // <p>
+// Optionally the cache can prefetch buckets. When enabled (using
+// <src>setPrefetch</src>), the cache looks at the bucket numbers of
+// consecutive cache misses. If the same stride is found twice in a row
+// (e.g. a sequential or strided scan), the file is told that the next
+// buckets using that stride will be needed soon. The operating system
+// can then read them asynchronously, so a subsequent miss on such a bucket
+// does not have to wait for the disk.
+// <p>
+// Function <src>getBuckets</src> makes multiple buckets available at once.
+// The buckets not in the cache are read first, whereafter they are
+// converted in parallel (using OpenMP) if the number of threads has been
+// set using <src>setNThread</src>. In the same way <src>flush</src>
+// converts the dirty buckets in parallel before writing them.
+// <src>flush</src> writes the dirty buckets in order of bucket number,
+// where buckets adjacent in the file are written in a single IO operation.
+// Note that the callback functions must be thread-safe if multiple
+// threads are used.
+// <p>
 // Statistics are kept to know how efficient the cache is working.
 // It is possible to initialize and show the statistics.
 // </synopsis> 
@@ -264,6 +282,22 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Set the number of buckets to prefetch when a sequential or strided
+    // access pattern is detected. 0 means that no prefetching is done.
+    void setPrefetch (uInt nrBucket);
+
+    // Get the number of buckets to prefetch.
+    uInt prefetchSize() const;
+
+    // Set the number of threads to use for converting buckets in
+    // <src>getBuckets</src> and <src>flush</src>. It has only effect if
+    // compiled with OpenMP. The ToLocal and FromLocal callback functions
+    // must be thread-safe if more than one thread is used.
+    void setNThread (uInt nthread);
+
+    // Get the number of threads to use.
+    uInt nThread() const;
+
     // Set the dirty bit for the current bucket.
     void setDirty();
 
@@ -276,6 +310,16 @@ public:
     // A pointer to the data in converted format is returned.
     char* getBucket (uInt bucketNr);
 
+    // Make multiple buckets available in the cache and return pointers to
+    // their data in local format.
+    // The buckets not in the cache are read in one pass, whereafter they
+    // are converted in parallel using the ToLocal callback function.
+    // The bucket numbers must be different and their number cannot exceed
+    // the cache size, otherwise an exception is thrown.
+    // If <src>dirty=True</src> the dirty flag is set for all buckets.
+    void getBuckets (uInt nrBucket, const uInt* bucketNrs, char** data,
+                     Bool dirty=False);
+
     // Extend the file with the given number of buckets.
     // The buckets get initialized when they are acquired
     // (using getBucket) for the first time.
@@ -360,15 +404,29 @@ private:
     uInt         its_LRUCounter;
     // The internal buffer.
     char*        its_Buffer;
+    // The buffer used to read or write multiple buckets.
+    Block<char>  its_MultiBuffer;
+    // The number of threads to use for converting multiple buckets.
+    uInt         its_NThread;
     // The number of free buckets.
     uInt its_NrOfFree;
     // The first free bucket (-1 = no free buckets).
     Int  its_FirstFree;
+    // The number of buckets to prefetch (0 = no prefetching).
+    uInt its_PrefetchSize;
+    // The bucket read at the last cache miss (-1 = none yet).
+    Int64 its_LastMiss;
+    // The stride between the last two cache misses.
+    Int64 its_MissStride;
+    // The last bucket for which a prefetch has been requested (-1 = none).
+    Int64 its_LastPrefetch;
     // The statistics.
     uInt naccess_p;
     uInt nread_p;
     uInt ninit_p;
     uInt nwrite_p;
+    uInt nprefetch_p;
+    uInt nprefUsed_p;
 
 
     // Copy constructor is not possible.
@@ -389,6 +447,10 @@ private:
     // Read a bucket.
     void readBucket (uInt slotNr);
 
+    // Detect the access pattern from the bucket missed in the cache and
+    // ask the file to prefetch the next buckets if a stride is found.
+    void doPrefetch (uInt bucketNr);
+
     // Initialize the bucket buffer.
     // The uninitialized buckets before this bucket are also initialized.
     // It returns a pointer to the buffer.
@@ -403,6 +465,12 @@ private:
 inline uInt BucketCache::cacheSize() const
     { return its_CacheSize; }
 
+inline uInt BucketCache::prefetchSize() const
+    { return its_PrefetchSize; }
+
+inline uInt BucketCache::nThread() const
+    { return its_NThread; }
+
 inline Int BucketCache::firstFreeBucket() const
     { return its_FirstFree; }
 
@@ -217,6 +217,15 @@ void BucketFile::seek (Int64 offset)
     file_p->seek (offset, ByteIO::Begin);
 }
 
+void BucketFile::prefetch (Int64 offset, Int64 length)
+{
+#ifdef POSIX_FADV_WILLNEED
+    if (fd_p >= 0) {
+        posix_fadvise (fd_p, offset, length, POSIX_FADV_WILLNEED);
+    }
+#endif
+}
+
 Int64 BucketFile::fileSize () const
 {
     // If a buffered file is used, seek in there. Otherwise its internal
@@ -180,6 +180,12 @@ public:
     // This is doing a seek and sets the file pointer to end-of-file.
     virtual Int64 fileSize() const;
 
+    // Tell the system that the given part of the file will be read soon,
+    // so it can be read ahead asynchronously.
+    // It is only a hint; it does nothing for a file in a MultiFileBase
+    // or if the system does not support it.
+    virtual void prefetch (Int64 offset, Int64 length);
+
     // Is the file cached, mapped, or buffered?
     // <group>
     Bool isCached() const;
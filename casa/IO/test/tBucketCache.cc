@@ -29,6 +29,7 @@
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
 
 #include <casacore/casa/namespace.h>
@@ -40,6 +41,8 @@ void a (Bool);
 void b (Bool);
 void c (uInt bufSize);
 void d (uInt bufSize);
+void e();
+void f();
 
 int main (int argc, const char*[])
 {
@@ -54,6 +57,8 @@ int main (int argc, const char*[])
 //	d (1024);
 //	d (32768);
 //	d (327680);
+	e();
+	f();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -256,3 +261,90 @@ void d (uInt)
     timer.show();
     cout << "<<<" << endl;
 }
+
+// Get the expected first value in a bucket written by a().
+Int expectedValue (Int bucketNr)
+{
+    if (bucketNr < 5) {
+        return bucketNr+1;
+    } else if (bucketNr < 105) {
+        return bucketNr-4;
+    } else if (bucketNr == 110) {
+        return 110;
+    }
+    return bucketNr-99;
+}
+
+// Read sequentially and strided using prefetching.
+void e()
+{
+    // Open the file.
+    BucketFile file("tBucketCache_tmp.data", False);
+    file.open();
+    Int i;
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache (&file, 512, 32768, rec[0], 4, 0, aToLocal, aFromLocal,
+		       aInitBuffer, aDeleteBuffer);
+    cache.setPrefetch (8);
+    AlwaysAssertExit (cache.prefetchSize() == 8);
+    for (i=0; i<Int(cache.nBucket()); i++) {
+	char* buf = cache.getBucket(i);
+	if (*(Int*)buf != expectedValue(i)) {
+	    cout << "Error in prefetched bucket " << i << endl;
+	}
+    }
+    for (i=Int(cache.nBucket())-1; i>=0; i-=3) {
+	char* buf = cache.getBucket(i);
+	if (*(Int*)buf != expectedValue(i)) {
+	    cout << "Error in prefetched bucket " << i << endl;
+	}
+    }
+    cache.showStatistics (cout);
+    cache.clear();
+    cache.setPrefetch (0);
+    for (i=0; i<Int(cache.nBucket()); i++) {
+	cache.getBucket(i);
+    }
+    cache.showStatistics (cout);
+}
+
+// Get multiple buckets at once using multiple threads.
+void f()
+{
+    // Open the file.
+    BucketFile file("tBucketCache_tmp.data", False);
+    file.open();
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache (&file, 512, 32768, rec[0], 8, 0, aToLocal, aFromLocal,
+		       aInitBuffer, aDeleteBuffer);
+    cache.setNThread (4);
+    AlwaysAssertExit (cache.nThread() == 4);
+    uInt bucketNrs[8];
+    char* data[8];
+    // Get batches of buckets with a stride (and some overlap).
+    for (uInt first=0; first<cache.nBucket(); first+=5) {
+        uInt nr = 0;
+        for (uInt i=first; i<cache.nBucket() && nr<8; i+=2) {
+            bucketNrs[nr++] = i;
+        }
+        cache.getBuckets (nr, bucketNrs, data);
+        for (uInt i=0; i<nr; i++) {
+            if (*(Int*)(data[i]) != expectedValue(bucketNrs[i])) {
+                cout << "Error in multi bucket " << bucketNrs[i] << endl;
+            }
+        }
+    }
+    cache.showStatistics (cout);
+    // Too many buckets cannot be obtained.
+    Bool flag = False;
+    try {
+        uInt nrs[9] = {0,1,2,3,4,5,6,7,8};
+        char* ptrs[9];
+        cache.getBuckets (9, nrs, ptrs);
+    } catch (AipsError& x) {
+        flag = True;
+    }
+    AlwaysAssertExit (flag);
+}
@@ -34,6 +34,20 @@
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+//# Byte swapping uses SSSE3 byte shuffles if the compiler targets SSSE3.
+//# Otherwise GCC (and clang) on x86 compile the SSSE3 kernel separately
+//# and use it if the CPU supports it (tested at run time).
+#if defined(__SSSE3__)
+# include <tmmintrin.h>
+# define CONVERSION_SSSE3_TARGET
+# define CONVERSION_HAS_SSSE3 1
+#elif (defined(__x86_64__) || defined(__i386__)) && \
+      (defined(__clang__) || __GNUC__ > 4 || \
+       (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+# include <tmmintrin.h>
+# define CONVERSION_SSSE3_TARGET __attribute__ ((target ("ssse3")))
+# define CONVERSION_HAS_SSSE3 2
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -523,5 +537,89 @@ size_t Conversion::valueCopy (void* to, const void* from,
 }
 
 
+// Reverse the bytes of values of N bytes one by one.
+// The compiler can unroll the inner loop, because N is known.
+// All bytes of a value are read before writing, so to==from is possible.
+template<int N>
+inline void Conversion_byteSwap (char* to, const char* from, size_t nvalues)
+{
+    for (size_t i=0; i<nvalues; ++i) {
+        char tmp[N];
+        memcpy (tmp, from, N);
+        for (int j=0; j<N; ++j) {
+            to[j] = tmp[N-1-j];
+        }
+        to   += N;
+        from += N;
+    }
+}
+
+#ifdef CONVERSION_HAS_SSSE3
+// Reverse the bytes of values of N bytes using SSSE3 shuffles on blocks
+// of 16 bytes. It returns the number of values done.
+template<int N>
+CONVERSION_SSSE3_TARGET
+size_t Conversion_byteSwapSSSE3 (char* to, const char* from, size_t nvalues)
+{
+    char m[16];
+    for (int i=0; i<16; ++i) {
+        m[i] = (i/N)*N + N-1 - i%N;
+    }
+    __m128i mask = _mm_loadu_si128 ((const __m128i*)m);
+    size_t nblock = nvalues*N / 16;
+    for (size_t i=0; i<nblock; ++i) {
+        __m128i v = _mm_loadu_si128 ((const __m128i*)(from + 16*i));
+        _mm_storeu_si128 ((__m128i*)(to + 16*i), _mm_shuffle_epi8 (v, mask));
+    }
+    return nblock*16 / N;
+}
+
+// Test if SSSE3 can be used.
+inline Bool Conversion_useSSSE3()
+{
+# if CONVERSION_HAS_SSSE3 == 1
+    return True;
+# else
+    // The init is needed if called before static constructors are run.
+    static const Bool hasSSSE3 = (__builtin_cpu_init(),
+                                  __builtin_cpu_supports ("ssse3"));
+    return hasSSSE3;
+# endif
+}
+#endif
+
+template<int N>
+inline void Conversion_byteSwapAll (void* to, const void* from,
+                                    size_t nvalues)
+{
+    char* t = static_cast<char*>(to);
+    const char* f = static_cast<const char*>(from);
+#ifdef CONVERSION_HAS_SSSE3
+    if (Conversion_useSSSE3()) {
+        size_t ndone = Conversion_byteSwapSSSE3<N> (t, f, nvalues);
+        t += ndone*N;
+        f += ndone*N;
+        nvalues -= ndone;
+    }
+#endif
+    Conversion_byteSwap<N> (t, f, nvalues);
+}
+
+void Conversion::byteSwap2 (void* to, const void* from, size_t nvalues)
+{
+    Conversion_byteSwapAll<2> (to, from, nvalues);
+}
+
+void Conversion::byteSwap4 (void* to, const void* from, size_t nvalues)
+{
+    Conversion_byteSwapAll<4> (to, from, nvalues);
+}
+
+void Conversion::byteSwap8 (void* to, const void* from, size_t nvalues)
+{
+    Conversion_byteSwapAll<8> (to, from, nvalues);
+}
+
+
 } //# NAMESPACE CASACORE - END
 
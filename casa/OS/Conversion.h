@@ -62,6 +62,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <li>
 // It defines a private version of memcpy for compilers having a
 // different signature for memcpy (e.g. ObjectCenter and DEC-Alpha).
+// <li>
+// It defines functions to reverse the byte order of an array of values.
+// They are used by the canonical conversion functions of types needing
+// byte swapping.
 // </ul>
 // Static functions in the classes
 // <linkto class=CanonicalConversion>CanonicalConversion</linkto>,
@@ -141,6 +145,22 @@ public:
     // Get a pointer to the memcpy function.
     static ByteFunction* getmemcpy();
 
+    // Reverse the byte order of <src>nvalues</src> values of 2, 4, or 8
+    // bytes (e.g. for the conversion between little and big endian).
+    // The buffers do not need to be aligned. They can be the same buffer,
+    // but should not partly overlap. <src>byteSwap</src> copies values
+    // of other sizes as such.
+    // <br>SSSE3 byte shuffles are used if the compiler targets SSSE3.
+    // Otherwise, when compiled with GCC on x86, they are used if the
+    // CPU supports SSSE3 (tested at run time).
+    // <group>
+    static void byteSwap2 (void* to, const void* from, size_t nvalues);
+    static void byteSwap4 (void* to, const void* from, size_t nvalues);
+    static void byteSwap8 (void* to, const void* from, size_t nvalues);
+    static void byteSwap  (void* to, const void* from, size_t nvalues,
+                           size_t valueSize);
+    // </group>
+
 private:
     // Copy bits to Bool in an unoptimized way needed when 'to' is not
     // aligned properly.
@@ -154,6 +174,24 @@ inline Conversion::ByteFunction* Conversion::getmemcpy()
     return memcpy;
 }
 
+inline void Conversion::byteSwap (void* to, const void* from, size_t nvalues,
+                                  size_t valueSize)
+{
+    switch (valueSize) {
+    case 2:
+        byteSwap2 (to, from, nvalues);
+        break;
+    case 4:
+        byteSwap4 (to, from, nvalues);
+        break;
+    case 8:
+        byteSwap8 (to, from, nvalues);
+        break;
+    default:
+        memmove (to, from, nvalues*valueSize);
+    }
+}
+
 
 
 } //# NAMESPACE CASACORE - END
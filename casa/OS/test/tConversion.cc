@@ -70,6 +70,37 @@ void checkAll()
   }
 }
 
+// Check the byte swap functions for various lengths and alignments.
+void checkByteSwap()
+{
+  cout << "checkByteSwap ..." << endl;
+  uChar in[8*42];
+  uChar out[8*42];
+  for (uInt i=0; i<sizeof(in); ++i) {
+    in[i] = i;
+  }
+  for (uInt size=2; size<=8; size*=2) {
+    for (uInt off=0; off<2; ++off) {
+      for (uInt nr=0; nr<=41; nr+=(nr<20 ? 1:7)) {
+        memset (out, 0, sizeof(out));
+        Conversion::byteSwap (out+off, in+off, nr, size);
+        for (uInt i=0; i<nr; ++i) {
+          for (uInt j=0; j<size; ++j) {
+            AlwaysAssertExit (out[off + i*size + j] ==
+                              in[off + i*size + size-1-j]);
+          }
+        }
+        AlwaysAssertExit (out[off + nr*size] == 0);
+        // Swapping in place should give the original values.
+        Conversion::byteSwap (out+off, out+off, nr, size);
+        for (uInt i=0; i<nr*size; ++i) {
+          AlwaysAssertExit (out[off+i] == in[off+i]);
+        }
+      }
+    }
+  }
+}
+
 int main()
 {
     uInt nbool = 100;
@@ -155,6 +186,7 @@ int main()
     delete [] bits;
 
     checkAll();
+    checkByteSwap();
     cout << "OK" << endl;
     return 0;
 }
@@ -0,0 +1,293 @@
+//# ExternalSort.cc: Merge sorted runs of records spilled to temporary files
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/Utilities/ExternalSort.h>
+#include <casacore/casa/Utilities/Compare.h>
+#include <casacore/casa/Utilities/SortError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/IO/RawIO.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/File.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// Base class holding the values of a key for the runs being merged.
+// Slot i holds the current value of run i; the last slot holds the
+// value of the record output last.
+class ExternalSortKey
+{
+public:
+    virtual ~ExternalSortKey()
+      {}
+    virtual void resize (uInt nslot) = 0;
+    virtual void write (TypeIO& io, const void* data, uInt index) = 0;
+    virtual void read (TypeIO& io, uInt slot) = 0;
+    virtual void copy (uInt from, uInt to) = 0;
+    virtual int compare (uInt slot1, uInt slot2) const = 0;
+};
+
+template<typename T>
+class ExternalSortKeyT : public ExternalSortKey
+{
+public:
+    virtual void resize (uInt nslot)
+      { values_p.resize (nslot, True, False); }
+    virtual void write (TypeIO& io, const void* data, uInt index)
+      { io.write (1, static_cast<const T*>(data) + index); }
+    virtual void read (TypeIO& io, uInt slot)
+      { io.read (1, &(values_p[slot])); }
+    virtual void copy (uInt from, uInt to)
+      { values_p[to] = values_p[from]; }
+    virtual int compare (uInt slot1, uInt slot2) const
+      { return ObjCompare<T>::compare (&(values_p[slot1]),
+                                       &(values_p[slot2])); }
+private:
+    Block<T> values_p;
+};
+
+
+ExternalSort::ExternalSort (const String& directory)
+: directory_p (directory)
+{}
+
+ExternalSort::~ExternalSort()
+{
+    removeFiles();
+    for (uInt i=0; i<keys_p.nelements(); ++i) {
+        delete keys_p[i];
+    }
+}
+
+void ExternalSort::sortKey (DataType dtype, Sort::Order order)
+{
+    if (! files_p.empty()) {
+        throw SortError ("ExternalSort: all keys must be defined before "
+                         "a run is added");
+    }
+    ExternalSortKey* key = 0;
+    switch (dtype) {
+    case TpBool:
+        key = new ExternalSortKeyT<Bool>;
+        break;
+    case TpChar:
+        key = new ExternalSortKeyT<Char>;
+        break;
+    case TpUChar:
+        key = new ExternalSortKeyT<uChar>;
+        break;
+    case TpShort:
+        key = new ExternalSortKeyT<Short>;
+        break;
+    case TpUShort:
+        key = new ExternalSortKeyT<uShort>;
+        break;
+    case TpInt:
+        key = new ExternalSortKeyT<Int>;
+        break;
+    case TpUInt:
+        key = new ExternalSortKeyT<uInt>;
+        break;
+    case TpInt64:
+        key = new ExternalSortKeyT<Int64>;
+        break;
+    case TpFloat:
+        key = new ExternalSortKeyT<Float>;
+        break;
+    case TpDouble:
+        key = new ExternalSortKeyT<Double>;
+        break;
+    case TpComplex:
+        key = new ExternalSortKeyT<Complex>;
+        break;
+    case TpDComplex:
+        key = new ExternalSortKeyT<DComplex>;
+        break;
+    case TpString:
+        key = new ExternalSortKeyT<String>;
+        break;
+    default:
+        throw SortError ("ExternalSort: invalid data type of sort key");
+    }
+    uInt nr = keys_p.nelements();
+    keys_p.resize (nr+1);
+    keys_p[nr] = key;
+    orders_p.resize (nr+1);
+    orders_p[nr] = (order == Sort::Descending  ?  -1 : 1);
+}
+
+void ExternalSort::addRun (const Block<const void*>& data,
+                           const Vector<uInt>& index,
+                           const Vector<uInt>& rownrs)
+{
+    uInt nrkey = keys_p.nelements();
+    if (data.nelements() != nrkey) {
+        throw SortError ("ExternalSort: mismatching number of keys in run");
+    }
+    String name = File::newUniqueName (directory_p,
+                                       "ExternalSort_").absoluteName();
+    files_p.push_back (name);
+    nrec_p.push_back (index.size());
+    RawIO io (new RegularFileIO (RegularFile(name), ByteIO::New, 1048576),
+              True);
+    for (uInt i=0; i<index.size(); ++i) {
+        uInt inx = index[i];
+        io.write (1, &(rownrs[inx]));
+        for (uInt j=0; j<nrkey; ++j) {
+            keys_p[j]->write (io, data[j], inx);
+        }
+    }
+}
+
+int ExternalSort::compare (uInt slot1, uInt slot2) const
+{
+    for (uInt i=0; i<keys_p.nelements(); ++i) {
+        int seq = keys_p[i]->compare (slot1, slot2);
+        if (seq != 0) {
+            return seq * orders_p[i];
+        }
+    }
+    return 0;
+}
+
+Bool ExternalSort::before (uInt run1, uInt run2) const
+{
+    // Equal records are taken from the first run to keep the sort stable.
+    int seq = compare (run1, run2);
+    return (seq < 0  ||  (seq == 0  &&  run1 < run2));
+}
+
+Bool ExternalSort::readNext (uInt run, TypeIO& io)
+{
+    if (nleft_p[run] == 0) {
+        return False;
+    }
+    nleft_p[run]--;
+    io.read (1, &(rownrs_p[run]));
+    for (uInt i=0; i<keys_p.nelements(); ++i) {
+        keys_p[i]->read (io, run);
+    }
+    return True;
+}
+
+void ExternalSort::siftDown (std::vector<uInt>& heap, uInt index) const
+{
+    uInt nr = heap.size();
+    uInt run = heap[index];
+    while (2*index+1 < nr) {
+        uInt child = 2*index+1;
+        if (child+1 < nr  &&  before (heap[child+1], heap[child])) {
+            child++;
+        }
+        if (! before (heap[child], run)) {
+            break;
+        }
+        heap[index] = heap[child];
+        index = child;
+    }
+    heap[index] = run;
+}
+
+uInt ExternalSort::merge (Vector<uInt>& rownrs, Bool noDuplicates)
+{
+    uInt nrun = files_p.size();
+    uInt nrec = 0;
+    for (uInt i=0; i<nrun; ++i) {
+        nrec += nrec_p[i];
+    }
+    rownrs.resize (nrec);
+    // Slot nrun holds the record output last.
+    for (uInt i=0; i<keys_p.nelements(); ++i) {
+        keys_p[i]->resize (nrun+1);
+    }
+    rownrs_p.resize (nrun+1);
+    nleft_p = nrec_p;
+    // Open the runs and read their first records.
+    PtrBlock<TypeIO*> ios(nrun, static_cast<TypeIO*>(0));
+    std::vector<uInt> heap;
+    heap.reserve (nrun);
+    try {
+        for (uInt i=0; i<nrun; ++i) {
+            ios[i] = new RawIO (new RegularFileIO (RegularFile(files_p[i]),
+                                                   ByteIO::Old, 1048576),
+                                True);
+            if (readNext (i, *ios[i])) {
+                heap.push_back (i);
+            }
+        }
+        for (Int i=Int(heap.size())/2 - 1; i>=0; --i) {
+            siftDown (heap, i);
+        }
+        // Repeatedly take the first record and read the next one of its run.
+        uInt nout = 0;
+        while (! heap.empty()) {
+            uInt run = heap[0];
+            if (!noDuplicates  ||  nout == 0  ||  compare (run, nrun) != 0) {
+                rownrs[nout++] = rownrs_p[run];
+                if (noDuplicates) {
+                    for (uInt i=0; i<keys_p.nelements(); ++i) {
+                        keys_p[i]->copy (run, nrun);
+                    }
+                }
+            }
+            if (! readNext (run, *ios[run])) {
+                heap[0] = heap.back();
+                heap.pop_back();
+            }
+            if (! heap.empty()) {
+                siftDown (heap, 0);
+            }
+        }
+        nrec = nout;
+    } catch (...) {
+        for (uInt i=0; i<nrun; ++i) {
+            delete ios[i];
+        }
+        throw;
+    }
+    for (uInt i=0; i<nrun; ++i) {
+        delete ios[i];
+    }
+    rownrs.resize (nrec, True);
+    return nrec;
+}
+
+void ExternalSort::removeFiles()
+{
+    for (uInt i=0; i<files_p.size(); ++i) {
+        RegularFile file(files_p[i]);
+        if (file.exists()) {
+            file.remove();
+        }
+    }
+    files_p.clear();
+    nrec_p.clear();
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,175 @@
+//# ExternalSort.h: Merge sorted runs of records spilled to temporary files
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_EXTERNALSORT_H
+#define CASA_EXTERNALSORT_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+template<class T> class Vector;
+class ExternalSortKey;
+class TypeIO;
+
+
+// <summary> Sort data too large for memory by merging sorted runs </summary>
+// <use visibility=export>
+// <reviewed reviewer="" date="" tests="tExternalSort">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=Sort>Sort</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Class <src>Sort</src> needs the keys of all records in memory.
+// For very large data sets (e.g. the TIME and baseline of all rows in a
+// big MeasurementSet) that might not be possible.
+// Class <src>ExternalSort</src> makes it possible to sort such data sets
+// in parts (runs) that fit in memory. Each run is sorted with class
+// <src>Sort</src> and written to a temporary file. Thereafter the runs
+// are merged using a heap, which results in the record numbers of the
+// entire data set in sorted order.
+// <p>
+// The keys can be of any standard data type that Sort can handle with
+// <src>ValType::getCmpObj</src> (Bool, numeric types, and String).
+// The sort is stable, thus equal records keep their original order
+// provided that the runs are added in the original record order.
+// If duplicates are not needed, they can already be removed when sorting
+// the runs; the merge removes the remaining duplicates.
+// <p>
+// The temporary files are created in the directory given to the
+// constructor. They are removed when the object is destructed.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    ExternalSort extSort (".");
+//    extSort.sortKey (TpDouble);
+//    extSort.sortKey (TpInt, Sort::Descending);
+//    for (each part of the data) {
+//      // Get the keys of the records in the part.
+//      Vector<Double> times = ...;
+//      Vector<Int> ants = ...;
+//      Vector<uInt> rownrs = ...;     // record numbers of the part
+//      Sort sort;
+//      sort.sortKey (times.data(), TpDouble);
+//      sort.sortKey (ants.data(), TpInt, 0, Sort::Descending);
+//      Vector<uInt> index;
+//      sort.sort (index, rownrs.size());
+//      Block<const void*> data(2);
+//      data[0] = times.data();
+//      data[1] = ants.data();
+//      extSort.addRun (data, index, rownrs);
+//    }
+//    Vector<uInt> sortedRows;
+//    extSort.merge (sortedRows);
+// </srcblock>
+// </example>
+
+class ExternalSort
+{
+public:
+    // Create the object. The temporary files containing the runs are
+    // created in the given directory.
+    explicit ExternalSort (const String& directory);
+
+    // The destructor removes the temporary files.
+    ~ExternalSort();
+
+    // Define a sort key (the most significant one first).
+    // All keys have to be defined before the first run is added.
+    void sortKey (DataType, Sort::Order = Sort::Ascending);
+
+    // Get the number of keys.
+    uInt nrkey() const
+      { return keys_p.nelements(); }
+
+    // Add a sorted run and write it to a temporary file.
+    // <src>data[i]</src> points to the values of key i of the records
+    // in the run (with the data type given to <src>sortKey</src>).
+    // <src>index</src> gives the records in sorted order (as returned by
+    // <src>Sort::sort</src>). <src>rownrs</src> gives the record number
+    // of each record; these numbers are returned by <src>merge</src>.
+    void addRun (const Block<const void*>& data, const Vector<uInt>& index,
+                 const Vector<uInt>& rownrs);
+
+    // Get the number of runs added.
+    uInt nrun() const
+      { return files_p.size(); }
+
+    // Merge the runs and return the record numbers in sorted order.
+    // If <src>noDuplicates=True</src>, only the first of equal records is
+    // kept. It returns the number of records.
+    uInt merge (Vector<uInt>& rownrs, Bool noDuplicates=False);
+
+private:
+    // Forbid copy constructor and assignment.
+    // <group>
+    ExternalSort (const ExternalSort&);
+    ExternalSort& operator= (const ExternalSort&);
+    // </group>
+
+    // Compare the records in the given slots.
+    // It returns -1, 0 or 1 if the first one is less, equal or greater
+    // than the second one in the sort order.
+    int compare (uInt slot1, uInt slot2) const;
+
+    // Is the first run before the second one (i.e. used in the heap)?
+    Bool before (uInt run1, uInt run2) const;
+
+    // Read the next record of a run into its slot.
+    // It returns False if the run is exhausted.
+    Bool readNext (uInt run, TypeIO& io);
+
+    // Move a run in the heap down to its proper place.
+    void siftDown (std::vector<uInt>& heap, uInt index) const;
+
+    // Remove the temporary files.
+    void removeFiles();
+
+    String                     directory_p;
+    PtrBlock<ExternalSortKey*> keys_p;
+    Block<Int>                 orders_p;
+    std::vector<String>        files_p;      //# file names of the runs
+    std::vector<uInt>          nrec_p;       //# nr of records per run
+    std::vector<uInt>          nleft_p;      //# nr of records left in merge
+    std::vector<uInt>          rownrs_p;     //# row number in each slot
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
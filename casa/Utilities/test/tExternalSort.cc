@@ -0,0 +1,143 @@
+//# tExternalSort.cc: Test program for class ExternalSort
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/casa/Utilities/ExternalSort.h>
+#include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <stdlib.h>
+
+#include <casacore/casa/namespace.h>
+
+// Sort the data in runs of the given size and merge them.
+// The result must be the same as sorting all data in memory.
+void check (const Vector<Int>& ivec, const Vector<Double>& dvec,
+            const Vector<String>& svec, uInt runSize, Bool noDupl)
+{
+  uInt nr = ivec.size();
+  int opt = Sort::DefaultSort;
+  if (noDupl) {
+    opt += Sort::NoDuplicates;
+  }
+  // Sort all data in memory.
+  Vector<uInt> expInx;
+  {
+    Sort sort;
+    sort.sortKey (ivec.data(), TpInt);
+    sort.sortKey (dvec.data(), TpDouble, 0, Sort::Descending);
+    sort.sortKey (svec.data(), TpString);
+    sort.sort (expInx, nr, opt);
+  }
+  // Sort in runs.
+  ExternalSort extSort(".");
+  extSort.sortKey (TpInt);
+  extSort.sortKey (TpDouble, Sort::Descending);
+  extSort.sortKey (TpString);
+  for (uInt st=0; st<nr; st+=runSize) {
+    uInt n = std::min (runSize, nr-st);
+    Vector<Int> iv (ivec(Slice(st,n)).copy());
+    Vector<Double> dv (dvec(Slice(st,n)).copy());
+    Vector<String> sv (svec(Slice(st,n)).copy());
+    Vector<uInt> rownrs(n);
+    indgen (rownrs, st);
+    Sort sort;
+    sort.sortKey (iv.data(), TpInt);
+    sort.sortKey (dv.data(), TpDouble, 0, Sort::Descending);
+    sort.sortKey (sv.data(), TpString);
+    Vector<uInt> index;
+    sort.sort (index, n, opt);
+    Block<const void*> data(3);
+    data[0] = iv.data();
+    data[1] = dv.data();
+    data[2] = sv.data();
+    extSort.addRun (data, index, rownrs);
+  }
+  AlwaysAssertExit (extSort.nrun() == (nr + runSize - 1) / runSize);
+  Vector<uInt> rows;
+  uInt nres = extSort.merge (rows, noDupl);
+  AlwaysAssertExit (nres == expInx.size());
+  AlwaysAssertExit (rows.size() == nres);
+  if (noDupl) {
+    // Which of the duplicates is kept can differ, so compare the keys.
+    for (uInt i=0; i<nres; ++i) {
+      AlwaysAssertExit (ivec[rows[i]] == ivec[expInx[i]]  &&
+                        dvec[rows[i]] == dvec[expInx[i]]  &&
+                        svec[rows[i]] == svec[expInx[i]]);
+    }
+  } else {
+    // The sort is stable, so the result must be exactly the same.
+    AlwaysAssertExit (allEQ (rows, expInx));
+  }
+}
+
+int main()
+{
+  try {
+    uInt nr = 10000;
+    Vector<Int> ivec(nr);
+    Vector<Double> dvec(nr);
+    Vector<String> svec(nr);
+    srand (12345);
+    for (uInt i=0; i<nr; ++i) {
+      ivec[i] = rand() % 10;
+      dvec[i] = (rand() % 20) * 0.5;
+      svec[i] = String::toString (rand() % 3);
+    }
+    check (ivec, dvec, svec, nr, False);
+    check (ivec, dvec, svec, 1000, False);
+    check (ivec, dvec, svec, 999, False);
+    check (ivec, dvec, svec, 1, False);
+    check (ivec, dvec, svec, 2000, True);
+    check (ivec, dvec, svec, 7, True);
+    // No runs at all.
+    ExternalSort extSort(".");
+    extSort.sortKey (TpInt);
+    Vector<uInt> rows;
+    AlwaysAssertExit (extSort.merge (rows) == 0);
+    // Keys cannot be added after a run.
+    Block<const void*> data(1, ivec.data());
+    Vector<uInt> index(1, 0u), rownrs(1, 0u);
+    extSort.addRun (data, index, rownrs);
+    Bool excp = False;
+    try {
+      extSort.sortKey (TpDouble);
+    } catch (std::exception&) {
+      excp = True;
+    }
+    AlwaysAssertExit (excp);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
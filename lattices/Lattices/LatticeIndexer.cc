@@ -209,9 +209,11 @@ Bool LatticeIndexer::tiledCursorMove (Bool incr, IPosition& cursorPos,
   //    axis is "active".  if the resulting cursor overflows the underlying
   //    lattice, then 1st axis becomes the activeAxis.  (this can go on
   //    until the cursor fits, or until all the axes are exhausted.)
-  // candidateCursorPos:
-  //    preliminary value for cursorPos += congruentCursorShape.
+  // candidatePos:
+  //    preliminary value for cursorPos(activeAxis) += cursorShape.
   //    this is the "base" or "bottomLeftCorner" of the new cursor.
+  //    cursorPos is only changed if the move succeeds, so no copy of it
+  //    is needed.
 
   DebugAssert (ok() == True, AipsError);
   AlwaysAssert (cursorPos.nelements() == itsNdim, AipsError);
@@ -222,36 +224,47 @@ Bool LatticeIndexer::tiledCursorMove (Bool incr, IPosition& cursorPos,
   }
   uInt activeAxis;
   uInt indexToActiveAxis = 0;
-  IPosition candidateCursorPos(cursorPos);
 
   while (indexToActiveAxis < itsNdim) {
     activeAxis = cursorHeading(indexToActiveAxis);
+    ssize_t candidatePos = cursorPos(activeAxis);
     if (incr) {
-      candidateCursorPos(activeAxis) += cursorShape(activeAxis);
+      candidatePos += cursorShape(activeAxis);
     } else {
-      candidateCursorPos(activeAxis) -= cursorShape(activeAxis);
+      candidatePos -= cursorShape(activeAxis);
     }
-    if ((candidateCursorPos(activeAxis) < itsShape(activeAxis))  &&
-	(candidateCursorPos(activeAxis) + cursorShape(activeAxis) > 0)) {
-      cursorPos = candidateCursorPos;
+    if ((candidatePos < itsShape(activeAxis))  &&
+	(candidatePos + cursorShape(activeAxis) > 0)) {
+      // Wrap the lower axes and move the active one.
+      for (uInt i=0; i<indexToActiveAxis; ++i) {
+        uInt axis = cursorHeading(i);
+        cursorPos(axis) = wrappedPos (incr, cursorPos(axis),
+                                      cursorShape(axis), itsShape(axis));
+      }
+      cursorPos(activeAxis) = candidatePos;
       return True;
     }
-    if (incr) {
-      candidateCursorPos(activeAxis) -= 
-	((candidateCursorPos(activeAxis) + cursorShape(activeAxis) - 1)
-	 / cursorShape(activeAxis))
-	* cursorShape(activeAxis);
-    } else {
-      candidateCursorPos(activeAxis) +=
-	((itsShape(activeAxis) - candidateCursorPos(activeAxis) - 1)
-	 / cursorShape(activeAxis))
-	* cursorShape(activeAxis);
-    }
     indexToActiveAxis++;
   } // while 
   return False;
 }
 
+// function which returns the position on an axis after the cursor moved
+// beyond the boundary and is wrapped to the first (or last) cursor position
+// within the boundary.
+ssize_t LatticeIndexer::wrappedPos (Bool incr, ssize_t pos, ssize_t step,
+                                    ssize_t length)
+{
+  if (incr) {
+    pos += step;
+    pos -= ((pos + step - 1) / step) * step;
+  } else {
+    pos -= step;
+    pos += ((length - pos - 1) / step) * step;
+  }
+  return pos;
+}
+
 // function which returns a value of True if the IPosition argument
 // is within the sub-Lattice.  Returns False if the IPosition argument is 
 // outside the sub-Lattice or if the argument doesn't conform to the 
@@ -228,6 +228,11 @@ public:
   Bool ok() const;
 
 private:
+  // Get the position on an axis after moving the cursor beyond the
+  // sub-Lattice and wrapping it to the other side.
+  static ssize_t wrappedPos (Bool incr, ssize_t pos, ssize_t step,
+                             ssize_t length);
+
   IPosition itsFullShape;  //# Size of the main-Lattice.
   uInt      itsNdim;       //# Number of dimensions in the main/sub-Lattice
   IPosition itsShape;      //# Shape of the sub-Lattice
@@ -148,12 +148,12 @@ Bool LatticeStepper::operator++(int)
   if (successful) {
     // test for hang over since cursor has moved.
     if (itsNiceFit == False) {
-      const IPosition curPos(itsCursorPos);
-      const IPosition curEndPos(itsCursorPos+itsCursorShape-1);
-      const IPosition latShape(itsIndexer.shape());
+      const IPosition& latShape = itsIndexer.shape();
       const uInt ndim = itsIndexer.ndim();
       uInt i = 0;
-      while (i < ndim  &&  curEndPos(i) < latShape(i)  &&  curPos(i) >= 0) {
+      while (i < ndim  &&
+             itsCursorPos(i) + itsCursorShape(i) - 1 < latShape(i)  &&
+             itsCursorPos(i) >= 0) {
 	i++;
       }
       itsHangover =  (i != ndim);
@@ -179,13 +179,12 @@ Bool LatticeStepper::operator--(int)
 						itsCursorShape, itsAxisPath);
   if (successful) {
     // test for hang over since cursor has moved
-    const IPosition curPos(itsCursorPos);
     const uInt ndim = itsIndexer.ndim();
     if (itsNiceFit == False) {
-      const IPosition curEndPos(itsCursorPos+itsCursorShape);
-      const IPosition latShape(itsIndexer.shape());
+      const IPosition& latShape = itsIndexer.shape();
       uInt i = 0;
-      while (i < ndim  &&  curPos(i) >= 0  &&  curEndPos(i) < latShape(i)) {
+      while (i < ndim  &&  itsCursorPos(i) >= 0  &&
+             itsCursorPos(i) + itsCursorShape(i) < latShape(i)) {
 	i++;
       }
       itsHangover =  (i != ndim);
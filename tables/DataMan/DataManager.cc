@@ -59,7 +59,7 @@ DataManager::DataManager()
 : nrcol_p       (0),
   seqnr_p       (0),
   asBigEndian_p (False),
-  tsmOption_p   (TSMOption::Buffer, 0, 0),
+  tsmOption_p   (TSMOption::Buffer, 0, 0, 0, 1),
   multiFile_p   (0),
   clone_p       (0)
 {
@@ -124,7 +124,8 @@ void DataManager::setMultiFile (MultiFileBase* mfile)
   multiFile_p = mfile;
   // Only caching can be used with a MultiFile.
   if (multiFile_p) {
-    tsmOption_p = TSMOption(TSMOption::Cache, 0, tsmOption_p.maxCacheSizeMB());
+    tsmOption_p = TSMOption(TSMOption::Cache, 0, tsmOption_p.maxCacheSizeMB(),
+                            tsmOption_p.prefetch(), tsmOption_p.nThread());
   }
 }
 
@@ -414,6 +415,19 @@ Bool DataManagerColumn::canAccessColumnSlice (Bool& reask) const
     return False;
 }
 
+const void* DataManagerColumn::getColumnViewV (uInt, uInt& nrrow)
+{
+    nrrow = 0;
+    return 0;
+}
+
+
+Bool DataManagerColumn::getZoneMap (Vector<uInt>&,
+                                    Vector<Double>&, Vector<Double>&)
+{
+    return False;
+}
+
 
 String DataManagerColumn::dataTypeId() const
     { return String(); }
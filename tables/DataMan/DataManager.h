@@ -53,6 +53,7 @@ class IPosition;
 class Slicer;
 class RefRows;
 template<class T> class Array;
+template<class T> class Vector;
 class AipsIO;
 
 
@@ -752,6 +753,27 @@ public:
     // By default reask is set to False.
     virtual Bool canAccessColumnSlice (Bool& reask) const;
 
+    // Get a direct readonly pointer to the data of the given row
+    // and the rows following it. The data must be in the local format
+    // of the data type. The number of rows the pointer can be used for
+    // is returned in <src>nrrow</src>. The data are only valid as long
+    // as the rows are not changed.
+    // <br>It can only be used for scalar and fixed shaped array columns.
+    // It returns a null pointer if direct access is not possible
+    // (e.g. because the data have to be converted).
+    // Default is a null pointer.
+    virtual const void* getColumnViewV (uInt rownr, uInt& nrrow);
+
+    // Get the zone map of a scalar column, i.e. the minimum and maximum
+    // value in consecutive blocks of rows. Block i ends at row
+    // <src>lastRow[i]</src> (block 0 starts at row 0). The minimum and
+    // maximum ignore NaN values. If the minimum and maximum of a block are
+    // not known, they are set to -DBL_MAX and DBL_MAX.
+    // <br>It returns False if no zone map is available for the column.
+    // Default is False.
+    virtual Bool getZoneMap (Vector<uInt>& lastRow,
+                             Vector<Double>& minVal, Vector<Double>& maxVal);
+
     // Get access to the ColumnCache object.
     // <group>
     ColumnCache& columnCache()
@@ -36,6 +36,7 @@
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/IO/AipsIO.h>
@@ -60,12 +61,14 @@ ISMBase::ISMBase (uInt bucketSize, Bool checkBucketSize, uInt cacheSize)
   index_p           (0),
   persCacheSize_p   (cacheSize),
   cacheSize_p       (0),
+  prefetch_p        (-1),
   nbucketInit_p     (1),
   nFreeBucket_p     (0),
   firstFree_p       (-1),
   bucketSize_p      (bucketSize),
   checkBucketSize_p (checkBucketSize),
   dataChanged_p     (False),
+  changeCount_p     (0),
   tempBuffer_p      (0)
 {}
 
@@ -81,12 +84,14 @@ ISMBase::ISMBase (const String& dataManagerName,
   index_p           (0),
   persCacheSize_p   (cacheSize),
   cacheSize_p       (0),
+  prefetch_p        (-1),
   nbucketInit_p     (1),
   nFreeBucket_p     (0),
   firstFree_p       (-1),
   bucketSize_p      (bucketSize),
   checkBucketSize_p (checkBucketSize),
   dataChanged_p     (False),
+  changeCount_p     (0),
   tempBuffer_p      (0)
 {}
 
@@ -101,12 +106,14 @@ ISMBase::ISMBase (const String& dataManagerName, const Record& spec)
   index_p           (0),
   persCacheSize_p   (1),
   cacheSize_p       (0),
+  prefetch_p        (-1),
   nbucketInit_p     (1),
   nFreeBucket_p     (0),
   firstFree_p       (-1),
   bucketSize_p      (32768),
   checkBucketSize_p (False),
   dataChanged_p     (False),
+  changeCount_p     (0),
   tempBuffer_p      (0)
 {
     if (spec.isDefined ("BUCKETSIZE")) {
@@ -131,12 +138,14 @@ ISMBase::ISMBase (const ISMBase& that)
   index_p           (0),
   persCacheSize_p   (that.persCacheSize_p),
   cacheSize_p       (that.cacheSize_p),
+  prefetch_p        (that.prefetch_p),
   nbucketInit_p     (1),
   nFreeBucket_p     (0),
   firstFree_p       (-1),
   bucketSize_p      (that.bucketSize_p),
   checkBucketSize_p (that.checkBucketSize_p),
   dataChanged_p     (False),
+  changeCount_p     (0),
   tempBuffer_p      (0)
 {}
 
@@ -274,6 +283,23 @@ void ISMBase::setCacheSize (uInt cacheSize, Bool canExceedNrBuckets)
     }
 }
 
+void ISMBase::setPrefetch (uInt nrBucket)
+{
+    prefetch_p = nrBucket;
+    if (cache_p != 0) {
+	cache_p->setPrefetch (nrBucket);
+    }
+}
+
+uInt ISMBase::prefetch() const
+{
+    // Use the TSMOption value if not set explicitly.
+    if (prefetch_p >= 0) {
+	return prefetch_p;
+    }
+    return max(0, tsmOption().prefetch());
+}
+
 void ISMBase::makeCache()
 {
     if (cache_p == 0) {
@@ -291,6 +317,7 @@ void ISMBase::makeCache()
 				   ISMBucket::deleteCallBack);
 	cache_p->resync (nbucketInit_p, nFreeBucket_p, firstFree_p);
 	AlwaysAssert (cache_p != 0, AipsError);
+	cache_p->setPrefetch (prefetch());
 	// Allocate a buffer for temporary storage by all ISM classes.
 	if (tempBuffer_p == 0) {
 	    tempBuffer_p = new char [bucketSize_p];
@@ -415,6 +442,12 @@ ISMBucket* ISMBase::nextBucket (uInt& cursor, uInt& bucketStartRow,
 				uInt& bucketNrrow)
 {
     uInt bucketNr;
+    return nextBucket (cursor, bucketStartRow, bucketNrrow, bucketNr);
+}
+
+ISMBucket* ISMBase::nextBucket (uInt& cursor, uInt& bucketStartRow,
+				uInt& bucketNrrow, uInt& bucketNr)
+{
     if (getIndex().nextBucketNr (cursor, bucketStartRow,
 				  bucketNrrow, bucketNr)) {
 	return (ISMBucket*) (getCache().getBucket (bucketNr));
@@ -422,10 +455,21 @@ ISMBucket* ISMBase::nextBucket (uInt& cursor, uInt& bucketStartRow,
     return 0;
 }
 
+ISMBucket* ISMBase::getBucketByNr (uInt bucketNr)
+{
+    return (ISMBucket*) (getCache().getBucket (bucketNr));
+}
+
+uInt ISMBase::nbuckets()
+{
+    return getIndex().nbuckets();
+}
+
 void ISMBase::setBucketDirty()
 {
     cache_p->setDirty();
     dataChanged_p = True;
+    changeCount_p++;
 }
 
 void ISMBase::addBucket (uInt rownr, ISMBucket* bucket)
@@ -434,6 +478,7 @@ void ISMBase::addBucket (uInt rownr, ISMBucket* bucket)
     // It's the last bucket in the cache.
     uInt bucketNr = getCache().addBucket ((char*)bucket);
     getIndex().addBucketNr (rownr, bucketNr);
+    changeCount_p++;
 }
 
 //# The storage manager can add rows.
@@ -467,6 +512,7 @@ void ISMBase::addRow (uInt nrrow)
     }
     nrrow_p += nrrow;
     dataChanged_p = True;
+    changeCount_p++;
 }
 
 void ISMBase::removeRow (uInt rownr)
@@ -484,6 +530,7 @@ void ISMBase::removeRow (uInt rownr)
     // Remove the row from the index.
     Int emptyBucket = getIndex().removeRow (rownr);
     nrrow_p--;
+    changeCount_p++;
     // When no more rows left, recreate index and cache.
     if (nrrow_p == 0) {
 	recreate();
@@ -592,6 +639,7 @@ Bool ISMBase::flush (AipsIO& ios, Bool fsync)
 void ISMBase::resync (uInt nrrow)
 {
     nrrow_p = nrrow;
+    changeCount_p++;
     if (index_p != 0) {
 	readIndex();
     }
@@ -146,6 +146,14 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Set the number of buckets to prefetch when the cache detects a
+    // sequential or strided access pattern (0 = no prefetching).
+    // By default the prefetch value given in the TSMOption is used.
+    void setPrefetch (uInt nrBucket);
+
+    // Get the number of buckets to prefetch.
+    uInt prefetch() const;
+
     // Clear the cache used by this storage manager.
     // It will flush the cache as needed and remove all buckets from it.
     void clearCache();
@@ -181,6 +189,17 @@ public:
     ISMBucket* nextBucket (uInt& cursor, uInt& bucketStartRow,
 			   uInt& bucketNrrow);
 
+    // Get the next bucket as above, but also return its bucket number.
+    ISMBucket* nextBucket (uInt& cursor, uInt& bucketStartRow,
+			   uInt& bucketNrrow, uInt& bucketNr);
+
+    // Get the bucket with the given bucket number.
+    // The bucket object is created and deleted by the caching mechanism.
+    ISMBucket* getBucketByNr (uInt bucketNr);
+
+    // Get the number of buckets in the index.
+    uInt nbuckets();
+
     // Get access to the temporary buffer.
     char* tempBuffer() const;
 
@@ -222,6 +241,10 @@ public:
     // (used by ISMColumn::putValue).
     void setBucketDirty();
 
+    // Get the number of changes made to the data or the bucket layout.
+    // It is used by ISMColumn to know if its interval index is still valid.
+    uInt changeCount() const;
+
     // Open (if needed) the file for indirect arrays with the given mode.
     // Return a pointer to the object.
     StManArrayFile* openArrayFile (ByteIO::OpenOption opt);
@@ -360,6 +383,8 @@ private:
     uInt persCacheSize_p;
     // The actual cache size.
     uInt cacheSize_p;
+    // The number of buckets to prefetch (-1 = use TSMOption).
+    Int prefetch_p;
     // The initial number of buckets in the cache.
     uInt nbucketInit_p;
     // The nr of free buckets.
@@ -372,6 +397,8 @@ private:
     Bool checkBucketSize_p;
     // Has the data changed since the last flush?
     Bool dataChanged_p;
+    // The number of changes (in data, rows, or buckets).
+    uInt changeCount_p;
     // The size of a uInt in external format (local or canonical).
     uInt uIntSize_p;
     // A temporary read/write buffer (also for other classes).
@@ -389,6 +416,11 @@ inline uInt ISMBase::cacheSize() const
     return cacheSize_p;
 }
 
+inline uInt ISMBase::changeCount() const
+{
+    return changeCount_p;
+}
+
 inline uInt ISMBase::uniqueNr()
 {
     return uniqnr_p++;
@@ -34,6 +34,7 @@
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Utilities/Copy.h>
+#include <casacore/casa/Utilities/BinarySearch.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
@@ -50,7 +51,10 @@ ISMColumn::ISMColumn (ISMBase* parent, int dataType, uInt colnr)
   startRow_p    (-1),
   endRow_p      (-1),
   lastValue_p   (0),
-  lastRowPut_p  (0)
+  lastRowPut_p  (0),
+  nrInterval_p  (0),
+  intValid_p    (False),
+  intChangeCount_p (0)
 {
     //# The increment in the column cache is always 0,
     //# because multiple rows refer to the same value.
@@ -383,6 +387,8 @@ void ISMColumn::aips_name2(getScalarColumnCells,NM) \
     T* value = values->getStorage (delV); \
     T* valptr = value; \
     const ColumnCache& cache = columnCache(); \
+    Bool useIndex = makeIntervalIndex (rownrs.nrow()); \
+    uInt inx = 0; \
     if (rownrs.isSliced()) { \
         RefRowsSliceIter iter(rownrs); \
         while (! iter.pastEnd()) { \
@@ -391,7 +397,11 @@ void ISMColumn::aips_name2(getScalarColumnCells,NM) \
             uInt incr = iter.sliceIncr(); \
             while (rownr <= end) { \
                 if (rownr < cache.start()  ||  rownr > cache.end()) { \
-                    aips_name2(get,NM) (rownr, valptr); \
+                    if (useIndex) { \
+                        getIndexedValue (rownr, inx); \
+                    } else { \
+                        aips_name2(get,NM) (rownr, valptr); \
+                    } \
                     DebugAssert (cache.incr() == 0, AipsError); \
                 } \
                 const T* cacheValue = (const T*)(cache.dataPtr()); \
@@ -410,7 +420,11 @@ void ISMColumn::aips_name2(getScalarColumnCells,NM) \
             Bool delR; \
             const uInt* rows = rowvec.getStorage (delR); \
             if (rows[0] < cache.start()  ||  rows[0] > cache.end()) { \
-                aips_name2(get,NM) (0, &(value[0])); \
+                if (useIndex) { \
+                    getIndexedValue (rows[0], inx); \
+                } else { \
+                    aips_name2(get,NM) (rows[0], &(value[0])); \
+                } \
             } \
             const T* cacheValue = (const T*)(cache.dataPtr()); \
             uInt strow = cache.start(); \
@@ -421,7 +435,12 @@ void ISMColumn::aips_name2(getScalarColumnCells,NM) \
                 if (rownr >= strow  &&  rownr <= endrow) { \
 	            value[i] = *cacheValue; \
 	        } else { \
-	            aips_name2(get,NM) (rownr, &(value[i])); \
+                    if (useIndex) { \
+                        getIndexedValue (rownr, inx); \
+                        value[i] = *(const T*)(cache.dataPtr()); \
+                    } else { \
+	                aips_name2(get,NM) (rownr, &(value[i])); \
+                    } \
                     cacheValue = (const T*)(cache.dataPtr()); \
                     strow = cache.start(); \
                     endrow = cache.end(); \
@@ -444,6 +463,70 @@ ISMCOLUMN_GET(Complex,ComplexV)
 ISMCOLUMN_GET(DComplex,DComplexV)
 ISMCOLUMN_GET(String,StringV)
 
+Bool ISMColumn::makeIntervalIndex (uInt nrrow)
+{
+    if (intValid_p  &&  intChangeCount_p == stmanPtr_p->changeCount()) {
+        return True;
+    }
+    intValid_p = False;
+    if (nrrow < 2  ||  nrrow < stmanPtr_p->nbuckets()) {
+        return False;
+    }
+    // Collect the intervals of this column in all buckets.
+    nrInterval_p = 0;
+    uInt cursor = 0;
+    uInt bucketStartRow = 0;
+    uInt bucketNrrow, bucketNr;
+    ISMBucket* bucket;
+    while ((bucket = stmanPtr_p->nextBucket (cursor, bucketStartRow,
+                                             bucketNrrow, bucketNr)) != 0) {
+        uInt nused = bucket->indexUsed (colnr_p);
+        const Block<uInt>& rowIndex = bucket->rowIndex (colnr_p);
+        const Block<uInt>& offIndex = bucket->offIndex (colnr_p);
+        if (nrInterval_p + nused >= intRows_p.nelements()) {
+            uInt newSize = max (2 * intRows_p.nelements(),
+                                nrInterval_p + nused + 1);
+            intRows_p.resize (newSize);
+            intBucket_p.resize (newSize);
+            intOffset_p.resize (newSize);
+        }
+        for (uInt i=0; i<nused; i++) {
+            intRows_p[nrInterval_p]   = bucketStartRow + rowIndex[i];
+            intBucket_p[nrInterval_p] = bucketNr;
+            intOffset_p[nrInterval_p] = offIndex[i];
+            nrInterval_p++;
+        }
+    }
+    intRows_p[nrInterval_p] = stmanPtr_p->nrow();
+    intChangeCount_p = stmanPtr_p->changeCount();
+    intValid_p = True;
+    return True;
+}
+
+void ISMColumn::getIndexedValue (uInt rownr, uInt& inx)
+{
+    if (inx >= nrInterval_p  ||  rownr < intRows_p[inx]
+    ||  rownr >= intRows_p[inx+1]) {
+        // For ascending row numbers it is usually the next interval.
+        if (inx+1 < nrInterval_p  &&  rownr >= intRows_p[inx+1]
+        &&  rownr < intRows_p[inx+2]) {
+            inx++;
+        } else {
+            Bool found;
+            inx = binarySearchBrackets (found, intRows_p, rownr,
+                                        nrInterval_p);
+            if (!found) {
+                inx--;
+            }
+        }
+    }
+    ISMBucket* bucket = stmanPtr_p->getBucketByNr (intBucket_p[inx]);
+    readFunc_p (lastValue_p, bucket->get (intOffset_p[inx]), nrcopy_p);
+    startRow_p = intRows_p[inx];
+    endRow_p   = intRows_p[inx+1] - 1;
+    columnCache().set (startRow_p, endRow_p, lastValue_p);
+}
+
 void ISMColumn::getValue (uInt rownr, void* value, Bool setCache)
 {
     // Get the bucket with its row number boundaries.
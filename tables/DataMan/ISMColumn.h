@@ -317,6 +317,19 @@ protected:
     // Put the value for this row.
     void putValue (uInt rownr, const void* value);
 
+    // Make the interval index (if not made yet or if the data have changed).
+    // It is only made if at least as many rows are accessed as there are
+    // buckets, otherwise looking up each row is cheaper than reading all
+    // buckets. It returns False if the interval index cannot be used.
+    Bool makeIntervalIndex (uInt nrrow);
+
+    // Get the value for this row using the interval index and set the
+    // last value and the column cache.
+    // <src>inx</src> is the index of the interval found in the previous call.
+    // It is updated, so for ascending row numbers the next interval is
+    // found directly instead of searching.
+    void getIndexedValue (uInt rownr, uInt& inx);
+
     //# Declare member variables.
     // Pointer to the parent storage manager.
     ISMBase*          stmanPtr_p;
@@ -348,6 +361,16 @@ protected:
     Conversion::ValueFunction* readFunc_p;
     // Pointer to a compare function.
     ObjCompareFunc*   compareFunc_p;
+    // The interval index containing for each interval of equal values
+    // (in all buckets) its start row, bucket number and data offset.
+    // <src>intRows_p</src> has an extra entry containing the number of rows.
+    Block<uInt>       intRows_p;
+    Block<uInt>       intBucket_p;
+    Block<uInt>       intOffset_p;
+    uInt              nrInterval_p;
+    // Is the interval index valid for the change count of the stman?
+    Bool              intValid_p;
+    uInt              intChangeCount_p;
 
 
 private:
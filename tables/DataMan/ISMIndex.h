@@ -127,6 +127,10 @@ public:
     // Show the index.
     void show (std::ostream&) const;
 
+    // Get the number of buckets in the index.
+    uInt nbuckets() const
+        { return nused_p; }
+
 private:
     // Forbid copy constructor.
     ISMIndex (const ISMIndex&);
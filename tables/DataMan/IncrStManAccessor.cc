@@ -77,6 +77,15 @@ uInt ROIncrementalStManAccessor::cacheSize() const
     return dataManPtr_p->cacheSize();
 }
 
+void ROIncrementalStManAccessor::setPrefetch (uInt nrBucket)
+{
+    dataManPtr_p->setPrefetch (nrBucket);
+}
+uInt ROIncrementalStManAccessor::prefetch() const
+{
+    return dataManPtr_p->prefetch();
+}
+
 void ROIncrementalStManAccessor::clearCache()
 {
     dataManPtr_p->clearCache();
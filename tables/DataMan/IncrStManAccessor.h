@@ -132,6 +132,14 @@ public:
     // Get the cache size (in buckets).
     uInt cacheSize() const;
 
+    // Set the number of buckets to prefetch when a sequential or strided
+    // access pattern is detected. 0 means no prefetching.
+    // Like the cache size, it is not persistent.
+    void setPrefetch (uInt nrBucket);
+
+    // Get the number of buckets to prefetch.
+    uInt prefetch() const;
+
     // Clear the caches used by the hypercubes in this storage manager.
     // It will flush the caches as needed and remove all buckets from them
     // resulting in a possibly large drop in memory used.
@@ -45,16 +45,19 @@
 #include <casacore/casa/IO/CanonicalIO.h>
 #include <casacore/casa/IO/LECanonicalIO.h>
 #include <casacore/casa/IO/FilebufIO.h>
+#include <casacore/casa/IO/MMapIO.h>
+#include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/DOos.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/casa/iostream.h>
+#include <float.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
+SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize, Bool aZoneMaps)
 : DataManager          (),
   itsDataManName       ("SSM"),
   itsIosFile           (0),
@@ -64,6 +67,8 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsStringHandler     (0),
   itsPersCacheSize     (max(aCacheSize,2u)),
   itsCacheSize         (0),
+  itsPrefetch          (-1),
+  itsNThread           (-1),
   itsNrBuckets         (0), 
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -74,7 +79,9 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (aZoneMaps),
+  itsZoneBucket        (-1)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -86,7 +93,7 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
 }
 
 SSMBase::SSMBase (const String& aDataManName,
-		  Int aBucketSize, uInt aCacheSize)
+		  Int aBucketSize, uInt aCacheSize, Bool aZoneMaps)
 : DataManager          (),
   itsDataManName       (aDataManName),
   itsIosFile           (0),
@@ -96,6 +103,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsStringHandler     (0),
   itsPersCacheSize     (max(aCacheSize,2u)),
   itsCacheSize         (0),
+  itsPrefetch          (-1),
+  itsNThread           (-1),
   itsNrBuckets         (0), 
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -106,7 +115,9 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (aZoneMaps),
+  itsZoneBucket        (-1)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -128,6 +139,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsStringHandler     (0),
   itsPersCacheSize     (2),
   itsCacheSize         (0),
+  itsPrefetch          (-1),
+  itsNThread           (-1),
   itsNrBuckets         (0), 
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -138,7 +151,9 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False),
+  itsZoneBucket        (-1)
 { 
   // Get bucketrows if defined.
   if (spec.isDefined ("BUCKETROWS")) {
@@ -157,6 +172,9 @@ SSMBase::SSMBase (const String& aDataManName,
   if (spec.isDefined ("PERSCACHESIZE")) {
     itsPersCacheSize = max(2, spec.asInt ("PERSCACHESIZE"));
   }
+  if (spec.isDefined ("ZONEMAPS")) {
+    itsZoneMaps = spec.asBool ("ZONEMAPS");
+  }
 }
 
 SSMBase::SSMBase (const SSMBase& that)
@@ -169,6 +187,8 @@ SSMBase::SSMBase (const SSMBase& that)
   itsStringHandler     (0),
   itsPersCacheSize     (that.itsPersCacheSize),
   itsCacheSize         (0),
+  itsPrefetch          (-1),
+  itsNThread           (-1),
   itsNrBuckets         (0),
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -179,7 +199,9 @@ SSMBase::SSMBase (const SSMBase& that)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (that.itsBucketSize),
   itsBucketRows        (that.itsBucketRows),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (that.itsZoneMaps),
+  itsZoneBucket        (-1)
 {}
 
 SSMBase::~SSMBase()
@@ -194,6 +216,9 @@ SSMBase::~SSMBase()
   delete itsFile;
   delete itsIosFile;
   delete itsStringHandler;
+  for (uInt i=0; i<itsMappedFiles.nelements(); i++) {
+    delete itsMappedFiles[i];
+  }
 }
 
 DataManager* SSMBase::clone() const
@@ -216,6 +241,7 @@ Record SSMBase::dataManagerSpec() const
   Record rec = getProperties();
   rec.define ("BUCKETSIZE", Int(itsBucketSize));
   rec.define ("PERSCACHESIZE", Int(itsPersCacheSize));
+  rec.define ("ZONEMAPS", itsZoneMaps);
   rec.define ("IndexLength", Int(itsIndexLength));
   return rec;
 }
@@ -295,6 +321,7 @@ DataManagerColumn* SSMBase::makeScalarColumn (const String&,
     itsPtrColumn.resize (itsPtrColumn.nelements() + 32);
   }
   SSMColumn* aColumn = new SSMColumn (this, aDataType, ncolumn());
+  aColumn->setScalar();
   itsPtrColumn[ncolumn()] = aColumn;
   return aColumn;
 }
@@ -349,6 +376,37 @@ void SSMBase::setCacheSize (uInt aCacheSize, Bool canExceedNrBuckets)
   }
 }
 
+void SSMBase::setPrefetch (uInt aNrBucket)
+{
+  itsPrefetch = aNrBucket;
+  if (itsCache != 0) {
+    itsCache->setPrefetch (aNrBucket);
+  }
+}
+
+uInt SSMBase::getPrefetch() const
+{
+  // Use the TSMOption value if not set explicitly.
+  if (itsPrefetch >= 0) {
+    return itsPrefetch;
+  }
+  return max(0, tsmOption().prefetch());
+}
+
+void SSMBase::setNThread (uInt aNThread)
+{
+  itsNThread = aNThread;
+}
+
+uInt SSMBase::getNThread() const
+{
+  // Use the TSMOption value if not set explicitly.
+  if (itsNThread >= 0) {
+    return max(1, itsNThread);
+  }
+  return max(1, tsmOption().nThread());
+}
+
 void SSMBase::makeCache()
 {
   if (itsCache == 0) {
@@ -373,6 +431,7 @@ void SSMBase::makeCache()
 				SSMBase::deleteCallBack);
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
+    itsCache->setPrefetch (getPrefetch());
 
     if (forceFill) {
       readIndexBuckets();
@@ -504,6 +563,12 @@ void SSMBase::readIndexBuckets()
     itsPtrIndex[i] = new SSMIndex(this);
     itsPtrIndex[i]->get(anMOs);
   }
+  // Zone maps are stored after the indices (if kept).
+  itsZoneMaps = (aMemBuf.seek (Int64(0), ByteIO::Current) <
+                 Int64(itsIndexLength));
+  if (itsZoneMaps) {
+    getZoneMaps (anMOs);
+  }
   
   anMOs.close();
   delete aMio;
@@ -535,6 +600,9 @@ void SSMBase::writeIndex()
   for (uInt i=0;i<aNrIdx; i++ ){
     itsPtrIndex[i]->put(anMOs);
   }
+  if (itsZoneMaps) {
+    putZoneMaps (anMOs);
+  }
   anMOs.close();
 
   // Write total Mio in buckets.
@@ -645,8 +713,135 @@ void SSMBase::writeIndex()
   itsFile->fsync();
 }
 
+void SSMBase::setZoneDirty (SSMIndex* anIndex, uInt aStartRow)
+{
+  uInt aBucketNr, aStartBucketRow, anEndRow;
+  for (uInt aRowNr=aStartRow; aRowNr<itsNrRows; aRowNr=anEndRow+1) {
+    anIndex->find (aRowNr, aBucketNr, aStartBucketRow, anEndRow);
+    itsZoneDirty.insert (aBucketNr);
+  }
+}
+
+void SSMBase::updateZones()
+{
+  if (! itsZoneDirty.empty()) {
+    for (uInt i=0; i<itsPtrIndex.nelements(); i++) {
+      // Get the columns in this index keeping a zone map.
+      Block<SSMColumn*> aColumns(ncolumn());
+      uInt aNrCol = 0;
+      for (uInt j=0; j<ncolumn(); j++) {
+        if (itsColIndexMap[j] == i  &&  itsPtrColumn[j]->canZoneMap()) {
+          aColumns[aNrCol++] = itsPtrColumn[j];
+        }
+      }
+      if (aNrCol > 0) {
+        Vector<uInt> aBuckets  = itsPtrIndex[i]->getBuckets();
+        Vector<uInt> aLastRows = itsPtrIndex[i]->getLastRows();
+        uInt aStartRow = 0;
+        for (uInt j=0; j<aBuckets.nelements(); j++) {
+          if (itsZoneDirty.find(aBuckets[j]) != itsZoneDirty.end()) {
+            for (uInt k=0; k<aNrCol; k++) {
+              aColumns[k]->calcZone (aBuckets[j], aStartRow, aLastRows[j]);
+            }
+          }
+          aStartRow = aLastRows[j] + 1;
+        }
+      }
+    }
+    itsZoneDirty.clear();
+  }
+  // Reading the data to calculate the zones does not change them.
+  itsZoneBucket = -1;
+}
+
+void SSMBase::putZoneMaps (AipsIO& anOs)
+{
+  // Only write the known zones of the data buckets in use.
+  anOs.putstart ("SSMZoneMap", 1);
+  uInt aNrCol = 0;
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->canZoneMap()) {
+      aNrCol++;
+    }
+  }
+  anOs << aNrCol;
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->canZoneMap()) {
+      Vector<uInt> aBuckets = itsPtrIndex[itsColIndexMap[i]]->getBuckets();
+      Block<uInt>   aKnown(aBuckets.nelements());
+      Block<Double> aMin(aBuckets.nelements());
+      Block<Double> aMax(aBuckets.nelements());
+      uInt aNr = 0;
+      for (uInt j=0; j<aBuckets.nelements(); j++) {
+        if (itsZoneDirty.find(aBuckets[j]) == itsZoneDirty.end()  &&
+            itsPtrColumn[i]->getZone (aBuckets[j], aMin[aNr], aMax[aNr])) {
+          aKnown[aNr++] = aBuckets[j];
+        }
+      }
+      anOs << i;
+      putBlock (anOs, aKnown, aNr);
+      putBlock (anOs, aMin, aNr);
+      putBlock (anOs, aMax, aNr);
+    }
+  }
+  anOs.putend();
+}
+
+void SSMBase::getZoneMaps (AipsIO& anOs)
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    itsPtrColumn[i]->clearZones();
+  }
+  itsZoneDirty.clear();
+  anOs.getstart ("SSMZoneMap");
+  uInt aNrCol;
+  anOs >> aNrCol;
+  for (uInt i=0; i<aNrCol; i++) {
+    uInt aColNr;
+    Block<uInt>   aBuckets;
+    Block<Double> aMin, aMax;
+    anOs >> aColNr;
+    getBlock (anOs, aBuckets);
+    getBlock (anOs, aMin);
+    getBlock (anOs, aMax);
+    if (aColNr < ncolumn()  &&  itsPtrColumn[aColNr]->canZoneMap()) {
+      for (uInt j=0; j<aBuckets.nelements(); j++) {
+        itsPtrColumn[aColNr]->setZone (aBuckets[j], aMin[j], aMax[j]);
+      }
+    }
+  }
+  anOs.getend();
+}
+
+Bool SSMBase::getZoneMap (uInt aColNr, Vector<uInt>& aLastRow,
+                          Vector<Double>& aMinVal, Vector<Double>& aMaxVal)
+{
+  // Make sure the index (and zone maps) have been read.
+  getCache();
+  if (!itsZoneMaps  ||  !itsPtrColumn[aColNr]->canZoneMap()) {
+    return False;
+  }
+  SSMIndex* anIndexPtr = itsPtrIndex[itsColIndexMap[aColNr]];
+  Vector<uInt> aBuckets = anIndexPtr->getBuckets();
+  aLastRow.reference (anIndexPtr->getLastRows());
+  aMinVal.resize (aBuckets.nelements());
+  aMaxVal.resize (aBuckets.nelements());
+  for (uInt i=0; i<aBuckets.nelements(); i++) {
+    if (itsZoneDirty.find(aBuckets[i]) != itsZoneDirty.end()  ||
+        !itsPtrColumn[aColNr]->getZone (aBuckets[i], aMinVal[i], aMaxVal[i])) {
+      aMinVal[i] = -DBL_MAX;
+      aMaxVal[i] = DBL_MAX;
+    }
+  }
+  return True;
+}
+
 void SSMBase::setBucketDirty()
 {
+  if (itsZoneMaps  &&  itsZoneBucket >= 0) {
+    itsZoneDirty.insert (itsZoneBucket);
+    itsZoneBucket = -1;
+  }
   itsCache->setDirty();
   isDataChanged = True;
 }
@@ -689,7 +884,14 @@ void SSMBase::addRow (uInt aNrRows)
     itsPtrColumn[j]->addRow(itsNrRows+aNrRows,itsNrRows,False);
   }
 
+  uInt anOldNrRows = itsNrRows;
   itsNrRows+=aNrRows;
+  // The zones of the buckets getting the new rows have to be recalculated.
+  if (itsZoneMaps) {
+    for (uInt i=0; i< aNrIdx; i++) {
+      setZoneDirty (itsPtrIndex[i], anOldNrRows);
+    }
+  }
   isDataChanged = True;
 }
 
@@ -797,6 +999,9 @@ void SSMBase::addColumn (DataManagerColumn* aColumn)
     uInt aSize =(rowsPerBucket*aSSMC->getExternalSizeBits() + 7) / 8;
     itsPtrIndex[nrIdx]->setNrColumns(1,aSize);
     itsPtrIndex[nrIdx]->addRow(itsNrRows);
+    if (itsZoneMaps) {
+      setZoneDirty (itsPtrIndex[nrIdx], 0);
+    }
 
     itsColIndexMap[nCol]=nrIdx;
     itsColumnOffset[nCol]=0;                            
@@ -913,6 +1118,32 @@ char* SSMBase::find(uInt aRowNr,     uInt aColNr,
   uInt aBucketNr;
   anIndexPtr->find(aRowNr,aBucketNr,aStartRow,anEndRow);
   char* aPtr = getBucket(aBucketNr);
+  itsZoneBucket = aBucketNr;
+  return aPtr + itsColumnOffset[aColNr];
+}
+
+const char* SSMBase::findMapped (uInt aRowNr,     uInt aColNr,
+                                 uInt& aStartRow, uInt& anEndRow)
+{
+  if (multiFile() != 0) {
+    return 0;
+  }
+  // Make sure that cache is available and the file is up-to-date.
+  getCache().flush();
+  SSMIndex* anIndexPtr = itsPtrIndex[itsColIndexMap[aColNr]];
+  uInt aBucketNr;
+  anIndexPtr->find(aRowNr,aBucketNr,aStartRow,anEndRow);
+  // The buckets start after the 512 bytes header.
+  Int64 anOffset = 512 + Int64(aBucketNr) * itsBucketSize;
+  uInt aNrMap = itsMappedFiles.nelements();
+  if (aNrMap == 0
+  ||  anOffset + itsBucketSize > itsMappedFiles[aNrMap-1]->getFileSize()) {
+    itsMappedFiles.resize (aNrMap+1);
+    itsMappedFiles[aNrMap] = new MMapIO (RegularFile(fileName()));
+    aNrMap++;
+  }
+  const char* aPtr = static_cast<const char*>
+    (itsMappedFiles[aNrMap-1]->getReadPointer (anOffset));
   return aPtr + itsColumnOffset[aColNr];
 }
 
@@ -959,6 +1190,10 @@ Bool SSMBase::flush (AipsIO& ios, Bool doFsync)
   //# Check if anything has changed.
   Bool changed = False;
 
+  if (itsZoneMaps) {
+    updateZones();
+  }
+
   if (itsStringHandler) {
     itsStringHandler->flush();
   }
@@ -33,12 +33,14 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Containers/Block.h>
+#include <set>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward declarations
 class BucketCache;
 class BucketFile;
+class MMapIO;
 class StManArrayFile;
 class SSMIndex;
 class SSMColumn;
@@ -134,6 +136,15 @@ class SSMStringHandler;
 // always an index availanle in case the system crashes.
 // If possible 2 halfs of a single bucket are used alternately, otherwise 
 // separate buckets are used.
+// <p>
+// Optionally zone maps are kept for the numeric scalar columns. A zone map
+// contains the minimum and maximum value of a column in each data bucket.
+// It can be used to skip buckets when selecting on a range of values
+// (see <linkto class=TableExprPlanner>TableExprPlanner</linkto>).
+// A zone is recalculated when the table is flushed if data in its bucket
+// have been changed. The zone maps are stored after the SSMIndex data in
+// the index buckets. Older software does not read them and writes the
+// index without them, so a zone map can never be out of date.
 // </synopsis>
 
 // <motivation>
@@ -159,16 +170,20 @@ class SSMBase: public DataManager
 {
 public:
   // Create a Standard storage manager with default name SSM.
+  // Zone maps are kept if <src>aZoneMaps=True</src>.
   explicit SSMBase (Int aBucketSize=0,
-		    uInt aCacheSize=1);
+		    uInt aCacheSize=1,
+		    Bool aZoneMaps=False);
   
   // Create a Standard storage manager with the given name.
   explicit SSMBase (const String& aDataManName,
 		    Int aBucketSize=0,
-		    uInt aCacheSize=1);
+		    uInt aCacheSize=1,
+		    Bool aZoneMaps=False);
   
   // Create a Standard storage manager with the given name.
   // The specifications are part of the record (as created by dataManagerSpec).
+  // Field ZONEMAPS tells if zone maps have to be kept.
   SSMBase (const String& aDataManName,
 	   const Record& spec);
   
@@ -211,6 +226,23 @@ public:
 
   // Get the current cache size (in buckets).
   uInt getCacheSize() const;
+
+  // Set the number of buckets to prefetch when the cache detects a
+  // sequential or strided access pattern (0 = no prefetching).
+  // By default the prefetch value given in the TSMOption is used.
+  void setPrefetch (uInt aNrBucket);
+
+  // Get the number of buckets to prefetch.
+  uInt getPrefetch() const;
+
+  // Set the number of threads to use when reading a range of rows
+  // of a column (see <src>SSMColumn::getScalarColumnCellsV</src>).
+  // It has only effect if compiled with OpenMP.
+  // By default the number of threads given in the TSMOption is used.
+  void setNThread (uInt aNThread);
+
+  // Get the number of threads to use.
+  uInt getNThread() const;
   
   // Clear the cache used by this storage manager.
   // It will flush the cache as needed and remove all buckets from it.
@@ -227,6 +259,14 @@ public:
 
   // Get the bucket size.
   uInt getBucketSize() const;
+
+  // Are zone maps kept for the numeric scalar columns?
+  Bool hasZoneMaps() const;
+
+  // Get the zone map of the given column (see SSMColumn::getZoneMap).
+  // It returns False if no zone map is kept for the column.
+  Bool getZoneMap (uInt aColNr, Vector<uInt>& aLastRow,
+                   Vector<Double>& aMinVal, Vector<Double>& aMaxVal);
   
   // Get the number of rows in this storage manager.
   uInt getNRow() const;
@@ -258,6 +298,8 @@ public:
   // Make the current bucket in the cache dirty (i.e. something has been
   // changed in it and it needs to be written when removed from the cache).
   // (used by SSMColumn::putValue).
+  // If zone maps are kept, the zones of the bucket last found with
+  // <src>find</src> are marked as changed.
   void setBucketDirty();
   
   // Open (if needed) the file for indirect arrays with the given mode.
@@ -270,6 +312,16 @@ public:
   char* find (uInt aRowNr,     uInt aColNr, 
 	      uInt& aStartRow, uInt& anEndRow);
 
+  // Find the bucket containing the column and row and return the pointer
+  // to the beginning of the column data in that bucket in the memory-mapped
+  // file. Changed buckets are written first, so the mapped data are
+  // up-to-date. The file is mapped readonly, thus the data cannot be changed.
+  // It returns 0 if the file cannot be mapped (i.e. if MultiFile is used).
+  // The pointer stays valid until the storage manager is destructed,
+  // but the data are only valid as long as the rows are not changed.
+  const char* findMapped (uInt aRowNr,     uInt aColNr,
+                          uInt& aStartRow, uInt& anEndRow);
+
   // Add a new bucket and get its bucket number.
   uInt getNewBucket();
 
@@ -390,6 +442,19 @@ private:
   // Write the header and the indices.
   void writeIndex();
 
+  // Mark the zones of the buckets containing the rows from
+  // <src>aStartRow</src> till <src>itsNrRows</src> as changed.
+  void setZoneDirty (SSMIndex* anIndex, uInt aStartRow);
+
+  // Recalculate the zones of the buckets that have been changed.
+  void updateZones();
+
+  // Write the zone maps after the indices.
+  void putZoneMaps (AipsIO& anOs);
+
+  // Read the zone maps (if present) after the indices.
+  void getZoneMaps (AipsIO& anOs);
+
 
   //# Declare member variables.
   // Name of data manager.
@@ -415,6 +480,11 @@ private:
   
   // The file containing all data.
   BucketFile*  itsFile;
+
+  // The memory-mapped data file (used by findMapped).
+  // A new one is added if the file has grown; the old mappings are kept,
+  // so pointers given out remain valid.
+  PtrBlock<MMapIO*> itsMappedFiles;
   
   // String handler class
   SSMStringHandler* itsStringHandler;
@@ -424,6 +494,12 @@ private:
   
   // The actual cache size.
   uInt itsCacheSize;
+
+  // The number of buckets to prefetch (-1 = use TSMOption).
+  Int itsPrefetch;
+
+  // The number of threads for reading row ranges (-1 = use TSMOption).
+  Int itsNThread;
   
   // The initial number of buckets in the cache.
   uInt itsNrBuckets;
@@ -459,6 +535,15 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // Are zone maps kept?
+  Bool itsZoneMaps;
+
+  // The bucket last found by function find (-1 is none).
+  Int itsZoneBucket;
+
+  // The data buckets whose zones have to be recalculated.
+  std::set<uInt> itsZoneDirty;
 };
 
 
@@ -477,6 +562,11 @@ inline uInt SSMBase::getNRow() const
   return itsNrRows;
 }
 
+inline Bool SSMBase::hasZoneMaps() const
+{
+  return itsZoneMaps;
+}
+
 inline uInt SSMBase::getBucketSize() const
 {
   return itsBucketSize;
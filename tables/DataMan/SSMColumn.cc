@@ -31,12 +31,16 @@
 #include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <algorithm>
+#include <float.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -50,7 +54,8 @@ SSMColumn::SSMColumn (SSMBase* aParent, int aDataType, uInt aColNr)
   itsMaxLen      (0),
   itsNrElem      (1),
   itsNrCopy      (0),
-  itsData        (0)
+  itsData        (0),
+  itsIsScalar    (False)
 {
   init();
 }
@@ -560,21 +565,312 @@ void SSMColumn::getScalarColumnStringV (Vector<String>* aDataPtr)
 
 void SSMColumn::getColumnValue(void* anArray,uInt aNrRows)
 {
-  char* aDataPtr = static_cast<char*>(anArray);
-  uInt aRowNr=0;
-  Int rowsToDo = aNrRows;
-  
-  while (rowsToDo > 0) {
-    uInt  aStartRow;
-    uInt  anEndRow;
-    char* aValue;
-    aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow);
-    aRowNr = anEndRow+1;
-    uInt aNr = anEndRow-aStartRow+1;
-    rowsToDo -= aNr;
-    itsReadFunc (aDataPtr, aValue, aNr * itsNrCopy);
-    aDataPtr += aNr * itsLocalSize;
+  getRowRange (0, aNrRows, static_cast<char*>(anArray));
+}
+
+void SSMColumn::getScalarColumnCellsV (const RefRows& aRowNrs,
+                                       void* aDataPtr)
+{
+  if (! getCellsValue (aRowNrs, aDataPtr)) {
+    StManColumn::getScalarColumnCellsV (aRowNrs, aDataPtr);
+  }
+}
+
+uInt SSMColumn::localRowSize() const
+{
+  // Bools have a local size of 1 (not multiplied by nrelem).
+  if (dataType() == TpBool) {
+    return itsNrCopy;
+  }
+  return itsLocalSize;
+}
+
+void SSMColumn::readValues (char* aTo, const char* aBucketData,
+                            uInt anOffset, uInt aNrRows) const
+{
+  if (dataType() == TpBool) {
+    // Bools are stored as bits, so a row can start in the middle of a byte.
+    uInt aBitOff = anOffset * itsNrCopy;
+    Conversion::bitToBool (aTo, aBucketData + aBitOff/8, aBitOff%8,
+                           aNrRows * itsNrCopy);
+  } else {
+    itsReadFunc (aTo, aBucketData + anOffset*itsExternalSizeBytes,
+                 aNrRows * itsNrCopy);
+  }
+}
+
+void SSMColumn::getRowRange (uInt aRowNr, uInt aNrRows, char* aTo)
+{
+  uInt aRowSize = localRowSize();
+  uInt  aStartRow;
+  uInt  anEndRow;
+#ifdef _OPENMP
+  uInt aNThread = itsSSMPtr->getNThread();
+  // Find all buckets in the mapped file. Thereafter they can be
+  // converted in parallel, because the mapped data stay valid
+  // (as opposed to the data in the cache).
+  if (aNThread > 1  &&  aNrRows > 0) {
+    const char* aValue = itsSSMPtr->findMapped (aRowNr, itsColNr,
+                                                aStartRow, anEndRow);
+    if (aValue != 0) {
+      Block<const char*> aData;
+      Block<uInt> aFirst;
+      Block<uInt> anOffset;
+      uInt aNrBucket = 0;
+      uInt aRow = aRowNr;
+      while (True) {
+        if (aNrBucket == aData.nelements()) {
+          uInt aNewSize = 2*aNrBucket + 1;
+          aData.resize (aNewSize);
+          aFirst.resize (aNewSize);
+          anOffset.resize (aNewSize);
+        }
+        aData[aNrBucket]    = aValue;
+        aFirst[aNrBucket]   = aRow;
+        anOffset[aNrBucket] = aRow - aStartRow;
+        aNrBucket++;
+        aRow = anEndRow + 1;
+        if (aRow >= aRowNr + aNrRows) {
+          break;
+        }
+        aValue = itsSSMPtr->findMapped (aRow, itsColNr, aStartRow, anEndRow);
+      }
+      Int aNr = aNrBucket;
+#pragma omp parallel for num_threads(aNThread) schedule(dynamic)
+      for (Int i=0; i<aNr; i++) {
+        uInt anEnd = (i+1 < aNr  ?  aFirst[i+1] : aRowNr + aNrRows);
+        readValues (aTo + size_t(aFirst[i] - aRowNr) * aRowSize,
+                    aData[i], anOffset[i], anEnd - aFirst[i]);
+      }
+      return;
+    }
+  }
+#endif
+  while (aNrRows > 0) {
+    const char* aValue = itsSSMPtr->find (aRowNr, itsColNr,
+                                          aStartRow, anEndRow);
+    uInt aNr = std::min (anEndRow - aRowNr + 1, aNrRows);
+    readValues (aTo, aValue, aRowNr - aStartRow, aNr);
+    aTo      += size_t(aNr) * aRowSize;
+    aRowNr   += aNr;
+    aNrRows  -= aNr;
+  }
+}
+
+const ArrayBase* SSMColumn::getArrayBase (const RefRows& aRowNrs,
+                                          const void* aDataPtr) const
+{
+  // Only ranges with increment 1 of fixed size values can be handled.
+  DataType aDT = static_cast<DataType>(dataType());
+  if (!aRowNrs.isSliced()  ||  aDT == TpString) {
+    return 0;
+  }
+  RefRowsSliceIter anIter(aRowNrs);
+  while (! anIter.pastEnd()) {
+    if (anIter.sliceIncr() != 1) {
+      return 0;
+    }
+    anIter.next();
+  }
+  // A Vector (used for scalars) is an Array as well.
+  switch (aDT) {
+  case TpBool:
+    return static_cast<const Array<Bool>*>(aDataPtr);
+  case TpUChar:
+    return static_cast<const Array<uChar>*>(aDataPtr);
+  case TpShort:
+    return static_cast<const Array<Short>*>(aDataPtr);
+  case TpUShort:
+    return static_cast<const Array<uShort>*>(aDataPtr);
+  case TpInt:
+    return static_cast<const Array<Int>*>(aDataPtr);
+  case TpUInt:
+    return static_cast<const Array<uInt>*>(aDataPtr);
+  case TpFloat:
+    return static_cast<const Array<float>*>(aDataPtr);
+  case TpDouble:
+    return static_cast<const Array<double>*>(aDataPtr);
+  case TpComplex:
+    return static_cast<const Array<Complex>*>(aDataPtr);
+  case TpDComplex:
+    return static_cast<const Array<DComplex>*>(aDataPtr);
+  default:
+    break;
+  }
+  return 0;
+}
+
+// Get the minimum and maximum of the values. NaNs are ignored, because
+// each comparison with a NaN is False.
+template<typename T>
+void SSMColumn_minMax (const char* aData, uInt aNrRows,
+                       Double& aMin, Double& aMax)
+{
+  const T* aValues = reinterpret_cast<const T*>(aData);
+  aMin = DBL_MAX;
+  aMax = -DBL_MAX;
+  for (uInt i=0; i<aNrRows; i++) {
+    Double aValue = aValues[i];
+    if (aValue < aMin) aMin = aValue;
+    if (aValue > aMax) aMax = aValue;
+  }
+}
+
+Bool SSMColumn::canZoneMap() const
+{
+  if (itsIsScalar) {
+    switch (dataType()) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpFloat:
+    case TpDouble:
+      return True;
+    default:
+      break;
+    }
+  }
+  return False;
+}
+
+void SSMColumn::calcZone (uInt aBucketNr, uInt aStartRow, uInt anEndRow)
+{
+  // The rows are in a single bucket, so they can be read at once.
+  uInt aNrRows = anEndRow - aStartRow + 1;
+  Block<char> aBuf(size_t(aNrRows) * itsLocalSize);
+  uInt aSRow, anERow;
+  const char* aValue = itsSSMPtr->find (aStartRow, itsColNr, aSRow, anERow);
+  DebugAssert (aSRow == aStartRow  &&  anERow == anEndRow, AipsError);
+  readValues (aBuf.storage(), aValue, 0, aNrRows);
+  Double aMin, aMax;
+  switch (dataType()) {
+  case TpUChar:
+    SSMColumn_minMax<uChar> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  case TpShort:
+    SSMColumn_minMax<Short> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  case TpUShort:
+    SSMColumn_minMax<uShort> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  case TpInt:
+    SSMColumn_minMax<Int> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  case TpUInt:
+    SSMColumn_minMax<uInt> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  case TpFloat:
+    SSMColumn_minMax<Float> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  case TpDouble:
+    SSMColumn_minMax<Double> (aBuf.storage(), aNrRows, aMin, aMax);
+    break;
+  default:
+    return;
+  }
+  setZone (aBucketNr, aMin, aMax);
+}
+
+Bool SSMColumn::getZone (uInt aBucketNr, Double& aMin, Double& aMax) const
+{
+  std::map<uInt, std::pair<Double,Double> >::const_iterator iter =
+    itsZones.find (aBucketNr);
+  if (iter == itsZones.end()) {
+    return False;
+  }
+  aMin = iter->second.first;
+  aMax = iter->second.second;
+  return True;
+}
+
+Bool SSMColumn::getZoneMap (Vector<uInt>& aLastRow,
+                            Vector<Double>& aMinVal, Vector<Double>& aMaxVal)
+{
+  return itsSSMPtr->getZoneMap (itsColNr, aLastRow, aMinVal, aMaxVal);
+}
+
+Bool SSMColumn::getCellsValue (const RefRows& aRowNrs, void* aDataPtr)
+{
+  ArrayBase* anArr = const_cast<ArrayBase*>(getArrayBase (aRowNrs,
+                                                          aDataPtr));
+  if (anArr == 0) {
+    return False;
+  }
+  uInt aRowSize = localRowSize();
+  Bool deleteIt;
+  void* aStorage = anArr->getVStorage (deleteIt);
+  char* aTo = static_cast<char*>(aStorage);
+  RefRowsSliceIter anIter(aRowNrs);
+  while (! anIter.pastEnd()) {
+    uInt aNr = anIter.sliceEnd() - anIter.sliceStart() + 1;
+    getRowRange (anIter.sliceStart(), aNr, aTo);
+    aTo += size_t(aNr) * aRowSize;
+    anIter.next();
+  }
+  anArr->putVStorage (aStorage, deleteIt);
+  return True;
+}
+
+void SSMColumn::putScalarColumnCellsV (const RefRows& aRowNrs,
+                                       const void* aDataPtr)
+{
+  if (! putCellsValue (aRowNrs, aDataPtr)) {
+    StManColumn::putScalarColumnCellsV (aRowNrs, aDataPtr);
+  }
+}
+
+void SSMColumn::writeValues (char* aBucketData, const char* aFrom,
+                             uInt anOffset, uInt aNrRows) const
+{
+  if (dataType() == TpBool) {
+    uInt aBitOff = anOffset * itsNrCopy;
+    Conversion::boolToBit (aBucketData + aBitOff/8, aFrom, aBitOff%8,
+                           aNrRows * itsNrCopy);
+  } else {
+    itsWriteFunc (aBucketData + anOffset*itsExternalSizeBytes, aFrom,
+                  aNrRows * itsNrCopy);
+  }
+}
+
+void SSMColumn::putRowRange (uInt aRowNr, uInt aNrRows, const char* aFrom)
+{
+  uInt aRowSize = localRowSize();
+  uInt  aStartRow;
+  uInt  anEndRow;
+  while (aNrRows > 0) {
+    char* aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow);
+    uInt aNr = std::min (anEndRow - aRowNr + 1, aNrRows);
+    writeValues (aValue, aFrom, aRowNr - aStartRow, aNr);
+    itsSSMPtr->setBucketDirty();
+    aFrom    += size_t(aNr) * aRowSize;
+    aRowNr   += aNr;
+    aNrRows  -= aNr;
   }
+  // Be sure cache will be emptied
+  columnCache().invalidate();
+}
+
+Bool SSMColumn::putCellsValue (const RefRows& aRowNrs, const void* aDataPtr)
+{
+  const ArrayBase* anArr = getArrayBase (aRowNrs, aDataPtr);
+  if (anArr == 0) {
+    return False;
+  }
+  uInt aRowSize = localRowSize();
+  Bool deleteIt;
+  const void* aStorage = anArr->getVStorage (deleteIt);
+  const char* aFrom = static_cast<const char*>(aStorage);
+  RefRowsSliceIter anIter(aRowNrs);
+  while (! anIter.pastEnd()) {
+    uInt aNr = anIter.sliceEnd() - anIter.sliceStart() + 1;
+    putRowRange (anIter.sliceStart(), aNr, aFrom);
+    aFrom += size_t(aNr) * aRowSize;
+    anIter.next();
+  }
+  anArr->freeVStorage (aStorage, deleteIt);
+  return True;
 }
 
 void SSMColumn::putScalarColumnBoolV     (const Vector<Bool>* aDataPtr)
@@ -666,25 +962,7 @@ void SSMColumn::putScalarColumnStringV (const Vector<String>* aDataPtr)
 
 void SSMColumn::putColumnValue(const void* anArray,uInt aNrRows)
 {
-  const char* aDataPtr = static_cast<const char*>(anArray);
-  uInt aRowNr=0;
-  Int rowsToDo=aNrRows;
-
-  while (rowsToDo > 0) {
-    uInt  aStartRow;
-    uInt  anEndRow;
-    char* aValPtr;
-    aValPtr = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow);
-    aRowNr = anEndRow+1;
-    uInt aNr = anEndRow-aStartRow+1;
-    rowsToDo -= aNr;
-    itsWriteFunc (aValPtr, aDataPtr, aNr * itsNrCopy);
-    aDataPtr += aNr * itsLocalSize;
-    itsSSMPtr->setBucketDirty();
-  }
-
-  // Be sure cache will be emptied
-  columnCache().invalidate();
+  putRowRange (0, aNrRows, static_cast<const char*>(anArray));
 }
 
 void SSMColumn::removeColumn()
@@ -700,6 +978,36 @@ void SSMColumn::removeColumn()
   }
 }
   
+const void* SSMColumn::getColumnViewV (uInt aRowNr, uInt& aNrRow)
+{
+  aNrRow = 0;
+  DataType aDT = static_cast<DataType>(dataType());
+  // The data can only be used directly if no conversion is needed.
+  if (aDT == TpBool  ||  aDT == TpString
+  ||  itsSSMPtr->asBigEndian() != HostInfo::bigEndian()
+  ||  itsExternalSizeBytes != itsLocalSize) {
+    return 0;
+  }
+  uInt aStartRow;
+  uInt anEndRow;
+  const char* aValue = itsSSMPtr->findMapped (aRowNr, itsColNr,
+                                              aStartRow, anEndRow);
+  if (aValue == 0) {
+    return 0;
+  }
+  // The data must be aligned on the size of the basic type.
+  uInt anAlign = ValType::getTypeSize(aDT);
+  if (aDT == TpComplex  ||  aDT == TpDComplex) {
+    anAlign /= 2;
+  }
+  aValue += (aRowNr-aStartRow) * itsExternalSizeBytes;
+  if (reinterpret_cast<size_t>(aValue) % anAlign != 0) {
+    return 0;
+  }
+  aNrRow = anEndRow - aRowNr + 1;
+  return aValue;
+}
+
 void SSMColumn::init()
 {
   DataType aDT = static_cast<DataType>(dataType());
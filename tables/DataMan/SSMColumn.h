@@ -36,10 +36,12 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <map>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward declarations
+class ArrayBase;
 
 
 // <summary>
@@ -89,6 +91,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // This cache is used by the higher level table classes to get faster
 // read access to the data.
 // The cache is not used for strings, because they are stored differently.
+// <p>
+// If the storage manager keeps zone maps, the column holds the minimum
+// and maximum value of each of its data buckets. It is only done for
+// scalar columns with a numeric data type.
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -178,6 +184,12 @@ public:
   virtual void getScalarColumnDComplexV (Vector<DComplex>* aDataPtr);
   virtual void getScalarColumnStringV   (Vector<String>* aDataPtr);
   // </group>
+
+  // Get the scalar values in some cells of the column.
+  // Ranges of rows are read bucket by bucket (in parallel if multiple
+  // threads are used). Other row numbers are read one by one.
+  virtual void getScalarColumnCellsV (const RefRows& aRowNrs,
+                                      void* aDataPtr);
   
   // Put the scalar values of the entire column.
   // It invalidates the cache.
@@ -194,6 +206,13 @@ public:
   virtual void putScalarColumnDComplexV (const Vector<DComplex>* aDataPtr);
   virtual void putScalarColumnStringV   (const Vector<String>* aDataPtr);
   // </group>
+
+  // Put the scalar values in some cells of the column.
+  // Ranges of rows are written bucket by bucket, so each bucket is
+  // filled at once (e.g. after adding a batch of rows).
+  // Other row numbers are written one by one.
+  virtual void putScalarColumnCellsV (const RefRows& aRowNrs,
+                                      const void* aDataPtr);
   
   // Add (NewNrRows-OldNrRows) rows to the Column and initialize
   // the new rows when needed.
@@ -203,6 +222,14 @@ public:
   // If needed, it also removes it from the cache.
   virtual void deleteRow (uInt aRowNr);
 
+  // Get a direct readonly pointer to the data of the given row in the
+  // memory-mapped file. It is only possible if the data are stored in the
+  // local format (thus no conversion is needed) and are properly aligned.
+  // Bool and String columns cannot be accessed directly.
+  // The returned pointer is valid for the rows till the end of the
+  // bucket containing the row.
+  virtual const void* getColumnViewV (uInt aRowNr, uInt& aNrRow);
+
   // Get the size of the dataType in bytes!!
   uInt getExternalSizeBytes() const;
 
@@ -219,6 +246,35 @@ public:
   // as is the case with Strings, it can be done here.
   void removeColumn();
 
+  // Tell that the column contains scalars (thus is not an array column).
+  void setScalar()
+    { itsIsScalar = True; }
+
+  // Can the column have a zone map? That is the case for a scalar column
+  // with a numeric data type (except complex).
+  Bool canZoneMap() const;
+
+  // Calculate the zone (minimum and maximum) of the given data bucket
+  // containing the rows from aStartRow till anEndRow.
+  // NaN values are ignored.
+  void calcZone (uInt aBucketNr, uInt aStartRow, uInt anEndRow);
+
+  // Get the zone of the given data bucket.
+  // False is returned if not known.
+  Bool getZone (uInt aBucketNr, Double& aMin, Double& aMax) const;
+
+  // Set the zone of the given data bucket.
+  void setZone (uInt aBucketNr, Double aMin, Double aMax)
+    { itsZones[aBucketNr] = std::make_pair (aMin, aMax); }
+
+  // Remove all zones.
+  void clearZones()
+    { itsZones.clear(); }
+
+  // Get the zone map of the column (if kept by the storage manager).
+  virtual Bool getZoneMap (Vector<uInt>& aLastRow,
+                           Vector<Double>& aMinVal, Vector<Double>& aMaxVal);
+
 protected:
   // Shift the rows in the bucket one to the left when removing the given row.
   void shiftRows (char* aValue, uInt rowNr, uInt startRow, uInt endRow);
@@ -244,6 +300,46 @@ protected:
   // Get the values for the entire column.
   // The data from all buckets is copied to the array.
   void getColumnValue (void* anArray, uInt aNrRows);
+
+  // Get the values of a range of rows.
+  // If multiple threads are used and the file can be memory-mapped,
+  // the data of the buckets are converted in parallel.
+  void getRowRange (uInt aRowNr, uInt aNrRows, char* aTo);
+
+  // Get the values of the given rows into the Vector (for a scalar column)
+  // or Array if the rows are given as ranges with increment 1.
+  // It returns False if that is not the case, thus if nothing was done.
+  Bool getCellsValue (const RefRows& aRowNrs, void* aDataPtr);
+
+  // Put the values of a range of rows.
+  // The part of each bucket covered by the range is written at once and
+  // the bucket is marked dirty only once.
+  void putRowRange (uInt aRowNr, uInt aNrRows, const char* aFrom);
+
+  // Put the values in the given rows from the Vector or Array
+  // (like <src>getCellsValue</src>).
+  // It returns False if nothing was done.
+  Bool putCellsValue (const RefRows& aRowNrs, const void* aDataPtr);
+
+  // Get the Vector or Array the data pointer points to if the rows are
+  // given as ranges with increment 1 and the data type has a fixed size.
+  // Otherwise it returns a null pointer.
+  const ArrayBase* getArrayBase (const RefRows& aRowNrs,
+                                 const void* aDataPtr) const;
+
+  // Convert the values of <src>aNrRows</src> rows starting at the
+  // given row (relative to the start of the bucket) to local format.
+  void readValues (char* aTo, const char* aBucketData,
+                   uInt anOffset, uInt aNrRows) const;
+
+  // Convert the values of <src>aNrRows</src> rows to external format and
+  // store them in the bucket starting at the given row (relative to the
+  // start of the bucket).
+  void writeValues (char* aBucketData, const char* aFrom,
+                    uInt anOffset, uInt aNrRows) const;
+
+  // Get the length of the value of a row in local format.
+  uInt localRowSize() const;
   
   // Put the values from the array in the entire column.
   // Each data bucket is filled with the the appropriate part of the array.
@@ -275,6 +371,10 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // Is it a scalar column?
+  Bool itsIsScalar;
+  // The zones (minimum and maximum value) per data bucket.
+  std::map<uInt, std::pair<Double,Double> > itsZones;
   
 private:
   // Forbid copy constructor.
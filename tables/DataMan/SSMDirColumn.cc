@@ -27,6 +27,7 @@
 
 #include <casacore/tables/DataMan/SSMDirColumn.h>
 #include <casacore/tables/DataMan/SSMStringHandler.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Utilities/ValType.h>
 
@@ -44,6 +45,44 @@ SSMDirColumn::~SSMDirColumn()
 void SSMDirColumn::setMaxLength (uInt)
 {}
 
+Bool SSMDirColumn::canAccessArrayColumn (Bool& reask) const
+{
+  reask = False;
+  return dataType() != TpString;
+}
+
+void SSMDirColumn::getArrayColumnV (void* dataPtr)
+{
+  uInt aNrRows = itsSSMPtr->getNRow();
+  if (aNrRows > 0  &&  ! getCellsValue (RefRows(0, aNrRows-1), dataPtr)) {
+    StManColumn::getArrayColumnV (dataPtr);
+  }
+}
+
+void SSMDirColumn::getArrayColumnCellsV (const RefRows& rownrs,
+                                         void* dataPtr)
+{
+  if (! getCellsValue (rownrs, dataPtr)) {
+    StManColumn::getArrayColumnCellsV (rownrs, dataPtr);
+  }
+}
+
+void SSMDirColumn::putArrayColumnV (const void* dataPtr)
+{
+  uInt aNrRows = itsSSMPtr->getNRow();
+  if (aNrRows > 0  &&  ! putCellsValue (RefRows(0, aNrRows-1), dataPtr)) {
+    StManColumn::putArrayColumnV (dataPtr);
+  }
+}
+
+void SSMDirColumn::putArrayColumnCellsV (const RefRows& rownrs,
+                                         const void* dataPtr)
+{
+  if (! putCellsValue (rownrs, dataPtr)) {
+    StManColumn::putArrayColumnCellsV (rownrs, dataPtr);
+  }
+}
+
 void SSMDirColumn::deleteRow(uInt aRowNr)
 {
   char* aValue;
@@ -123,6 +123,29 @@ public:
   // Remove the given row from the data bucket and possibly string bucket.
   virtual void deleteRow(uInt aRowNr);
 
+  // The entire column can be accessed (except for String arrays).
+  virtual Bool canAccessArrayColumn (Bool& reask) const;
+
+  // Get all arrays in the column.
+  // The arrays are read bucket by bucket (in parallel if multiple threads
+  // are used).
+  virtual void getArrayColumnV (void* dataPtr);
+
+  // Get the arrays in some cells of the column.
+  // Ranges of rows are read bucket by bucket (in parallel if multiple
+  // threads are used). Other row numbers are read one by one.
+  virtual void getArrayColumnCellsV (const RefRows& rownrs, void* dataPtr);
+
+  // Put all arrays in the column.
+  // Each data bucket is filled with the appropriate part of the array.
+  virtual void putArrayColumnV (const void* dataPtr);
+
+  // Put the arrays in some cells of the column.
+  // Ranges of rows are written bucket by bucket. Other row numbers are
+  // written one by one.
+  virtual void putArrayColumnCellsV (const RefRows& rownrs,
+                                     const void* dataPtr);
+
 
 protected:
   // Read the array data for the given row into the data buffer.
@@ -173,6 +173,12 @@ Bool SSMIndColumn::canAccessSlice (Bool& reask) const
     return True;
 }
 
+const void* SSMIndColumn::getColumnViewV (uInt, uInt& aNrRow)
+{
+    aNrRow = 0;
+    return 0;
+}
+
 
 void SSMIndColumn::deleteRow(uInt aRowNr)
 {
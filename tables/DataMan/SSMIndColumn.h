@@ -107,6 +107,9 @@ public:
 
   // It can handle access to a slice in a cell.
   virtual Bool canAccessSlice (Bool& reask) const;
+
+  // The arrays are stored indirectly, so no direct pointer can be given.
+  virtual const void* getColumnViewV (uInt aRowNr, uInt& aNrRow);
   
   // Add (newNrrow-oldNrrow) rows to the column.
   virtual void addRow (uInt aNewNrRows, uInt anOldNrRows, Bool doInit);
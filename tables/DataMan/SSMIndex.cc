@@ -258,6 +258,15 @@ Vector<uInt> SSMIndex::getBuckets() const
   return aBucketList;
 }
 
+Vector<uInt> SSMIndex::getLastRows() const
+{
+  Vector<uInt> aRowList(itsNUsed);
+  for (uInt i=0; i< itsNUsed; i++) {
+    aRowList(i) = itsLastRow[i];
+  }
+  return aRowList;
+}
+
 Int SSMIndex::getFree (Int& anOffset, uInt nbits) const
 {
   Int aLength = (itsRowsPerBucket * nbits + 7) / 8;
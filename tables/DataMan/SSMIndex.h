@@ -105,6 +105,10 @@ public:
   // Return all the bucketnrs used in this index.
   Vector<uInt> getBuckets() const;
 
+  // Return the last row number of all the buckets used in this index
+  // (in the same order as getBuckets).
+  Vector<uInt> getLastRows() const;
+
   // Return the nr of buckets used.
   uInt getNrBuckets() const;
 
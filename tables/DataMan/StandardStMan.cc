@@ -32,14 +32,16 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 StandardStMan::StandardStMan (Int bucketSize,
-			      uInt cacheSize)
-: SSMBase (bucketSize, cacheSize)
+			      uInt cacheSize,
+			      Bool zoneMaps)
+: SSMBase (bucketSize, cacheSize, zoneMaps)
 {}
 
 StandardStMan::StandardStMan (const String& dataManagerName,
 			      Int bucketSize,
-			      uInt cacheSize)
-: SSMBase (dataManagerName, bucketSize, cacheSize)
+			      uInt cacheSize,
+			      Bool zoneMaps)
+: SSMBase (dataManagerName, bucketSize, cacheSize, zoneMaps)
 {}
 
 StandardStMan::~StandardStMan()
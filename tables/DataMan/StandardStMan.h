@@ -168,12 +168,18 @@ public:
     // In general it makes sense to give the expected number of table rows.
     // In that way the buckets will be small enough for small tables
     // and not too small for large tables.
+    // <br>If <src>zoneMaps=True</src>, the minimum and maximum value of
+    // each data bucket are kept for the numeric scalar columns. TaQL uses
+    // these zone maps to skip the buckets not matching a selection on
+    // a range of values (e.g. a time range).
     // <group>
     explicit StandardStMan (Int bucketSize = 0,
-			    uInt cacheSize = 1);
+			    uInt cacheSize = 1,
+			    Bool zoneMaps = False);
     explicit StandardStMan (const String& dataManagerName,
 			    Int bucketSize = 0,
-			    uInt cacheSize = 1);
+			    uInt cacheSize = 1,
+			    Bool zoneMaps = False);
     // </group>
 
     ~StandardStMan();
@@ -78,6 +78,26 @@ uInt ROStandardStManAccessor::getCacheSize() const
     return itsSSMPtr->getCacheSize();
 }
 
+void ROStandardStManAccessor::setPrefetch (uInt aNrBucket)
+{
+    itsSSMPtr->setPrefetch (aNrBucket);
+}
+
+uInt ROStandardStManAccessor::getPrefetch() const
+{
+    return itsSSMPtr->getPrefetch();
+}
+
+void ROStandardStManAccessor::setNThread (uInt aNThread)
+{
+    itsSSMPtr->setNThread (aNThread);
+}
+
+uInt ROStandardStManAccessor::getNThread() const
+{
+    return itsSSMPtr->getNThread();
+}
+
 void ROStandardStManAccessor::clearCache()
 {
     itsSSMPtr->clearCache();
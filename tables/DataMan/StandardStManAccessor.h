@@ -135,6 +135,22 @@ public:
     // Get the cache size (in buckets).
     uInt getCacheSize() const;
 
+    // Set the number of buckets to prefetch when a sequential or strided
+    // access pattern is detected. 0 means no prefetching.
+    // Like the cache size, it is not persistent.
+    void setPrefetch (uInt aNrBucket);
+
+    // Get the number of buckets to prefetch.
+    uInt getPrefetch() const;
+
+    // Set the number of threads to use when reading a range of rows
+    // of a column. It has only effect if casacore is built with OpenMP.
+    // Like the cache size, it is not persistent.
+    void setNThread (uInt aNThread);
+
+    // Get the number of threads to use.
+    uInt getNThread() const;
+
     // Clear the cache used by this storage manager.
     // It will flush the cache as needed and remove all buckets from it
     // resulting in a drop in memory used.
@@ -0,0 +1,313 @@
+//# TSMCodec.cc: Lossless compression of tiles in the Tiled Storage Managers
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/string.h>                           // for memcpy
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// The number of bits used in the hash table of the LZ compressor.
+#define TSMCodec_HashLog 12
+
+// Get 4 bytes as an integer (byte order does not matter).
+inline uInt TSMCodec_read32 (const uChar* ptr)
+{
+    uInt v;
+    memcpy (&v, ptr, sizeof(uInt));
+    return v;
+}
+
+// Write a length exceeding 15 as a sequence of bytes.
+inline void TSMCodec_putLength (uChar* out, uInt& op, uInt length)
+{
+    while (length >= 255) {
+        out[op++] = 255;
+        length -= 255;
+    }
+    out[op++] = length;
+}
+
+// Read a length written by TSMCodec_putLength.
+// It returns False if the input is exhausted.
+inline Bool TSMCodec_getLength (const uChar* in, uInt& ip, uInt length,
+                                uInt& value)
+{
+    uInt b;
+    do {
+        if (ip >= length) {
+            return False;
+        }
+        b = in[ip++];
+        value += b;
+    } while (b == 255);
+    return True;
+}
+
+// Write a sequence of literals followed by a match.
+// A match length 0 means that there is no match (for the last literals).
+// It returns False if the output buffer is too small.
+static Bool TSMCodec_putSequence (uChar* out, uInt& op, uInt outSize,
+                                  const uChar* literals, uInt nlit,
+                                  uInt offset, uInt matchLength)
+{
+    if (Int64(op) + 1 + nlit/255 + 1 + nlit + 2 + matchLength/255 + 1
+        > Int64(outSize)) {
+        return False;
+    }
+    uInt ml = (matchLength == 0  ?  0 : matchLength - 4);
+    uChar* token = out + op++;
+    *token = ((nlit < 15 ? nlit : 15) << 4)  |  (ml < 15 ? ml : 15);
+    if (nlit >= 15) {
+        TSMCodec_putLength (out, op, nlit - 15);
+    }
+    memcpy (out + op, literals, nlit);
+    op += nlit;
+    if (matchLength > 0) {
+        out[op++] = offset & 255;
+        out[op++] = offset >> 8;
+        if (ml >= 15) {
+            TSMCodec_putLength (out, op, ml - 15);
+        }
+    }
+    return True;
+}
+
+
+TSMCodec::Type TSMCodec::type (const String& name)
+{
+    String str(name);
+    str.downcase();
+    if (str == "none") {
+        return None;
+    } else if (str == "lz") {
+        return LZ;
+    } else if (str == "shufflelz") {
+        return ShuffleLZ;
+    }
+    throw DataManError ("TSMCodec: unknown tile codec " + name);
+}
+
+String TSMCodec::name (Type type)
+{
+    switch (type) {
+    case LZ:
+        return "lz";
+    case ShuffleLZ:
+        return "shufflelz";
+    default:
+        break;
+    }
+    return "none";
+}
+
+uInt TSMCodec::encode (Type type, const char* tile, uInt length,
+                       const Block<uInt>& offset, const Block<uInt>& elemSize,
+                       char* out)
+{
+    uInt nr = 0;
+    if (type != None  &&  length > 1) {
+        const char* data = tile;
+        Block<char> buf;
+        if (type == ShuffleLZ) {
+            buf.resize (length);
+            shuffle (tile, buf.storage(), length, offset, elemSize, True);
+            data = buf.storage();
+        }
+        // The compressed tile must be smaller than the tile itself.
+        nr = lzCompress ((const uChar*)data, length, (uChar*)out, length-1);
+    }
+    if (nr == 0) {
+        memcpy (out, tile, length);
+        nr = length;
+    }
+    return nr;
+}
+
+void TSMCodec::decode (Type type, const char* data, uInt dataLength,
+                       const Block<uInt>& offset, const Block<uInt>& elemSize,
+                       char* tile, uInt length)
+{
+    if (dataLength == 0) {
+        // The tile has never been written.
+        memset (tile, 0, length);
+    } else if (dataLength == length) {
+        memcpy (tile, data, length);
+    } else {
+        if (type == None  ||  dataLength > length) {
+            throw DataManError ("TSMCodec: invalid length of compressed tile");
+        }
+        char* to = tile;
+        Block<char> buf;
+        if (type == ShuffleLZ) {
+            buf.resize (length);
+            to = buf.storage();
+        }
+        if (! lzDecompress ((const uChar*)data, dataLength,
+                            (uChar*)to, length)) {
+            throw DataManError ("TSMCodec: compressed tile is corrupt");
+        }
+        if (type == ShuffleLZ) {
+            shuffle (to, tile, length, offset, elemSize, False);
+        }
+    }
+}
+
+void TSMCodec::shuffle (const char* from, char* to, uInt length,
+                        const Block<uInt>& offset,
+                        const Block<uInt>& elemSize, Bool forward)
+{
+    uInt nrcol = offset.nelements();
+    for (uInt i=0; i<nrcol; i++) {
+        uInt start = offset[i];
+        uInt end   = (i+1 < nrcol  ?  offset[i+1] : length);
+        uInt esize = elemSize[i];
+        const char* f = from + start;
+        char* t = to + start;
+        uInt nrel = (esize > 1  ?  (end - start) / esize : 0);
+        if (nrel > 1) {
+            if (forward) {
+                for (uInt b=0; b<esize; b++) {
+                    for (uInt k=0; k<nrel; k++) {
+                        t[b*nrel + k] = f[k*esize + b];
+                    }
+                }
+            } else {
+                for (uInt b=0; b<esize; b++) {
+                    for (uInt k=0; k<nrel; k++) {
+                        t[k*esize + b] = f[b*nrel + k];
+                    }
+                }
+            }
+        } else {
+            nrel = 0;
+        }
+        // Copy the remaining bytes as such.
+        uInt done = nrel * esize;
+        memcpy (t + done, f + done, end - start - done);
+    }
+}
+
+uInt TSMCodec::lzCompress (const uChar* in, uInt length,
+                           uChar* out, uInt outSize)
+{
+    uInt op = 0;
+    uInt anchor = 0;
+    // No match can start in the last 12 bytes and the last 5 bytes
+    // are always literals.
+    if (length > 12) {
+        Block<Int> table(1 << TSMCodec_HashLog, -1);
+        uInt limit = length - 12;
+        uInt matchLimit = length - 5;
+        uInt ip = 0;
+        while (ip < limit) {
+            uInt seq = TSMCodec_read32 (in + ip);
+            uInt h = (seq * 2654435761u) >> (32 - TSMCodec_HashLog);
+            Int ref = table[h];
+            table[h] = ip;
+            if (ref >= 0  &&  ip - ref <= 65535
+            &&  TSMCodec_read32 (in + ref) == seq) {
+                uInt matchLength = 4;
+                while (ip + matchLength < matchLimit
+                &&  in[ref + matchLength] == in[ip + matchLength]) {
+                    matchLength++;
+                }
+                if (! TSMCodec_putSequence (out, op, outSize,
+                                            in + anchor, ip - anchor,
+                                            ip - ref, matchLength)) {
+                    return 0;
+                }
+                ip += matchLength;
+                anchor = ip;
+            } else {
+                ip++;
+            }
+        }
+    }
+    // Write the remaining literals.
+    if (! TSMCodec_putSequence (out, op, outSize,
+                                in + anchor, length - anchor, 0, 0)) {
+        return 0;
+    }
+    return op;
+}
+
+Bool TSMCodec::lzDecompress (const uChar* in, uInt length,
+                             uChar* out, uInt outSize)
+{
+    uInt ip = 0;
+    uInt op = 0;
+    while (ip < length) {
+        uInt token = in[ip++];
+        uInt nlit = token >> 4;
+        if (nlit == 15) {
+            if (! TSMCodec_getLength (in, ip, length, nlit)) {
+                return False;
+            }
+        }
+        if (nlit > length - ip  ||  nlit > outSize - op) {
+            return False;
+        }
+        memcpy (out + op, in + ip, nlit);
+        ip += nlit;
+        op += nlit;
+        // The last sequence has no match.
+        if (ip == length) {
+            break;
+        }
+        if (length - ip < 2) {
+            return False;
+        }
+        uInt offset = in[ip] | (uInt(in[ip+1]) << 8);
+        ip += 2;
+        if (offset == 0  ||  offset > op) {
+            return False;
+        }
+        uInt matchLength = token & 15;
+        if (matchLength == 15) {
+            if (! TSMCodec_getLength (in, ip, length, matchLength)) {
+                return False;
+            }
+        }
+        matchLength += 4;
+        if (matchLength > outSize - op) {
+            return False;
+        }
+        // Copy byte by byte, because the match can overlap the output.
+        const uChar* ref = out + op - offset;
+        for (uInt i=0; i<matchLength; i++) {
+            out[op+i] = ref[i];
+        }
+        op += matchLength;
+    }
+    return op == outSize;
+}
+
+} //# NAMESPACE CASACORE - END
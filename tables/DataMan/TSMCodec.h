@@ -0,0 +1,145 @@
+//# TSMCodec.h: Lossless compression of tiles in the Tiled Storage Managers
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TSMCODEC_H
+#define TABLES_TSMCODEC_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+template<class T> class Block;
+
+
+// <summary>
+// Lossless compression of tiles in the Tiled Storage Managers
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledShapeStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TiledStMan>TiledStMan</linkto>
+//   <li> <linkto class=TSMCodecFile>TSMCodecFile</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TSMCodec contains the static functions to compress and decompress
+// a tile (in external format) of a hypercube in a Tiled Storage Manager.
+// The compression is lossless; for lossy compression the virtual column
+// engines <linkto class=CompressFloat>CompressFloat</linkto> and
+// <linkto class=CompressComplex>CompressComplex</linkto> can be used.
+// <br>The following codecs are supported:
+// <ul>
+//  <li> <src>None</src> does no compression; tiles are stored with a
+//       fixed length in the file.
+//  <li> <src>LZ</src> compresses the tile with a fast byte-oriented
+//       LZ77 compressor (using the LZ4 block format).
+//  <li> <src>ShuffleLZ</src> first shuffles the bytes of the tile, so all
+//       first bytes of the values come first, thereafter all second bytes,
+//       etc.. Thereafter the result is compressed with the LZ compressor.
+//       For floating point data this gives usually a much better
+//       compression, because the exponent bytes are very similar.
+// </ul>
+// The tile data of each data column in the tile are shuffled separately
+// using the size of the basic data type (e.g. 4 for Complex).
+// <br>If a tile cannot be compressed, it is stored as such. It means
+// that the length of a compressed tile is always less than the tile size.
+// A length equal to the tile size means that the tile is not compressed.
+// A length 0 means that the tile has not been written yet.
+// </synopsis>
+
+// <motivation>
+// Tiled data (in particular visibility data) can often be compressed
+// losslessly with a factor 2 or more. Reading less data from disk
+// can speed up IO-bound applications considerably.
+// </motivation>
+
+class TSMCodec
+{
+public:
+    // Define the possible codecs.
+    // Note that the values are stored in the table files, so the
+    // existing values should not be changed.
+    enum Type {
+        None      = 0,
+        LZ        = 1,
+        ShuffleLZ = 2
+    };
+
+    // Get the codec type from its case-insensitive name
+    // (none, lz, or shufflelz). An exception is thrown if unknown.
+    static Type type (const String& name);
+
+    // Get the name of a codec type.
+    static String name (Type type);
+
+    // Compress a tile of <src>length</src> bytes.
+    // The data of the data columns in the tile start at the given offsets
+    // and have the given element sizes (used for the byte-shuffling).
+    // The output buffer must have at least <src>length</src> bytes.
+    // It returns the length of the compressed data. If the data could not
+    // be compressed, the tile is copied and <src>length</src> is returned.
+    static uInt encode (Type type, const char* tile, uInt length,
+                        const Block<uInt>& offset, const Block<uInt>& elemSize,
+                        char* out);
+
+    // Decompress the data into a tile of <src>length</src> bytes.
+    // The offsets and element sizes must be the same as used in encode.
+    // An exception is thrown if the compressed data are corrupt.
+    static void decode (Type type, const char* data, uInt dataLength,
+                        const Block<uInt>& offset, const Block<uInt>& elemSize,
+                        char* tile, uInt length);
+
+private:
+    // Shuffle or unshuffle the bytes of the data columns in a tile.
+    static void shuffle (const char* from, char* to, uInt length,
+                         const Block<uInt>& offset,
+                         const Block<uInt>& elemSize, Bool forward);
+
+    // Compress the data using an LZ77 algorithm.
+    // It returns 0 if the compressed data do not fit in the output buffer
+    // of the given size.
+    static uInt lzCompress (const uChar* in, uInt length,
+                            uChar* out, uInt outSize);
+
+    // Decompress the data compressed by lzCompress.
+    // It returns False if the data are corrupt.
+    static Bool lzDecompress (const uChar* in, uInt length,
+                              uChar* out, uInt outSize);
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
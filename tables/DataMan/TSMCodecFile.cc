@@ -0,0 +1,215 @@
+//# TSMCodecFile.cc: Access to compressed tiles in a TSMFile
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/TSMCodecFile.h>
+#include <casacore/tables/DataMan/TSMFile.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TSMCodecFile::TSMCodecFile (TSMFile* file, TSMCodec::Type codec,
+                            uInt tileSize,
+                            const Block<uInt>& offset,
+                            const Block<uInt>& elemSize,
+                            Block<Int64>& tileOffset,
+                            Block<uInt>& tileLength,
+                            uInt nThread)
+: BucketFile   (file->bucketFile()->name(),
+                file->bucketFile()->isWritable()),
+  file_p       (file),
+  codec_p      (codec),
+  tileSize_p   (tileSize),
+  offset_p     (offset),
+  elemSize_p   (elemSize),
+  tileOffset_p (tileOffset),
+  tileLength_p (tileLength),
+  nthread_p    (nThread),
+  position_p   (0)
+{}
+
+TSMCodecFile::~TSMCodecFile()
+{}
+
+void TSMCodecFile::open()
+{
+    file_p->open();
+}
+
+void TSMCodecFile::remove()
+{}
+
+void TSMCodecFile::fsync()
+{
+    file_p->bucketFile()->fsync();
+}
+
+void TSMCodecFile::setRW()
+{
+    BucketFile::setRW();
+    file_p->bucketFile()->setRW();
+}
+
+void TSMCodecFile::seek (Int64 offset)
+{
+    position_p = offset;
+}
+
+Int64 TSMCodecFile::fileSize() const
+{
+    return Int64(tileLength_p.nelements()) * tileSize_p;
+}
+
+Int64 TSMCodecFile::compressedSize() const
+{
+    Int64 size = 0;
+    for (uInt i=0; i<tileLength_p.nelements(); i++) {
+        size += tileLength_p[i];
+    }
+    return size;
+}
+
+uInt TSMCodecFile::checkAccess (uInt length) const
+{
+    if (position_p % tileSize_p != 0  ||  length % tileSize_p != 0
+    ||  position_p + length > fileSize()) {
+        throw DataManInternalError ("TSMCodecFile: invalid tile access");
+    }
+    return position_p / tileSize_p;
+}
+
+uInt TSMCodecFile::read (void* buffer, uInt length)
+{
+    uInt first = checkAccess (length);
+    Int nr = length / tileSize_p;
+    // Determine where each compressed tile is put in the buffer.
+    Block<size_t> start(nr+1);
+    start[0] = 0;
+    for (Int i=0; i<nr; i++) {
+        start[i+1] = start[i] + tileLength_p[first+i];
+    }
+    if (buffer_p.nelements() < start[nr]) {
+        buffer_p.resize (start[nr], False, False);
+    }
+    // Read the compressed tiles. Tiles adjacent in the file are read
+    // at once.
+    BucketFile* bfile = file_p->bucketFile();
+    Int inx = 0;
+    while (inx < nr) {
+        if (tileLength_p[first+inx] == 0) {
+            inx++;
+        } else {
+            Int j = inx+1;
+            while (j < nr  &&  tileLength_p[first+j] > 0
+               &&  tileOffset_p[first+j] == tileOffset_p[first+j-1] +
+                                            tileLength_p[first+j-1]) {
+                j++;
+            }
+            bfile->seek (tileOffset_p[first+inx]);
+            bfile->read (buffer_p.storage() + start[inx],
+                         start[j] - start[inx]);
+            inx = j;
+        }
+    }
+    // Decompress the tiles (in parallel if possible).
+    // An exception cannot be thrown inside the parallel loop.
+    char* data = static_cast<char*>(buffer);
+    Bool corrupt = False;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread_p) if (nthread_p > 1 && nr > 1)
+#endif
+    for (Int i=0; i<nr; i++) {
+        try {
+            TSMCodec::decode (codec_p, buffer_p.storage() + start[i],
+                              tileLength_p[first+i], offset_p, elemSize_p,
+                              data + size_t(i)*tileSize_p, tileSize_p);
+        } catch (const AipsError&) {
+            corrupt = True;
+        }
+    }
+    if (corrupt) {
+        throw DataManError ("TSMCodecFile: compressed tile in file " +
+                            name() + " is corrupt");
+    }
+    position_p += length;
+    return length;
+}
+
+uInt TSMCodecFile::write (const void* buffer, uInt length)
+{
+    uInt first = checkAccess (length);
+    uInt nr = length / tileSize_p;
+    if (buffer_p.nelements() < tileSize_p) {
+        buffer_p.resize (tileSize_p, False, False);
+    }
+    BucketFile* bfile = file_p->bucketFile();
+    const char* data = static_cast<const char*>(buffer);
+    for (uInt i=0; i<nr; i++) {
+        uInt tileNr = first + i;
+        uInt leng = TSMCodec::encode (codec_p, data + size_t(i)*tileSize_p,
+                                      tileSize_p, offset_p, elemSize_p,
+                                      buffer_p.storage());
+        // Rewrite in place if it fits, otherwise append to the file.
+        if (leng > tileLength_p[tileNr]) {
+            tileOffset_p[tileNr] = file_p->length();
+            file_p->extend (leng);
+        }
+        tileLength_p[tileNr] = leng;
+        bfile->seek (tileOffset_p[tileNr]);
+        bfile->write (buffer_p.storage(), leng);
+    }
+    position_p += length;
+    return length;
+}
+
+void TSMCodecFile::prefetch (Int64 offset, Int64 length)
+{
+    Int64 first = offset / tileSize_p;
+    Int64 last  = std::min (Int64(tileLength_p.nelements()),
+                            (offset + length + tileSize_p - 1) / tileSize_p);
+    // Combine the tiles adjacent in the file.
+    Int64 st  = 0;
+    Int64 end = -1;
+    for (Int64 i=first; i<last; i++) {
+        if (tileLength_p[i] > 0) {
+            if (tileOffset_p[i] != end) {
+                if (end > st) {
+                    file_p->bucketFile()->prefetch (st, end-st);
+                }
+                st = tileOffset_p[i];
+            }
+            end = tileOffset_p[i] + tileLength_p[i];
+        }
+    }
+    if (end > st) {
+        file_p->bucketFile()->prefetch (st, end-st);
+    }
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,156 @@
+//# TSMCodecFile.h: Access to compressed tiles in a TSMFile
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TSMCODECFILE_H
+#define TABLES_TSMCODECFILE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Containers/Block.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class TSMFile;
+
+
+// <summary>
+// Access to compressed tiles in a TSMFile
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledShapeStMan.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TSMCube>TSMCube</linkto>
+//   <li> <linkto class=TSMCodec>TSMCodec</linkto>
+//   <li> <linkto class=BucketCache>BucketCache</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TSMCodecFile makes it possible to use a
+// <linkto class=BucketCache>BucketCache</linkto> for the compressed
+// tiles of a hypercube. It acts as a BucketFile containing the tiles
+// of the hypercube in their uncompressed form (starting at offset 0).
+// A read or write of one or more tiles is translated to reading or writing
+// the compressed tiles in the underlying TSMFile.
+// <br>Because compressed tiles have a variable length, the hypercube keeps
+// an index containing the file offset and length of each tile.
+// A rewritten tile is stored at its old location if it fits, otherwise
+// it is appended to the file (leaving the old space unused).
+// <br>If multiple tiles are read at once, they are decompressed in parallel
+// if multiple threads are used.
+// </synopsis>
+
+// <motivation>
+// Using a BucketFile interface makes it possible to reuse the BucketCache
+// with all its features (prefetching, parallel conversion) for compressed
+// hypercubes.
+// </motivation>
+
+class TSMCodecFile : public BucketFile
+{
+public:
+    // Create the object for a hypercube in the given TSMFile.
+    // The offsets and element sizes of the data columns in a tile are
+    // used by the codec. The tile index is kept by the hypercube;
+    // this object keeps a reference to it and updates it when writing.
+    TSMCodecFile (TSMFile* file, TSMCodec::Type codec, uInt tileSize,
+                  const Block<uInt>& offset, const Block<uInt>& elemSize,
+                  Block<Int64>& tileOffset, Block<uInt>& tileLength,
+                  uInt nThread);
+
+    virtual ~TSMCodecFile();
+
+    // Open the underlying file if not open yet.
+    virtual void open();
+
+    // Removing the file is not possible; it is owned by TSMFile.
+    virtual void remove();
+
+    // Fsync the underlying file.
+    virtual void fsync();
+
+    // Set the file (and the underlying file) to read/write access.
+    virtual void setRW();
+
+    // Read the given number of bytes (a multiple of the tile size)
+    // by reading and decompressing the tiles.
+    virtual uInt read (void* buffer, uInt length);
+
+    // Write the given number of bytes (a multiple of the tile size)
+    // by compressing and writing the tiles.
+    virtual uInt write (const void* buffer, uInt length);
+
+    // Seek to the given position in the uncompressed data.
+    // It has to be a multiple of the tile size.
+    virtual void seek (Int64 offset);
+
+    // Get the size of the uncompressed data.
+    virtual Int64 fileSize() const;
+
+    // Prefetch the compressed tiles in the given part of the
+    // uncompressed data.
+    virtual void prefetch (Int64 offset, Int64 length);
+
+    // Get the total length of the compressed tiles.
+    Int64 compressedSize() const;
+
+private:
+    // Forbid copy constructor.
+    TSMCodecFile (const TSMCodecFile&);
+
+    // Forbid assignment.
+    TSMCodecFile& operator= (const TSMCodecFile&);
+
+    // Check if an access is on tile boundaries and return the first tile.
+    uInt checkAccess (uInt length) const;
+
+
+    TSMFile*            file_p;
+    TSMCodec::Type      codec_p;
+    uInt                tileSize_p;
+    const Block<uInt>&  offset_p;
+    const Block<uInt>&  elemSize_p;
+    Block<Int64>&       tileOffset_p;
+    Block<uInt>&        tileLength_p;
+    uInt                nthread_p;
+    // The current position in the uncompressed data.
+    Int64               position_p;
+    // Buffer holding compressed tiles.
+    Block<char>         buffer_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
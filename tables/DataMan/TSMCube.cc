@@ -32,11 +32,13 @@
 #include <casacore/tables/DataMan/TiledStMan.h>
 #include <casacore/tables/DataMan/TSMFile.h>
 #include <casacore/tables/DataMan/TSMColumn.h>
+#include <casacore/tables/DataMan/TSMCodecFile.h>
 #include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/casa/Arrays/ArrayUtil.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Containers/RecordField.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Containers/BlockIO.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/IO/AipsIO.h>
@@ -118,7 +120,9 @@ TSMCube::TSMCube (TiledStMan* stman, TSMFile* file,
   fileOffset_p   (0),
   cache_p        (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  lastColAccess_p(NoAccess),
+  codec_p        (fileOffset < 0  ?  stman->tileCodec() : TSMCodec::None),
+  codecFile_p    (0)
 {
     if (fileOffset < 0) {
         // TiledCellStMan uses an empty shape; setShape is called later. 
@@ -145,7 +149,9 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
   filePtr_p      (0),
   cache_p        (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  lastColAccess_p(NoAccess),
+  codec_p        (TSMCodec::None),
+  codecFile_p    (0)
 {
     Int fileSeqnr = getObject (ios);
     if (fileSeqnr >= 0) {
@@ -158,6 +164,7 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
 TSMCube::~TSMCube()
 {
     delete cache_p;
+    delete codecFile_p;
     delete [] cachedTile_p;
 }
 
@@ -187,6 +194,11 @@ void TSMCube::showCacheStatistics (ostream& os) const
         os << "cubeShape: " << cubeShape_p << endl;
         os << "tileShape: " << tileShape_p << endl;
         os << "maxCacheSz:" << stmanPtr_p->maximumCacheSize() << endl;
+        if (codecFile_p != 0) {
+            os << "tileCodec: " << TSMCodec::name(codec_p)
+               << "  (" << codecFile_p->compressedSize() << " of "
+               << codecFile_p->fileSize() << " bytes)" << endl;
+        }
         cache_p->showStatistics (os);
         os << "<<<" << endl;
     }
@@ -297,7 +309,10 @@ void TSMCube::setShape (const IPosition& cubeShape, const IPosition& tileShape)
       makeCache();
     }
     // Tell TSMFile that the file gets extended.
-    filePtr_p->extend (nrTiles_p * bucketSize_p);
+    // Compressed tiles are appended to the file when written.
+    if (codec_p == TSMCodec::None) {
+        filePtr_p->extend (nrTiles_p * bucketSize_p);
+    }
     // Initialize the coordinate columns (as far as needed).
     stmanPtr_p->initCoordinates (this);
     // Set flag if writing.
@@ -310,11 +325,15 @@ void TSMCube::putObject (AipsIO& ios)
     flushCache();
     // If the offset is small enough, write it as an old style file,
     // so older software can still read it.
-    Bool vers1 = (fileOffset_p <= 2u*1024u*1024u*1024u);
+    // Version 3 is only used for compressed tiles.
+    Bool vers1 = (fileOffset_p <= 2u*1024u*1024u*1024u  &&
+                  codec_p == TSMCodec::None);
     if (vers1) {
         ios << 1;                          // version 1
-    } else {
+    } else if (codec_p == TSMCodec::None) {
         ios << 2;                          // version 2
+    } else {
+        ios << 3;                          // version 3
     }
     ios << values_p;
     ios << extensible_p;
@@ -331,6 +350,11 @@ void TSMCube::putObject (AipsIO& ios)
     } else {
 	ios << fileOffset_p;
     }
+    if (codec_p != TSMCodec::None) {
+        ios << Int(codec_p);
+        putBlock (ios, tileOffset_p);
+        putBlock (ios, tileLength_p);
+    }
 }
 Int TSMCube::getObject (AipsIO& ios)
 {
@@ -350,6 +374,14 @@ Int TSMCube::getObject (AipsIO& ios)
     } else {
         ios >> fileOffset_p;
     }
+    codec_p = TSMCodec::None;
+    if (version >= 3) {
+        Int codec;
+        ios >> codec;
+        codec_p = TSMCodec::Type(codec);
+        getBlock (ios, tileOffset_p);
+        getBlock (ios, tileLength_p);
+    }
     return fileSeqnr;
 }
 
@@ -378,6 +410,24 @@ void TSMCube::setup()
 
     // Resize IPosition member variables used in accessSection()
     resizeTileSections();
+    // Get the info needed to compress the tiles.
+    if (codec_p != TSMCodec::None) {
+        stmanPtr_p->getElementSizes (codecElemSize_p);
+        resizeTileIndex();
+    }
+}
+
+void TSMCube::resizeTileIndex()
+{
+    uInt nrold = tileLength_p.nelements();
+    if (nrTiles_p > nrold) {
+        tileOffset_p.resize (nrTiles_p);
+        tileLength_p.resize (nrTiles_p);
+        for (uInt i=nrold; i<nrTiles_p; i++) {
+            tileOffset_p[i] = 0;
+            tileLength_p[i] = 0;
+        }
+    }
 }
 
 void TSMCube::setupNrTiles()
@@ -399,10 +449,25 @@ void TSMCube::makeCache()
 {
     // If there is no cache, make one with initially 1 slot.
     if (cache_p == 0) {
-        cache_p = new BucketCache (filePtr_p->bucketFile(), fileOffset_p,
+        uInt nthread = max (1, stmanPtr_p->tsmOption().nThread());
+        BucketFile* file = filePtr_p->bucketFile();
+        Int64 offset = fileOffset_p;
+        // Compressed tiles are accessed via a TSMCodecFile object
+        // holding the uncompressed tiles from offset 0 on.
+        if (codec_p != TSMCodec::None) {
+            codecFile_p = new TSMCodecFile (filePtr_p, codec_p, bucketSize_p,
+                                            externalOffset_p, codecElemSize_p,
+                                            tileOffset_p, tileLength_p,
+                                            nthread);
+            file   = codecFile_p;
+            offset = 0;
+        }
+        cache_p = new BucketCache (file, offset,
                                    bucketSize_p, nrTiles_p, 1, this,
                                    readCallBack, writeCallBack,
                                    initCallBack, deleteCallBack);
+        cache_p->setPrefetch (max (0, stmanPtr_p->tsmOption().prefetch()));
+        cache_p->setNThread (nthread);
     }
 }
 
@@ -424,6 +489,8 @@ void TSMCube::deleteCache()
 {
     delete cache_p;
     cache_p = 0;
+    delete codecFile_p;
+    codecFile_p = 0;
 }
 
 
@@ -447,8 +514,16 @@ void TSMCube::extend (uInt nr, const Record& coordValues,
     tilesPerDim_p(lastDim) = (cubeShape_p(lastDim) + tileShape_p(lastDim) - 1)
                              / tileShape_p(lastDim);
     nrTiles_p = nrTilesSubCube_p * tilesPerDim_p(lastDim);
-    getCache()->extend (nrTiles_p - nrold);
-    filePtr_p->extend ((nrTiles_p - nrold) * bucketSize_p);
+    if (codec_p == TSMCodec::None) {
+        getCache()->extend (nrTiles_p - nrold);
+        filePtr_p->extend ((nrTiles_p - nrold) * bucketSize_p);
+    } else {
+        // The codec file might have been created before the table
+        // was reopened for read/write.
+        resizeTileIndex();
+        codecFile_p->setRW();
+        getCache()->extend (nrTiles_p - nrold);
+    }
     // Update the last coordinate (if there).
     if (lastCoordColumn != 0) {
         extendCoordinates (coordValues, lastCoordColumn->columnName(),
@@ -692,10 +767,15 @@ char* TSMCube::readTile (const char* external)
 {
     char* local = 0;
 
-    if (cachedTile_p != 0){
+    // Tiles can be read by multiple threads (in BucketCache::getBuckets).
+#ifdef _OPENMP
+#pragma omp critical(TSMCube_cachedTile)
+#endif
+    {
         local = cachedTile_p;
         cachedTile_p = 0;
-    } else {
+    }
+    if (local == 0) {
         local = new char[localTileLength_p];
     }
 
@@ -937,7 +1017,7 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
 	stmanPtr_p->setDataChanged();
     }
     // Prepare for the iteration through the necessary tiles.
-    uInt i, j;
+    uInt i;
 
     // Initialize the various variables and determine the number of
     // tiles needed (which will determine the cache size).
@@ -1002,9 +1082,6 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
         return;
     }
 
-    // Find out if local size is a multiple of 4, so we can move as integers.
-    TSMCube_FindMult;
-
     // If the section is a line, call a specialized function.
     // Note that a single pixel is also handled as a line.
     if (nOneLong >= nrdim_p - 1) {
@@ -1016,23 +1093,23 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
         return;
     }
 
+    // Copy the tiles in parallel if multiple threads can be used.
+    if (cachePtr->nThread() > 1  &&  cachePtr->cacheSize() > 1) {
+        accessSectionPar (cachePtr, start, end, section, pixelOffset,
+                          localPixelSize, writeFlag);
+        return;
+    }
+
     // At this point we start looping through all tiles.
     // startPixel and endPixel will contain the first and last pixels
     // needed in the current tile.
     // tilePos contains the position of the current tile.
-    IPosition startSection (start);            // start of section in cube
-    IPosition sectionShape (end - start + 1);  // section shape
-    TSMShape expandedSectionShape (sectionShape);
+    TSMShape expandedSectionShape (end - start + 1);
     IPosition startPixel (startPixelInFirstTile_p);
     IPosition endPixel   (endPixelInFirstTile_p);
     IPosition tilePos    (startTile_p);
     IPosition tileIncr = 
       expandedTilesPerDim_p.offsetIncrement (nrTileSection_p);
-    IPosition dataLength(nrdim_p);
-    IPosition dataPos   (nrdim_p);
-    IPosition sectionPos(nrdim_p);
-    uInt dataOffset;
-    size_t sectionOffset;
     uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
 
     while (True) {
@@ -1046,73 +1123,149 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
         if (writeFlag) {
             cachePtr->setDirty();
         }
-
-        // At this point we start looping through all pixels in the tile.
-        // We do a vector at a time.
-        // Calculate the start and end pixel in the tile.
-        // Initialize the pixel position in the data and section.
-        for (i=0; i<nrdim_p; i++) {
-            dataLength(i) = 1 + endPixel(i) - startPixel(i);
-            dataPos(i)    = startPixel(i);
-            sectionPos(i) = tilePos(i) * tileShape_p(i)
-                            + startPixel(i) - startSection(i);
+        copyTileSection (dataArray, section, start, expandedSectionShape,
+                         tilePos, startPixel, endPixel,
+                         pixelOffset, localPixelSize, writeFlag);
+        // Determine the next tile to access and the starting and
+        // ending pixels in it.
+        if (! nextTile (tileNr, tilePos, startPixel, endPixel, tileIncr)) {
+            break;                                     // ready
         }
-        dataOffset = pixelOffset + localPixelSize *
-                            expandedTileShape_p.offset (startPixel);
-        sectionOffset = localPixelSize *
-                            expandedSectionShape.offset (sectionPos);
-        IPosition dataIncr    = localPixelSize *
-                            expandedTileShape_p.offsetIncrement (dataLength);
-        IPosition sectionIncr = localPixelSize *
-                            expandedSectionShape.offsetIncrement (dataLength);
-        uInt localSize    = dataLength(0) * localPixelSize;
+    }
+}
 
-	// Find out if we should use a simple "do-loop" move instead of memcpy
-	// because memcpy is slow for small blocks.
-	TSMCube_FindMove (dataLength(0));
+void TSMCube::accessSectionPar (BucketCache* cachePtr,
+                                const IPosition& start, const IPosition& end,
+                                char* section, uInt pixelOffset,
+                                uInt localPixelSize, Bool writeFlag)
+{
+    // Handle as many tiles at a time as fit in the cache, but limit it
+    // to a few tiles per thread to limit the read buffer size.
+    uInt nthread = cachePtr->nThread();
+    uInt nbatch = min (cachePtr->cacheSize(), 4*nthread);
+    TSMShape expandedSectionShape (end - start + 1);
+    IPosition startPixel (startPixelInFirstTile_p);
+    IPosition endPixel   (endPixelInFirstTile_p);
+    IPosition tilePos    (startTile_p);
+    IPosition tileIncr = 
+      expandedTilesPerDim_p.offsetIncrement (nrTileSection_p);
+    uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
+    Block<uInt>      tileNrs    (nbatch);
+    Block<char*>     dataArrays (nbatch);
+    Block<IPosition> tilePositions (nbatch);
+    Block<IPosition> startPixels   (nbatch);
+    Block<IPosition> endPixels     (nbatch);
+    Bool more = True;
+    while (more) {
+        // Collect the next batch of tiles.
+        uInt nr = 0;
+        while (more  &&  nr < nbatch) {
+            tileNrs[nr]       = tileNr;
+            tilePositions[nr] = tilePos;
+            startPixels[nr]   = startPixel;
+            endPixels[nr]     = endPixel;
+            nr++;
+            more = nextTile (tileNr, tilePos, startPixel, endPixel, tileIncr);
+        }
+        // Read (and convert) the tiles not in the cache, whereafter
+        // the tiles are copied in parallel. They are disjoint, so each
+        // thread writes a different part of the section or tiles.
+        cachePtr->getBuckets (nr, tileNrs.storage(), dataArrays.storage(),
+                              writeFlag);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread)
+#endif
+        for (Int k=0; k<Int(nr); k++) {
+            copyTileSection (dataArrays[k], section, start,
+                             expandedSectionShape, tilePositions[k],
+                             startPixels[k], endPixels[k],
+                             pixelOffset, localPixelSize, writeFlag);
+        }
+    }
+}
 
-        while (True) {
-            if (writeFlag) {
-	      TSMCube_MoveData (dataArray+dataOffset, section+sectionOffset);
-            }else{
-	      TSMCube_MoveData (section+sectionOffset, dataArray+dataOffset);
-	    }
-            dataOffset    += localSize;
-            sectionOffset += localSize;
-            for (j=1; j<nrdim_p; j++) {
-                dataOffset    += dataIncr(j);
-                sectionOffset += sectionIncr(j);
-                if (++dataPos(j) <= endPixel(j)) {
-                    break;
-                }
-                dataPos(j) = startPixel(j);
-            }
-            if (j == nrdim_p) {
-                break;
-            }
+Bool TSMCube::nextTile (uInt& tileNr, IPosition& tilePos,
+                        IPosition& startPixel, IPosition& endPixel,
+                        const IPosition& tileIncr) const
+{
+    // We increase the tile position in a dimension.
+    uInt i;
+    for (i=0; i<nrdim_p; i++) {
+        tileNr += tileIncr(i);
+        startPixel(i) = 0;
+        if (++tilePos(i) < endTile_p(i)) {
+            break;                                 // not at last tile
         }
+        if (tilePos(i) == endTile_p(i)) {
+            endPixel(i) = endPixelInLastTile_p(i);   // last tile
+            break;
+        }
+        // Past last tile in this dimension.
+        // Reset start and end.
+        tilePos(i) = startTile_p(i);
+        startPixel(i) = startPixelInFirstTile_p(i);
+        endPixel(i)   = endPixelInFirstTile_p(i);
+    }
+    return i < nrdim_p;
+}
 
-        // Determine the next tile to access and the starting and
-        // ending pixels in it.
-        // We increase the tile position in a dimension.
-        for (i=0; i<nrdim_p; i++) {
-            tileNr += tileIncr(i);
-            startPixel(i) = 0;
-            if (++tilePos(i) < endTile_p(i)) {
-                break;                                 // not at last tile
-            }
-            if (tilePos(i) == endTile_p(i)) {
-                endPixel(i) = endPixelInLastTile_p(i);   // last tile
+void TSMCube::copyTileSection (char* dataArray, char* section,
+                               const IPosition& startSection,
+                               const TSMShape& expandedSectionShape,
+                               const IPosition& tilePos,
+                               const IPosition& startPixel,
+                               const IPosition& endPixel,
+                               uInt pixelOffset, uInt localPixelSize,
+                               Bool writeFlag) const
+{
+    // Find out if local size is a multiple of 4, so we can move as integers.
+    TSMCube_FindMult;
+    // At this point we start looping through all pixels in the tile.
+    // We do a vector at a time.
+    // Calculate the start and end pixel in the tile.
+    // Initialize the pixel position in the data and section.
+    IPosition dataLength(nrdim_p);
+    IPosition dataPos   (nrdim_p);
+    IPosition sectionPos(nrdim_p);
+    uInt i, j;
+    for (i=0; i<nrdim_p; i++) {
+        dataLength(i) = 1 + endPixel(i) - startPixel(i);
+        dataPos(i)    = startPixel(i);
+        sectionPos(i) = tilePos(i) * tileShape_p(i)
+                        + startPixel(i) - startSection(i);
+    }
+    uInt dataOffset = pixelOffset + localPixelSize *
+                        expandedTileShape_p.offset (startPixel);
+    size_t sectionOffset = localPixelSize *
+                        expandedSectionShape.offset (sectionPos);
+    IPosition dataIncr    = localPixelSize *
+                        expandedTileShape_p.offsetIncrement (dataLength);
+    IPosition sectionIncr = localPixelSize *
+                        expandedSectionShape.offsetIncrement (dataLength);
+    uInt localSize    = dataLength(0) * localPixelSize;
+
+    // Find out if we should use a simple "do-loop" move instead of memcpy
+    // because memcpy is slow for small blocks.
+    TSMCube_FindMove (dataLength(0));
+
+    while (True) {
+        if (writeFlag) {
+            TSMCube_MoveData (dataArray+dataOffset, section+sectionOffset);
+        }else{
+            TSMCube_MoveData (section+sectionOffset, dataArray+dataOffset);
+        }
+        dataOffset    += localSize;
+        sectionOffset += localSize;
+        for (j=1; j<nrdim_p; j++) {
+            dataOffset    += dataIncr(j);
+            sectionOffset += sectionIncr(j);
+            if (++dataPos(j) <= endPixel(j)) {
                 break;
             }
-            // Past last tile in this dimension.
-            // Reset start and end.
-            tilePos(i) = startTile_p(i);
-            startPixel(i) = startPixelInFirstTile_p(i);
-            endPixel(i)   = endPixelInFirstTile_p(i);
+            dataPos(j) = startPixel(j);
         }
-        if (i == nrdim_p) {
-            break;                                     // ready
+        if (j == nrdim_p) {
+            break;
         }
     }
 }
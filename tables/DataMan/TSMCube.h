@@ -32,6 +32,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/TSMShape.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
@@ -43,6 +44,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class TiledStMan;
 class TSMFile;
 class TSMColumn;
+class TSMCodecFile;
 class BucketCache;
 template<class T> class Block;
 
@@ -83,6 +85,12 @@ template<class T> class Block;
 // when accessed. The alternative would be to hold it in the cache in
 // local format and convert it when read/written from the file. It was
 // felt that the latter approach would generate more needless conversions.
+// <br>
+// The tiles can be compressed losslessly using a
+// <linkto class=TSMCodec>TSMCodec</linkto>. In that case the tiles have a
+// variable length and are accessed by the cache via a
+// <linkto class=TSMCodecFile>TSMCodecFile</linkto> object. The file offset
+// and length of each tile is kept in an index written with the hypercube.
 // <p>
 // The possible id and coordinate values are stored in a Record
 // object. They are written in the main hypercube AipsIO file.
@@ -171,6 +179,9 @@ public:
     // Get the length of a tile in local format.
     uInt localTileLength() const;
 
+    // Get the codec used to compress the tiles.
+    TSMCodec::Type codec() const;
+
     // Set the hypercube shape.
     // This is only possible if the shape was not defined yet.
     virtual void setShape (const IPosition& cubeShape,
@@ -302,6 +313,10 @@ protected:
     // if nrdim_p changes value.
     void resizeTileSections();
 
+    // Resize the index of compressed tiles to the number of tiles.
+    // New tiles get length 0 (meaning not written yet).
+    void resizeTileIndex();
+
 private:
     // Forbid copy constructor.
     TSMCube (const TSMCube&);
@@ -322,6 +337,31 @@ private:
     // Delete the cache object.
     virtual void deleteCache();
 
+    // Access a section using multiple threads.
+    // The tiles are processed in batches. The tiles in a batch are
+    // read and converted by the cache, whereafter the data are copied
+    // in parallel.
+    void accessSectionPar (BucketCache* cachePtr,
+                           const IPosition& start, const IPosition& end,
+                           char* section, uInt pixelOffset,
+                           uInt localPixelSize, Bool writeFlag);
+
+    // Go to the next tile in a section and set its start and end pixel.
+    // It returns False if all tiles have been done.
+    Bool nextTile (uInt& tileNr, IPosition& tilePos,
+                   IPosition& startPixel, IPosition& endPixel,
+                   const IPosition& tileIncr) const;
+
+    // Copy the part of the section contained in the given tile.
+    void copyTileSection (char* dataArray, char* section,
+                          const IPosition& startSection,
+                          const TSMShape& expandedSectionShape,
+                          const IPosition& tilePos,
+                          const IPosition& startPixel,
+                          const IPosition& endPixel,
+                          uInt pixelOffset, uInt localPixelSize,
+                          Bool writeFlag) const;
+
     // Access a line in a more optimized way.
     void accessLine (char* section, uInt pixelOffset,
 		     uInt localPixelSize,
@@ -398,6 +438,15 @@ protected:
     AccessType      lastColAccess_p;
     // The slice shape of the last column access to a slice.
     IPosition       lastColSlice_p;
+    // The codec used to compress the tiles.
+    TSMCodec::Type  codec_p;
+    // The size of the basic data type of each data column (used by codec).
+    Block<uInt>     codecElemSize_p;
+    // The file offset and length of each compressed tile.
+    Block<Int64>    tileOffset_p;
+    Block<uInt>     tileLength_p;
+    // The object used by the cache to access compressed tiles.
+    TSMCodecFile*   codecFile_p;
 
     // IPosition variables used in accessSection(); declared here
     // as member variables to avoid significant construction and
@@ -433,6 +482,10 @@ inline uInt TSMCube::localTileLength() const
 { 
     return localTileLength_p;
 }
+inline TSMCodec::Type TSMCube::codec() const
+{
+    return codec_p;
+}
 inline const IPosition& TSMCube::cubeShape() const
 { 
     return cubeShape_p;
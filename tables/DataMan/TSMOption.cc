@@ -31,10 +31,12 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   TSMOption::TSMOption (TSMOption::Option option, Int bufferSize,
-                        Int maxCacheSizeMB)
+                        Int maxCacheSizeMB, Int nPrefetch, Int nThread)
     : itsOption       (option),
       itsBufferSize   (bufferSize),
-      itsMaxCacheSize (maxCacheSizeMB)
+      itsMaxCacheSize (maxCacheSizeMB),
+      itsPrefetch     (nPrefetch),
+      itsNThread      (nThread)
   {}
 
   void TSMOption::fillOption (Bool newTable)
@@ -67,6 +69,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (itsMaxCacheSize <= -2) {
       AipsrcValue<Int>::find (itsMaxCacheSize, "table.tsm.maxcachesizemb", -1);
     }
+    // Default is no prefetching.
+    if (itsPrefetch <= -2) {
+      AipsrcValue<Int>::find (itsPrefetch, "table.tsm.prefetch", 0);
+    }
+    // Default is a single thread.
+    if (itsNThread <= -2) {
+      AipsrcValue<Int>::find (itsNThread, "table.tsm.nthreads", 1);
+    }
     // Default is to use the old caching behaviour
     // Abandoned default to use mmap for existing files on 64 bit systems.
     if (itsOption == TSMOption::Default) {
@@ -109,6 +109,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <li> <src>tables.tsm.buffersize</src> gives the buffer size for option
 //       <src>TSMOption::Buffer</src>. A value <=0 means use the default 4096.
 //       It defaults to 0.
+//  <li> <src>tables.tsm.prefetch</src> gives the number of buckets (tiles)
+//       to prefetch when the cache detects a sequential or strided access
+//       pattern. It is only used by option <src>TSMOption::Cache</src>
+//       and by the caches of the StandardStMan and IncrementalStMan.
+//       A value 0 means no prefetching. It defaults to 0.
+//  <li> <src>tables.tsm.nthreads</src> gives the number of threads to use
+//       for reading, converting and copying the tiles of a data slice.
+//       It is only used by option <src>TSMOption::Cache</src> and by the
+//       StandardStMan when reading a range of rows. It only
+//       has effect if casacore is built with OpenMP. It defaults to 1.
 // </ul>
 // </synopsis>
 
@@ -134,7 +144,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // The parameter values are described in the synopsis.
     // A size value -2 means reading that size from the aipsrc file.
     TSMOption (Option option=Aipsrc, Int bufferSize=-2,
-               Int maxCacheSizeMB=-2);
+               Int maxCacheSizeMB=-2, Int nPrefetch=-2, Int nThread=-2);
 
     // Fill the option in case Aipsrc or Default was given.
     // It is done as explained in the synopsis.
@@ -152,10 +162,20 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int maxCacheSizeMB() const
       { return itsMaxCacheSize; }
 
+    // Get the number of buckets to prefetch. A value <= 0 means none.
+    Int prefetch() const
+      { return itsPrefetch; }
+
+    // Get the number of threads to use. A value <= 0 means 1.
+    Int nThread() const
+      { return itsNThread; }
+
   private:
     Option itsOption;
     Int    itsBufferSize;
     Int    itsMaxCacheSize;
+    Int    itsPrefetch;
+    Int    itsNThread;
   };
 
 } //# NAMESPACE CASACORE - END
@@ -65,6 +65,9 @@ TiledCellStMan::TiledCellStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (TSMCodec::type (spec.asString ("TILECODEC")));
+    }
 }
 
 TiledCellStMan::~TiledCellStMan()
@@ -75,6 +78,7 @@ DataManager* TiledCellStMan::clone() const
     TiledCellStMan* smp = new TiledCellStMan (hypercolumnName_p,
 					      defaultTileShape_p,
 					      maximumCacheSize());
+    smp->setTileCodec (tileCodec_p);
     return smp;
 }
 
@@ -70,6 +70,9 @@ TiledColumnStMan::TiledColumnStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (TSMCodec::type (spec.asString ("TILECODEC")));
+    }
 }
 
 TiledColumnStMan::~TiledColumnStMan()
@@ -80,6 +83,7 @@ DataManager* TiledColumnStMan::clone() const
     TiledColumnStMan* smp = new TiledColumnStMan (hypercolumnName_p,
 						  tileShape_p,
 						  maximumCacheSize());
+    smp->setTileCodec (tileCodec_p);
     return smp;
 }
 
@@ -61,6 +61,9 @@ TiledDataStMan::TiledDataStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (TSMCodec::type (spec.asString ("TILECODEC")));
+    }
 }
 
 TiledDataStMan::~TiledDataStMan()
@@ -70,6 +73,7 @@ DataManager* TiledDataStMan::clone() const
 {
     TiledDataStMan* smp = new TiledDataStMan (hypercolumnName_p,
 					      maximumCacheSize());
+    smp->setTileCodec (tileCodec_p);
     return smp;
 }
 
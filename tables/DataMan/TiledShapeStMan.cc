@@ -76,6 +76,9 @@ TiledShapeStMan::TiledShapeStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (TSMCodec::type (spec.asString ("TILECODEC")));
+    }
 }
 
 TiledShapeStMan::~TiledShapeStMan()
@@ -86,6 +89,7 @@ DataManager* TiledShapeStMan::clone() const
     TiledShapeStMan* smp = new TiledShapeStMan (hypercolumnName_p,
 						defaultTileShape_p,
 						maximumCacheSize());
+    smp->setTileCodec (tileCodec_p);
     return smp;
 }
 
@@ -60,7 +60,8 @@ TiledStMan::TiledStMan ()
   maxCacheSize_p    (0),
   nrdim_p           (0),
   nrCoordVector_p   (0),
-  dataChanged_p     (False)
+  dataChanged_p     (False),
+  tileCodec_p       (TSMCodec::None)
 {}
 
 TiledStMan::TiledStMan (const String& hypercolumnName, uInt maximumCacheSize)
@@ -72,7 +73,8 @@ TiledStMan::TiledStMan (const String& hypercolumnName, uInt maximumCacheSize)
   maxCacheSize_p    (maximumCacheSize),
   nrdim_p           (0),
   nrCoordVector_p   (0),
-  dataChanged_p     (False)
+  dataChanged_p     (False),
+  tileCodec_p       (TSMCodec::None)
 {}
 
 TiledStMan::~TiledStMan()
@@ -289,6 +291,7 @@ Record TiledStMan::dataManagerSpec() const
     Record rec = getProperties();
     rec.define ("DEFAULTTILESHAPE", defaultTileShape().asVector());
     rec.define ("MAXIMUMCACHESIZE", Int(persMaxCacheSize_p));
+    rec.define ("TILECODEC", TSMCodec::name(tileCodec_p));
     Record subrec;
     Int nrrec=0;
     for (uInt i=0; i<cubeSet_p.nelements(); i++) {
@@ -518,6 +521,20 @@ uInt TiledStMan::getLengthOffset (uInt nrPixels, Block<uInt>& dataOffset,
     return length;
 }
 
+void TiledStMan::getElementSizes (Block<uInt>& elemSize) const
+{
+    uInt nrcol = dataCols_p.nelements();
+    elemSize.resize (nrcol);
+    for (uInt i=0; i<nrcol; i++) {
+        elemSize[i] = dataCols_p[i]->dataLength (1);
+        // Use the size of the real and imaginary part for complex numbers.
+        Int dtype = dataCols_p[i]->dataType();
+        if (dtype == TpComplex  ||  dtype == TpDComplex) {
+            elemSize[i] /= 2;
+        }
+    }
+}
+
 void TiledStMan::readTile (char* local,
 			   const Block<uInt>& localOffset,
 			   const char* external,
@@ -899,8 +916,22 @@ TSMCube* TiledStMan::makeHypercube (const IPosition& cubeShape,
     return makeTSMCube (fileSet_p[filenr], cubeShape, tileShape, values);
 }
 
+void TiledStMan::setCodecTsmOption()
+{
+    // Compressed tiles have a variable length, so they can only be
+    // accessed using the cache.
+    if (tileCodec_p != TSMCodec::None
+    &&  tsmOption().option() != TSMOption::Cache) {
+        setTsmOption (TSMOption (TSMOption::Cache, 0,
+                                 tsmOption().maxCacheSizeMB(),
+                                 tsmOption().prefetch(),
+                                 tsmOption().nThread()));
+    }
+}
+
 void TiledStMan::createFile (uInt index)
 {
+    setCodecTsmOption();
     TSMFile* file = new TSMFile (this, index, tsmOption(), multiFile());
     fileSet_p[index] = file;
 }
@@ -1034,7 +1065,11 @@ void TiledStMan::headerFilePut (AipsIO& headerFile, uInt nrCube)
     uInt i;
     // The endian switch is a new feature. So only put it if little endian
     // is used. In that way older software can read newer tables.
-    if (asBigEndian()) {
+    // Similarly, version 3 is only used if a tile codec is used.
+    if (tileCodec_p != TSMCodec::None) {
+        headerFile.putstart ("TiledStMan", 3);
+	headerFile << asBigEndian();
+    } else if (asBigEndian()) {
         headerFile.putstart ("TiledStMan", 1);
     } else {
         headerFile.putstart ("TiledStMan", 2);
@@ -1051,6 +1086,9 @@ void TiledStMan::headerFilePut (AipsIO& headerFile, uInt nrCube)
     }
     headerFile << hypercolumnName_p;
     headerFile << persMaxCacheSize_p;
+    if (tileCodec_p != TSMCodec::None) {
+        headerFile << Int(tileCodec_p);
+    }
     headerFile << nrdim_p;
     headerFile << uInt(fileSet_p.nelements());
     for (i=0; i<fileSet_p.nelements(); i++) {
@@ -1116,6 +1154,14 @@ void TiledStMan::headerFileGet (AipsIO& headerFile, uInt tabNrrow,
     headerFile >> hypercolumnName_p;
     headerFile >> persMaxCacheSize_p;
     maxCacheSize_p = persMaxCacheSize_p;
+    tileCodec_p = TSMCodec::None;
+    if (version >= 3) {
+        Int codec;
+        headerFile >> codec;
+        tileCodec_p = TSMCodec::Type(codec);
+    }
+    // The files and cubes have to be accessed with the correct option.
+    setCodecTsmOption();
     if (firstTime) {
 	// Setup the various things (i.e. initialize other variables).
 	setup (extraNdim);
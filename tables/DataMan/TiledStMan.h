@@ -32,6 +32,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
@@ -87,6 +88,12 @@ template<class T> class Vector;
 // data cells are consistent.
 // It also contains various data members and functions to make them
 // persistent by writing them into an AipsIO stream.
+// <p>
+// The tiles of new hypercubes can be compressed losslessly by setting
+// a tile codec (see <linkto class=TSMCodec>TSMCodec</linkto>) using
+// <src>setTileCodec</src> or field <src>TILECODEC</src> in the data manager
+// specification record. Because compressed tiles have a variable length,
+// <src>TSMOption::Cache</src> is always used for such a storage manager.
 // </synopsis> 
 
 // <motivation>
@@ -173,6 +180,13 @@ public:
     // Get the current maximum cache size (in bytes).
     uInt maximumCacheSize() const;
 
+    // Set the codec used to compress the tiles of new hypercubes.
+    // It has to be set before the storage manager is bound to a table.
+    void setTileCodec (TSMCodec::Type codec);
+
+    // Get the codec used to compress the tiles.
+    TSMCodec::Type tileCodec() const;
+
     // Get the current cache size (in buckets) for the hypercube in
     // the given row.
     uInt cacheSize (uInt rownr) const;
@@ -262,6 +276,10 @@ public:
 			  Block<uInt>& localOffset,
 			  uInt& localTileLength) const;
 
+    // Get for each data column the size of its basic data type in external
+    // format (e.g. 4 for Complex). It is used when compressing tiles.
+    void getElementSizes (Block<uInt>& elemSize) const;
+
     // Get the number of coordinate vectors.
     uInt nrCoordVector() const;
 
@@ -379,6 +397,9 @@ protected:
     // Set the persistent maximum cache size.
     void setPersMaxCacheSize (uInt nbytes);
 
+    // Use TSMOption::Cache if the tiles are compressed.
+    void setCodecTsmOption();
+
     // Get the bindings of the columns with the given names.
     // If bound, the pointer to the TSMColumn object is stored in the block.
     // If mustExist is True, an exception is thrown if the column
@@ -516,6 +537,8 @@ protected:
     IPosition fixedCellShape_p;
     // Has any data changed since the last flush?
     Bool      dataChanged_p;
+    // The codec to compress the tiles.
+    TSMCodec::Type tileCodec_p;
 
 private:
     // Forbid copy constructor.
@@ -529,6 +552,12 @@ private:
 inline uInt TiledStMan::maximumCacheSize() const
     { return maxCacheSize_p; }
 
+inline void TiledStMan::setTileCodec (TSMCodec::Type codec)
+    { tileCodec_p = codec; }
+
+inline TSMCodec::Type TiledStMan::tileCodec() const
+    { return tileCodec_p; }
+
 inline uInt TiledStMan::nrCoordVector() const
     { return nrCoordVector_p; }
 
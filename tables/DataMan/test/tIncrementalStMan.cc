@@ -34,6 +34,7 @@
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/DataMan/IncrementalStMan.h>
 #include <casacore/tables/DataMan/IncrStManAccessor.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/Cube.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -62,6 +63,7 @@ void c();
 void d();
 void e (uInt nrrow);
 void f();
+void g();
 
 int main (int argc, const char* argv[])
 {
@@ -81,6 +83,7 @@ int main (int argc, const char* argv[])
 	e (20);
 	a (nr, 0);
 	f();
+	g();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
 	return 1;
@@ -514,3 +517,64 @@ void f()
     arr2.put (12, arrrow12);
     b (removedRows);
 }
+
+// Check getting the values of cells given as a row vector or as slices.
+// Many small buckets are used, so the interval index spans many buckets.
+void checkCells (const Table& tab, Int changedRow)
+{
+    ScalarColumn<Int> scan(tab, "scan");
+    ScalarColumn<String> name(tab, "name");
+    uInt nrrow = tab.nrow();
+    // Sorted row numbers, reversed row numbers, and slices.
+    Vector<uInt> sorted(nrrow/3);
+    Vector<uInt> reversed(nrrow/3);
+    for (uInt i=0; i<sorted.nelements(); i++) {
+	sorted(i) = 3*i;
+	reversed(i) = nrrow - 1 - 3*i;
+    }
+    Vector<uInt> slices(6);
+    slices(0) = 5;   slices(1) = 400;   slices(2) = 5;
+    slices(3) = 401; slices(4) = nrrow-1; slices(5) = 1;
+    RefRows rowsArr[3] = {RefRows(sorted), RefRows(reversed),
+			  RefRows(slices, True)};
+    for (uInt j=0; j<3; j++) {
+	Vector<uInt> rows = rowsArr[j].convert();
+	Vector<Int> scans = scan.getColumnCells (rowsArr[j]);
+	Vector<String> names = name.getColumnCells (rowsArr[j]);
+	AlwaysAssertExit (scans.nelements() == rows.nelements());
+	for (uInt i=0; i<rows.nelements(); i++) {
+	    Int expScan = rows(i) / 7;
+	    if (Int(rows(i)) == changedRow) {
+		expScan = -1;
+	    }
+	    AlwaysAssertExit (scans(i) == expScan);
+	    AlwaysAssertExit (names(i) == "name" +
+			      String::toString(rows(i) / 13));
+	}
+    }
+}
+
+void g()
+{
+    {
+	TableDesc td;
+	td.addColumn (ScalarColumnDesc<Int>("scan"));
+	td.addColumn (ScalarColumnDesc<String>("name"));
+	SetupNewTable newtab("tIncrementalStMan_tmp.cells", td, Table::New);
+	IncrementalStMan sm1 ("ISM", 1000);
+	newtab.bindAll (sm1);
+	Table tab(newtab, 2000);
+	ScalarColumn<Int> scan(tab, "scan");
+	ScalarColumn<String> name(tab, "name");
+	for (uInt i=0; i<tab.nrow(); i++) {
+	    scan.put (i, i/7);
+	    name.put (i, "name" + String::toString(i/13));
+	}
+    }
+    Table tab("tIncrementalStMan_tmp.cells", Table::Update);
+    checkCells (tab, -1);
+    // Change a value, so the intervals change.
+    ScalarColumn<Int> scan(tab, "scan");
+    scan.put (702, -1);
+    checkCells (tab, 702);
+}
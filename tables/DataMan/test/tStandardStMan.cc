@@ -32,16 +32,22 @@
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/StandardStMan.h>
 #include <casacore/tables/DataMan/StandardStManAccessor.h>
+#include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayIter.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/sstream.h>
@@ -92,6 +98,15 @@ void info(const Table aTable);
 // put/putColumn cache test
 void putColumnTest();
 
+// get the column data using direct (memory-mapped) views
+void viewTest (Table::EndianFormat anEndian);
+
+// get row ranges of the columns using the given number of threads
+void rangeTest (uInt aNThread);
+
+// append rows in batches and put the values of the new rows at once
+void appendTest();
+
 int main (int argc, const char* argv[])
 {
     uInt aNr = 250;
@@ -108,6 +123,11 @@ int main (int argc, const char* argv[])
 	deleteAndRestore();
 	// 
 	putColumnTest();
+	viewTest        (Table::LocalEndian);
+	viewTest        (Table::BigEndian);
+	rangeTest       (1);
+	rangeTest       (4);
+	appendTest      ();
 	// delete middle Column
        	deleteColumn    ("Col-2");
 	// add a Bool Column Should fit in freed space
@@ -598,18 +618,193 @@ void putColumnTest()
   AlwaysAssertExit (ab(5) == 4);
 }
 
+void viewTest (Table::EndianFormat anEndian)
+{
+  {
+    TableDesc td("", "1", TableDesc::Scratch);
+    // The data of a view have to be aligned, so put Bool column last.
+    td.addColumn (ScalarColumnDesc<Double>("Col-3"));
+    td.addColumn (ScalarColumnDesc<Int>("Col-1"));
+    td.addColumn (ArrayColumnDesc<Float>("Col-4", IPosition(2,2,3),
+                                         ColumnDesc::Direct));
+    td.addColumn (ArrayColumnDesc<Int>("Col-5"));
+    td.addColumn (ScalarColumnDesc<Bool>("Col-2"));
+    SetupNewTable aNewTab("tStandardStMan_tmp.view", td, Table::New);
+    // Use a small bucket size, so multiple buckets are used.
+    StandardStMan aSm1 ("SSM", 512);
+    aNewTab.bindAll (aSm1);
+    Table aTable(aNewTab, 1000, False, anEndian);
+    ScalarColumn<Int>    aa(aTable,"Col-1");
+    ScalarColumn<Bool>   ab(aTable,"Col-2");
+    ScalarColumn<Double> ac(aTable,"Col-3");
+    ArrayColumn<Float>   ad(aTable,"Col-4");
+    Matrix<Float> arr(2,3);
+    indgen (arr);
+    for (uInt i=0; i<aTable.nrow(); i++) {
+      aa.put (i, i);
+      ab.put (i, i%3==0);
+      ac.put (i, i+0.5);
+      ad.put (i, arr + Float(i));
+    }
+  }
+  Table aTable("tStandardStMan_tmp.view");
+  ScalarColumn<Int>    aa(aTable,"Col-1");
+  ScalarColumn<Bool>   ab(aTable,"Col-2");
+  ScalarColumn<Double> ac(aTable,"Col-3");
+  ArrayColumn<Float>   ad(aTable,"Col-4");
+  ArrayColumn<Int>     ae(aTable,"Col-5");
+  // Views can only be made if the data are stored in the local format.
+  Bool aLocal = (anEndian == Table::LocalEndian  ||
+                 (anEndian == Table::BigEndian) == HostInfo::bigEndian());
+  // Iterate through the columns using the views.
+  Vector<Int> aIntView;
+  Vector<Double> aDoubleView;
+  Array<Float> anArrView;
+  uInt aNrView = 0;
+  uInt aRow = 0;
+  while (aRow < aTable.nrow()) {
+    if (! aa.getColumnView (aRow, aIntView)) {
+      break;
+    }
+    AlwaysAssertExit (aIntView.nelements() > 0);
+    AlwaysAssertExit (allEQ (aIntView, aa.getColumnRange
+                             (Slicer(IPosition(1,aRow),
+                                     IPosition(1,aIntView.nelements())))));
+    AlwaysAssertExit (ac.getColumnView (aRow, aDoubleView));
+    AlwaysAssertExit (aDoubleView(0) == aRow+0.5);
+    AlwaysAssertExit (ad.getColumnView (aRow, anArrView));
+    AlwaysAssertExit (anArrView.shape()[2] > 0);
+    AlwaysAssertExit (allEQ (anArrView, ad.getColumnRange
+                             (Slicer(IPosition(1,aRow),
+                                     IPosition(1,anArrView.shape()[2])))));
+    aRow += aIntView.nelements();
+    aNrView++;
+  }
+  AlwaysAssertExit (aRow == (aLocal ? aTable.nrow() : 0));
+  AlwaysAssertExit (aLocal == (aNrView > 1));
+  AlwaysAssertExit (aLocal == (aIntView.nelements() > 0));
+  // Bool and indirect array columns can never be accessed directly.
+  Vector<Bool> aBoolView;
+  AlwaysAssertExit (! ab.getColumnView (0, aBoolView));
+  AlwaysAssertExit (aBoolView.nelements() == 0);
+  Array<Int> anIntArrView;
+  AlwaysAssertExit (! ae.getColumnView (0, anIntArrView));
+  // A view cannot be made for a reference table.
+  Table aSel = aTable(aTable.nodeRownr() < 10);
+  ScalarColumn<Int> asa(aSel,"Col-1");
+  AlwaysAssertExit (! asa.getColumnView (0, aIntView));
+}
 
+void rangeTest (uInt aNThread)
+{
+  // Use the table created by viewTest.
+  Table aTable("tStandardStMan_tmp.view");
+  ROStandardStManAccessor anA(aTable,"SSM");
+  anA.setNThread (aNThread);
+  AlwaysAssertExit (anA.getNThread() == aNThread);
+  ScalarColumn<Int>    aa(aTable,"Col-1");
+  ScalarColumn<Bool>   ab(aTable,"Col-2");
+  ScalarColumn<Double> ac(aTable,"Col-3");
+  ArrayColumn<Float>   ad(aTable,"Col-4");
+  Matrix<Float> arr(2,3);
+  indgen (arr);
+  // Use ranges starting and ending in the middle of a bucket.
+  uInt aStart[] = {0, 3, 17, 500};
+  uInt aNr[]    = {1000, 990, 1, 321};
+  for (uInt j=0; j<4; j++) {
+    Slicer aSlicer(IPosition(1,aStart[j]), IPosition(1,aNr[j]));
+    Vector<Int> aInts = aa.getColumnRange (aSlicer);
+    Vector<Bool> aBools = ab.getColumnRange (aSlicer);
+    Vector<Double> aDoubles = ac.getColumnRange (aSlicer);
+    Array<Float> anArrs = ad.getColumnRange (aSlicer);
+    AlwaysAssertExit (anArrs.shape() == IPosition(3,2,3,aNr[j]));
+    ArrayIterator<Float> anIter(anArrs, 2);
+    for (uInt i=0; i<aNr[j]; i++) {
+      uInt aRow = aStart[j] + i;
+      AlwaysAssertExit (aInts(i) == Int(aRow));
+      AlwaysAssertExit (aBools(i) == (aRow%3==0));
+      AlwaysAssertExit (aDoubles(i) == aRow+0.5);
+      AlwaysAssertExit (allEQ (anIter.array(), arr + Float(aRow)));
+      anIter.next();
+    }
+  }
+  // Get rows given as a vector of row numbers.
+  Vector<uInt> aRows(3);
+  aRows(0) = 999; aRows(1) = 2; aRows(2) = 400;
+  Vector<Int> aInts = aa.getColumnCells (aRows);
+  for (uInt i=0; i<3; i++) {
+    AlwaysAssertExit (aInts(i) == Int(aRows(i)));
+  }
+  // Get entire columns.
+  AlwaysAssertExit (allEQ (aa.getColumn(),
+                           aa.getColumnRange (Slicer(IPosition(1,0),
+                                                     IPosition(1,1000)))));
+  Array<Float> anArrs = ad.getColumn();
+  AlwaysAssertExit (allEQ (anArrs[999], arr + Float(999)));
+}
 
-
-
-
-
-
-
-
-
-
-
-
-
-
+void appendTest()
+{
+  {
+    TableDesc td("", "1", TableDesc::Scratch);
+    td.addColumn (ScalarColumnDesc<Int>("Col-1"));
+    td.addColumn (ScalarColumnDesc<Bool>("Col-2"));
+    td.addColumn (ScalarColumnDesc<Double>("Col-3"));
+    td.addColumn (ArrayColumnDesc<Float>("Col-4", IPosition(2,2,3),
+                                         ColumnDesc::Direct));
+    SetupNewTable aNewTab("tStandardStMan_tmp.append", td, Table::New);
+    // Use a small bucket size, so a batch spans multiple buckets.
+    StandardStMan aSm1 ("SSM", 512);
+    aNewTab.bindAll (aSm1);
+    Table aTable(aNewTab);
+    ScalarColumn<Int>    aa(aTable,"Col-1");
+    ScalarColumn<Bool>   ab(aTable,"Col-2");
+    ScalarColumn<Double> ac(aTable,"Col-3");
+    ArrayColumn<Float>   ad(aTable,"Col-4");
+    Matrix<Float> arr(2,3);
+    indgen (arr);
+    // Add the rows in batches not matching the bucket boundaries.
+    uInt aBatch[] = {101, 3, 250, 646};
+    for (uInt j=0; j<4; j++) {
+      uInt aFirst = aTable.nrow();
+      aTable.addRow (aBatch[j]);
+      Vector<Int>    aInts(aBatch[j]);
+      Vector<Bool>   aBools(aBatch[j]);
+      Vector<Double> aDoubles(aBatch[j]);
+      Cube<Float>    anArrs(2,3,aBatch[j]);
+      for (uInt i=0; i<aBatch[j]; i++) {
+        uInt aRow = aFirst + i;
+        aInts(i)    = aRow;
+        aBools(i)   = (aRow%3==0);
+        aDoubles(i) = aRow+0.5;
+        anArrs.xyPlane(i) = arr + Float(aRow);
+      }
+      Slicer aSlicer(IPosition(1,aFirst), IPosition(1,aBatch[j]));
+      aa.putColumnRange (aSlicer, aInts);
+      ab.putColumnRange (aSlicer, aBools);
+      ac.putColumnRange (aSlicer, aDoubles);
+      ad.putColumnRange (aSlicer, anArrs);
+    }
+    // Rows given as a vector of row numbers are put one by one.
+    Vector<uInt> aRows(2);
+    aRows(0) = 998; aRows(1) = 5;
+    Vector<Int> aVals(2);
+    aVals(0) = -998; aVals(1) = -5;
+    aa.putColumnCells (aRows, aVals);
+  }
+  Table aTable("tStandardStMan_tmp.append");
+  AlwaysAssertExit (aTable.nrow() == 1000);
+  ScalarColumn<Int>    aa(aTable,"Col-1");
+  ScalarColumn<Bool>   ab(aTable,"Col-2");
+  ScalarColumn<Double> ac(aTable,"Col-3");
+  ArrayColumn<Float>   ad(aTable,"Col-4");
+  Matrix<Float> arr(2,3);
+  indgen (arr);
+  for (uInt i=0; i<aTable.nrow(); i++) {
+    Int aVal = (i==5 || i==998  ?  -Int(i) : Int(i));
+    AlwaysAssertExit (aa(i) == aVal);
+    AlwaysAssertExit (ab(i) == (i%3==0));
+    AlwaysAssertExit (ac(i) == i+0.5);
+    AlwaysAssertExit (allEQ (ad(i), arr + Float(i)));
+  }
+}
@@ -53,7 +53,8 @@
 
 
 // First build a description.
-void writeFixed (const TSMOption& tsmOpt)
+void writeFixed (const TSMOption& tsmOpt,
+                 TSMCodec::Type codec = TSMCodec::None)
 {
     cout << "WriteFixed ..." << endl;
     // Build the table description.
@@ -76,6 +77,7 @@ void writeFixed (const TSMOption& tsmOpt)
     // Create a storage manager for it.
     // Let the tile shape not fit integrally in the cube shape.
     TiledShapeStMan sm1 ("TSMExample", IPosition(2,5,6));
+    sm1.setTileCodec (codec);
     newtab.setShapeColumn ("Freq", IPosition(1,25));
     newtab.setShapeColumn ("Data", IPosition(2,16,25));
     newtab.setShapeColumn ("Flag", IPosition(2,16,25));
@@ -572,6 +574,13 @@ int main () {
 	readTable (IPosition(), TSMOption::Aipsrc);
 	writeNoHyper (TSMOption::Aipsrc);
 	readTable (IPosition(2,16,25), TSMOption::Default);
+        // Read using a prefetching cache and multiple threads.
+	readTable (IPosition(2,16,25), TSMOption(TSMOption::Cache, 0, 0, 4, 4));
+        // Write and read compressed tiles (always using the cache).
+        writeFixed (TSMOption::Buffer, TSMCodec::LZ);
+	readTable (IPosition(2,16,25), TSMOption::MMap);
+        writeFixed (TSMOption::Cache, TSMCodec::ShuffleLZ);
+	readTable (IPosition(2,16,25), TSMOption(TSMOption::Cache, 0, 0, 4, 4));
 
         writeFlags();
 
@@ -29,6 +29,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -39,11 +40,51 @@
 #include <casacore/casa/OS/Time.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Lock to serialize the column reads when an expression is evaluated by
+// multiple threads (the data managers are not thread-safe).
+// It has to be a nested lock, because reading a virtual column can
+// evaluate another expression.
+class TableExprNodeColumnLock
+{
+public:
+    TableExprNodeColumnLock()
+    {
+#ifdef _OPENMP
+        omp_set_nest_lock (theLock());
+#endif
+    }
+    ~TableExprNodeColumnLock()
+    {
+#ifdef _OPENMP
+        omp_unset_nest_lock (theLock());
+#endif
+    }
+private:
+#ifdef _OPENMP
+    static omp_nest_lock_t* theLock()
+    {
+        static omp_nest_lock_t* lock = makeLock();
+        return lock;
+    }
+    static omp_nest_lock_t* makeLock()
+    {
+        omp_nest_lock_t* lock = new omp_nest_lock_t;
+        omp_init_nest_lock (lock);
+        return lock;
+    }
+#endif
+};
+
+
 // Implement the constants for each data type.
 
 TableExprNodeConstBool::TableExprNodeConstBool (const Bool& val)
@@ -54,6 +95,15 @@ TableExprNodeConstBool::~TableExprNodeConstBool()
 {}
 Bool TableExprNodeConstBool::getBool (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstBool::getBools (const Vector<uInt>& rownrs,
+                                       Block<Bool>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    std::fill (result.storage(), result.storage() + nr, value_p);
+}
 
 TableExprNodeConstInt::TableExprNodeConstInt (const Int64& val)
 : TableExprNodeBinary (NTInt, VTScalar, OtLiteral, Table()),
@@ -67,6 +117,24 @@ Double TableExprNodeConstInt::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstInt::getDComplex (const TableExprId&)
     { return double(value_p); }
+void TableExprNodeConstInt::getInts (const Vector<uInt>& rownrs,
+                                     Block<Int64>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    std::fill (result.storage(), result.storage() + nr, value_p);
+}
+void TableExprNodeConstInt::getDoubles (const Vector<uInt>& rownrs,
+                                        Block<Double>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    std::fill (result.storage(), result.storage() + nr, Double(value_p));
+}
 
 TableExprNodeConstDouble::TableExprNodeConstDouble (const Double& val)
 : TableExprNodeBinary (NTDouble, VTScalar, OtLiteral, Table()),
@@ -78,6 +146,15 @@ Double TableExprNodeConstDouble::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstDouble::getDComplex (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstDouble::getDoubles (const Vector<uInt>& rownrs,
+                                           Block<Double>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    std::fill (result.storage(), result.storage() + nr, value_p);
+}
 
 TableExprNodeConstDComplex::TableExprNodeConstDComplex (const DComplex& val)
 : TableExprNodeBinary (NTComplex, VTScalar, OtLiteral, Table()),
@@ -207,34 +284,125 @@ const TableColumn& TableExprNodeColumn::getColumn() const
 Bool TableExprNodeColumn::getBool (const TableExprId& id)
 {
     Bool val;
+    TableExprNodeColumnLock lock;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 Int64 TableExprNodeColumn::getInt (const TableExprId& id)
 {
     Int64 val;
+    TableExprNodeColumnLock lock;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 Double TableExprNodeColumn::getDouble (const TableExprId& id)
 {
     Double val;
+    TableExprNodeColumnLock lock;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 DComplex TableExprNodeColumn::getDComplex (const TableExprId& id)
 {
     DComplex val;
+    TableExprNodeColumnLock lock;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 String TableExprNodeColumn::getString (const TableExprId& id)
 {
     String val;
+    TableExprNodeColumnLock lock;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 
+// Read the values in the given rows of a column with data type T
+// and convert them to the result type R.
+template<typename T, typename R>
+void TableExprNodeColumn_getCells (const TableColumn& tabCol,
+                                   const Vector<uInt>& rownrs,
+                                   Block<R>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    Vector<T> vals;
+    {
+        TableExprNodeColumnLock lock;
+        ScalarColumn<T> col(tabCol);
+        col.getColumnCells (RefRows(rownrs, False, True), vals, True);
+    }
+    const T* data = vals.data();
+    R* res = result.storage();
+    for (uInt i=0; i<nr; i++) {
+        res[i] = R(data[i]);
+    }
+}
+
+void TableExprNodeColumn::getBools (const Vector<uInt>& rownrs,
+                                    Block<Bool>& result)
+{
+    if (tabCol_p.columnDesc().dataType() == TpBool) {
+        TableExprNodeColumn_getCells<Bool> (tabCol_p, rownrs, result);
+    } else {
+        TableExprNodeBinary::getBools (rownrs, result);
+    }
+}
+void TableExprNodeColumn::getInts (const Vector<uInt>& rownrs,
+                                   Block<Int64>& result)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        TableExprNodeColumn_getCells<uChar> (tabCol_p, rownrs, result);
+        break;
+    case TpShort:
+        TableExprNodeColumn_getCells<Short> (tabCol_p, rownrs, result);
+        break;
+    case TpUShort:
+        TableExprNodeColumn_getCells<uShort> (tabCol_p, rownrs, result);
+        break;
+    case TpInt:
+        TableExprNodeColumn_getCells<Int> (tabCol_p, rownrs, result);
+        break;
+    case TpUInt:
+        TableExprNodeColumn_getCells<uInt> (tabCol_p, rownrs, result);
+        break;
+    default:
+        TableExprNodeBinary::getInts (rownrs, result);
+    }
+}
+void TableExprNodeColumn::getDoubles (const Vector<uInt>& rownrs,
+                                      Block<Double>& result)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        TableExprNodeColumn_getCells<uChar> (tabCol_p, rownrs, result);
+        break;
+    case TpShort:
+        TableExprNodeColumn_getCells<Short> (tabCol_p, rownrs, result);
+        break;
+    case TpUShort:
+        TableExprNodeColumn_getCells<uShort> (tabCol_p, rownrs, result);
+        break;
+    case TpInt:
+        TableExprNodeColumn_getCells<Int> (tabCol_p, rownrs, result);
+        break;
+    case TpUInt:
+        TableExprNodeColumn_getCells<uInt> (tabCol_p, rownrs, result);
+        break;
+    case TpFloat:
+        TableExprNodeColumn_getCells<Float> (tabCol_p, rownrs, result);
+        break;
+    case TpDouble:
+        TableExprNodeColumn_getCells<Double> (tabCol_p, rownrs, result);
+        break;
+    default:
+        TableExprNodeBinary::getDoubles (rownrs, result);
+    }
+}
+
 Bool TableExprNodeColumn::getColumnDataType (DataType& dt) const
 {
     dt = tabCol_p.columnDesc().dataType();
@@ -310,6 +478,28 @@ Int64 TableExprNodeRownr::getInt (const TableExprId& id)
     AlwaysAssert (id.byRow(), AipsError);
     return id.rownr() + origin_p;
 }
+void TableExprNodeRownr::getInts (const Vector<uInt>& rownrs,
+                                  Block<Int64>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    for (uInt i=0; i<nr; i++) {
+        result[i] = Int64(rownrs[i]) + origin_p;
+    }
+}
+void TableExprNodeRownr::getDoubles (const Vector<uInt>& rownrs,
+                                     Block<Double>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    for (uInt i=0; i<nr; i++) {
+        result[i] = Double(rownrs[i]) + origin_p;
+    }
+}
 
 
 
@@ -78,6 +78,7 @@ public:
     TableExprNodeConstBool (const Bool& value);
     ~TableExprNodeConstBool();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 private:
     Bool value_p;
 };
@@ -110,6 +111,8 @@ public:
     ~TableExprNodeConstInt();
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
+    void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
     DComplex getDComplex (const TableExprId& id);
 private:
     Int64 value_p;
@@ -142,6 +145,7 @@ public:
     TableExprNodeConstDouble (const Double& value);
     ~TableExprNodeConstDouble();
     Double   getDouble   (const TableExprId& id);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
     DComplex getDComplex (const TableExprId& id);
 private:
     Double value_p;
@@ -322,6 +326,12 @@ public:
     String   getString   (const TableExprId& id);
     const TableColumn& getColumn() const;
 
+    // Get the data for the given rows.
+    // All values are read at once using getColumnCells.
+    void getBools   (const Vector<uInt>& rownrs, Block<Bool>& result);
+    void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
+
     // Get the data for the given rows.
     Array<Bool>     getColumnBool (const Vector<uInt>& rownrs);
     Array<uChar>    getColumnuChar (const Vector<uInt>& rownrs);
@@ -373,6 +383,8 @@ public:
     TableExprNodeRownr (const Table&, uInt origin);
     ~TableExprNodeRownr();
     Int64  getInt (const TableExprId& id);
+    void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 private:
     uInt origin_p;
 };
@@ -283,6 +283,66 @@ const IPosition& TableExprFuncNodeArray::getAlternate (const TableExprId& id)
 }
 
 Array<Bool> TableExprFuncNodeArray::getArrayBool (const TableExprId& id)
+{
+  Array<Bool> res;
+  if (! getCached (id, res)) {
+    res.reference (calcArrayBool (id));
+    setCached (id, res);
+  }
+  return res;
+}
+
+Array<Int64> TableExprFuncNodeArray::getArrayInt (const TableExprId& id)
+{
+  Array<Int64> res;
+  if (! getCached (id, res)) {
+    res.reference (calcArrayInt (id));
+    setCached (id, res);
+  }
+  return res;
+}
+
+Array<Double> TableExprFuncNodeArray::getArrayDouble (const TableExprId& id)
+{
+  Array<Double> res;
+  if (! getCached (id, res)) {
+    res.reference (calcArrayDouble (id));
+    setCached (id, res);
+  }
+  return res;
+}
+
+Array<DComplex> TableExprFuncNodeArray::getArrayDComplex (const TableExprId& id)
+{
+  Array<DComplex> res;
+  if (! getCached (id, res)) {
+    res.reference (calcArrayDComplex (id));
+    setCached (id, res);
+  }
+  return res;
+}
+
+Array<String> TableExprFuncNodeArray::getArrayString (const TableExprId& id)
+{
+  Array<String> res;
+  if (! getCached (id, res)) {
+    res.reference (calcArrayString (id));
+    setCached (id, res);
+  }
+  return res;
+}
+
+Array<MVTime> TableExprFuncNodeArray::getArrayDate (const TableExprId& id)
+{
+  Array<MVTime> res;
+  if (! getCached (id, res)) {
+    res.reference (calcArrayDate (id));
+    setCached (id, res);
+  }
+  return res;
+}
+
+Array<Bool> TableExprFuncNodeArray::calcArrayBool (const TableExprId& id)
 {
     switch (funcType()) {
     case TableExprFuncNode::near2FUNC:
@@ -575,7 +635,7 @@ Array<Bool> TableExprFuncNodeArray::getArrayBool (const TableExprId& id)
     return Array<Bool>();
 }
 
-Array<Int64> TableExprFuncNodeArray::getArrayInt (const TableExprId& id)
+Array<Int64> TableExprFuncNodeArray::calcArrayInt (const TableExprId& id)
 {
     switch (funcType()) {
     case TableExprFuncNode::squareFUNC:
@@ -897,7 +957,7 @@ Array<Int64> TableExprFuncNodeArray::getArrayInt (const TableExprId& id)
     return Array<Int64>();
 }
 
-Array<Double> TableExprFuncNodeArray::getArrayDouble (const TableExprId& id)
+Array<Double> TableExprFuncNodeArray::calcArrayDouble (const TableExprId& id)
 {
     if (dataType() == NTInt) {
 	return TableExprNodeArray::getArrayDouble (id);
@@ -1414,7 +1474,7 @@ Array<Double> TableExprFuncNodeArray::getArrayDouble (const TableExprId& id)
     return Array<Double>();
 }
 
-Array<DComplex> TableExprFuncNodeArray::getArrayDComplex
+Array<DComplex> TableExprFuncNodeArray::calcArrayDComplex
                                                      (const TableExprId& id)
 {
     if (dataType() == NTDouble) {
@@ -1687,7 +1747,7 @@ Array<DComplex> TableExprFuncNodeArray::getArrayDComplex
     return Array<DComplex>();
 }
 
-Array<String> TableExprFuncNodeArray::getArrayString (const TableExprId& id)
+Array<String> TableExprFuncNodeArray::calcArrayString (const TableExprId& id)
 {
     switch (funcType()) {
     case TableExprFuncNode::upcaseFUNC:
@@ -2059,7 +2119,7 @@ Array<String> TableExprFuncNodeArray::getArrayString (const TableExprId& id)
     return Array<String>();
 }
 
-Array<MVTime> TableExprFuncNodeArray::getArrayDate (const TableExprId& id)
+Array<MVTime> TableExprFuncNodeArray::calcArrayDate (const TableExprId& id)
 {
     switch (funcType()) {
     case TableExprFuncNode::datetimeFUNC:
@@ -126,6 +126,17 @@ protected:
     // </group>
 
 private:
+    // Calculate the result of the function.
+    // The getArray functions cache it if caching is enabled.
+    // <group>
+    Array<Bool> calcArrayBool (const TableExprId& id);
+    Array<Int64> calcArrayInt (const TableExprId& id);
+    Array<Double> calcArrayDouble (const TableExprId& id);
+    Array<DComplex> calcArrayDComplex (const TableExprId& id);
+    Array<String> calcArrayString (const TableExprId& id);
+    Array<MVTime> calcArrayDate (const TableExprId& id);
+    // </group>
+
     // Set unit scale factor (needed for sqrt).
     void setScale (Double scale)
         { node_p.setScale (scale); }
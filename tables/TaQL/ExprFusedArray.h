@@ -0,0 +1,151 @@
+//# ExprFusedArray.h: Fused evaluation of array arithmetic in an expression
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef TABLES_EXPRFUSEDARRAY_H
+#define TABLES_EXPRFUSEDARRAY_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Fused evaluation of array arithmetic in a table expression
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tExprNode.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNodeRep
+//   <li> TableExprNodeArray
+// </prerequisite>
+
+// <synopsis>
+// An expression like <src>DATA*2 + MODEL_DATA/3</src> on array columns
+// is evaluated by the expression tree node by node. Each arithmetic node
+// creates a temporary array holding its result, which is only used by
+// its parent node.
+// <br>TableExprFusedArray compiles a subtree of array arithmetic nodes
+// (+, -, *, /, and unary -) into a small postfix program.
+// The leaves of the subtree (e.g. columns, functions, constants) are
+// evaluated in the normal way, but the arithmetic is done element by
+// element by the program in a single pass over the arrays.
+// It is done in chunks of elements using a small stack of buffers,
+// so no temporary arrays are needed for the intermediate results.
+// <p>
+// The program is compiled at the first evaluation, so the expression
+// tree is complete by then. A subtree containing a single operation is
+// not compiled, because fusing has no advantage for it. Also if the
+// arrays in the leaves have different shapes, the normal evaluation is
+// used (which gives the appropriate exception).
+// <p>
+// The template parameter has to be Double or DComplex, the data types
+// used for arithmetic in TaQL.
+// <br>Note that compiling at the first evaluation is not thread-safe.
+// That is no problem, because array expressions are always evaluated
+// by a single thread (see TableExprNodeRep::isThreadSafe).
+// </synopsis>
+
+// <motivation>
+// Avoiding temporary arrays makes the evaluation of array expressions
+// considerably faster, in particular for large arrays like visibility data.
+// </motivation>
+
+template<typename T>
+class TableExprFusedArray
+{
+public:
+    TableExprFusedArray();
+
+    // Evaluate the subtree with the given node as root.
+    // It returns False if fused evaluation is not possible or not useful;
+    // the node should then be evaluated in the normal way.
+    Bool eval (TableExprNodeRep* node, const TableExprId& id,
+               Array<T>& result);
+
+private:
+    // The operations in the program.
+    enum OpCode {
+      PushArray,
+      PushScalar,
+      Plus,
+      Minus,
+      Times,
+      Divide,
+      Negate
+    };
+
+    // Compile the subtree rooted at the node.
+    void compile (TableExprNodeRep* node, uInt depth);
+
+    // Test if the node is an arithmetic array node with the right type.
+    static Bool isFusable (const TableExprNodeRep* node);
+
+    // Get the value of a leaf node.
+    // <group>
+    static void getArray (TableExprNodeRep* node, const TableExprId& id,
+                          Array<Double>& value);
+    static void getArray (TableExprNodeRep* node, const TableExprId& id,
+                          Array<DComplex>& value);
+    static void getScalar (TableExprNodeRep* node, const TableExprId& id,
+                           Double& value);
+    static void getScalar (TableExprNodeRep* node, const TableExprId& id,
+                           DComplex& value);
+    // </group>
+
+    // Forbid copy constructor and assignment.
+    // <group>
+    TableExprFusedArray (const TableExprFusedArray<T>&);
+    TableExprFusedArray<T>& operator= (const TableExprFusedArray<T>&);
+    // </group>
+
+    //# Data members
+    Bool                           compiled_p;
+    std::vector<Int>               opcodes_p;
+    std::vector<uInt>              operands_p;   //# leaf index for a push
+    std::vector<TableExprNodeRep*> arrayLeaves_p;
+    std::vector<TableExprNodeRep*> scalarLeaves_p;
+    uInt                           nops_p;       //# nr of arithmetic ops
+    uInt                           depth_p;      //# max stack depth
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/tables/TaQL/ExprFusedArray.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
@@ -0,0 +1,269 @@
+//# ExprFusedArray.tcc: Fused evaluation of array arithmetic in an expression
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_EXPRFUSEDARRAY_TCC
+#define TABLES_EXPRFUSEDARRAY_TCC
+
+//# Includes
+#include <casacore/tables/TaQL/ExprFusedArray.h>
+#include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <functional>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// Apply an operator to the values in a chunk.
+// One of the operands can be a scalar.
+template<typename T, typename OP>
+inline void TableExprFusedArray_apply (const T* left, Bool leftScalar,
+                                       const T* right, Bool rightScalar,
+                                       T* out, size_t n, OP op)
+{
+  if (leftScalar) {
+    T lval = *left;
+    for (size_t i=0; i<n; ++i) {
+      out[i] = op(lval, right[i]);
+    }
+  } else if (rightScalar) {
+    T rval = *right;
+    for (size_t i=0; i<n; ++i) {
+      out[i] = op(left[i], rval);
+    }
+  } else {
+    for (size_t i=0; i<n; ++i) {
+      out[i] = op(left[i], right[i]);
+    }
+  }
+}
+
+
+template<typename T>
+TableExprFusedArray<T>::TableExprFusedArray()
+: compiled_p (False),
+  nops_p     (0),
+  depth_p    (0)
+{}
+
+template<typename T>
+Bool TableExprFusedArray<T>::isFusable (const TableExprNodeRep* node)
+{
+  if (node->valueType() != TableExprNodeRep::VTArray) {
+    return False;
+  }
+  TableExprNodeRep::NodeDataType dtype = TableExprNodeRep::NTDouble;
+  if (whatType(static_cast<T*>(0)) == TpDComplex) {
+    dtype = TableExprNodeRep::NTComplex;
+  }
+  if (node->dataType() != dtype) {
+    return False;
+  }
+  switch (node->operType()) {
+  case TableExprNodeRep::OtPlus:
+  case TableExprNodeRep::OtMinus:
+  case TableExprNodeRep::OtTimes:
+  case TableExprNodeRep::OtDivide:
+  case TableExprNodeRep::OtMIN:
+    return dynamic_cast<const TableExprNodeArray*>(node) != 0;
+  default:
+    break;
+  }
+  return False;
+}
+
+template<typename T>
+void TableExprFusedArray<T>::compile (TableExprNodeRep* node, uInt depth)
+{
+  depth_p = std::max (depth_p, depth);
+  if (! isFusable(node)) {
+    if (node->valueType() == TableExprNodeRep::VTArray) {
+      opcodes_p.push_back (PushArray);
+      operands_p.push_back (arrayLeaves_p.size());
+      arrayLeaves_p.push_back (node);
+    } else {
+      opcodes_p.push_back (PushScalar);
+      operands_p.push_back (scalarLeaves_p.size());
+      scalarLeaves_p.push_back (node);
+    }
+    return;
+  }
+  const TableExprNodeBinary* bnode =
+    static_cast<const TableExprNodeBinary*>(node);
+  compile (const_cast<TableExprNodeRep*>(bnode->getLeftChild()), depth);
+  Int opcode = Negate;
+  switch (node->operType()) {
+  case TableExprNodeRep::OtPlus:
+    opcode = Plus;
+    break;
+  case TableExprNodeRep::OtMinus:
+    opcode = Minus;
+    break;
+  case TableExprNodeRep::OtTimes:
+    opcode = Times;
+    break;
+  case TableExprNodeRep::OtDivide:
+    opcode = Divide;
+    break;
+  default:
+    break;
+  }
+  if (opcode != Negate) {
+    compile (const_cast<TableExprNodeRep*>(bnode->getRightChild()), depth+1);
+  }
+  opcodes_p.push_back (opcode);
+  operands_p.push_back (0);
+  nops_p++;
+}
+
+template<typename T>
+void TableExprFusedArray<T>::getArray (TableExprNodeRep* node,
+                                       const TableExprId& id,
+                                       Array<Double>& value)
+  { value.reference (node->getArrayDouble (id)); }
+template<typename T>
+void TableExprFusedArray<T>::getArray (TableExprNodeRep* node,
+                                       const TableExprId& id,
+                                       Array<DComplex>& value)
+  { value.reference (node->getArrayDComplex (id)); }
+template<typename T>
+void TableExprFusedArray<T>::getScalar (TableExprNodeRep* node,
+                                        const TableExprId& id,
+                                        Double& value)
+  { value = node->getDouble (id); }
+template<typename T>
+void TableExprFusedArray<T>::getScalar (TableExprNodeRep* node,
+                                        const TableExprId& id,
+                                        DComplex& value)
+  { value = node->getDComplex (id); }
+
+template<typename T>
+Bool TableExprFusedArray<T>::eval (TableExprNodeRep* node,
+                                   const TableExprId& id,
+                                   Array<T>& result)
+{
+  if (! compiled_p) {
+    compile (node, 1);
+    compiled_p = True;
+  }
+  // A single operation is done faster by the normal evaluation.
+  if (nops_p < 2) {
+    return False;
+  }
+  // Evaluate the leaves. All arrays must have the same shape.
+  uInt narr = arrayLeaves_p.size();
+  std::vector<Array<T> > arrays(narr);
+  for (uInt i=0; i<narr; ++i) {
+    getArray (arrayLeaves_p[i], id, arrays[i]);
+    if (! arrays[i].shape().isEqual (arrays[0].shape())) {
+      return False;
+    }
+  }
+  std::vector<T> scalars(scalarLeaves_p.size());
+  for (uInt i=0; i<scalars.size(); ++i) {
+    getScalar (scalarLeaves_p[i], id, scalars[i]);
+  }
+  std::vector<const T*> data(narr);
+  Block<Bool> deleteData(narr);
+  for (uInt i=0; i<narr; ++i) {
+    data[i] = arrays[i].getStorage (deleteData[i]);
+  }
+  result.resize (arrays[0].shape());
+  Bool deleteRes;
+  T* res = result.getStorage (deleteRes);
+  // Run the program on chunks of values. The stack holds pointers to the
+  // operands; intermediate results are stored in a buffer per stack level.
+  // The last operation writes directly into the result.
+  const size_t chunkSize = 256;
+  std::vector<T> buffer(depth_p * chunkSize);
+  std::vector<const T*> stack(depth_p);
+  std::vector<Bool> isScalar(depth_p);
+  uInt nprog = opcodes_p.size();
+  size_t nelem = result.nelements();
+  for (size_t st=0; st<nelem; st+=chunkSize) {
+    size_t n = std::min (chunkSize, nelem-st);
+    Int sp = -1;
+    T* out = 0;
+    for (uInt i=0; i<nprog; ++i) {
+      switch (opcodes_p[i]) {
+      case PushArray:
+        ++sp;
+        stack[sp] = data[operands_p[i]] + st;
+        isScalar[sp] = False;
+        continue;
+      case PushScalar:
+        ++sp;
+        stack[sp] = &(scalars[operands_p[i]]);
+        isScalar[sp] = True;
+        continue;
+      case Negate:
+        out = (i == nprog-1  ?  res+st : &(buffer[0]) + sp*chunkSize);
+        for (size_t j=0; j<n; ++j) {
+          out[j] = -stack[sp][isScalar[sp] ? 0 : j];
+        }
+        break;
+      default:
+        --sp;
+        out = (i == nprog-1  ?  res+st : &(buffer[0]) + sp*chunkSize);
+        switch (opcodes_p[i]) {
+        case Plus:
+          TableExprFusedArray_apply (stack[sp], isScalar[sp],
+                                     stack[sp+1], isScalar[sp+1],
+                                     out, n, std::plus<T>());
+          break;
+        case Minus:
+          TableExprFusedArray_apply (stack[sp], isScalar[sp],
+                                     stack[sp+1], isScalar[sp+1],
+                                     out, n, std::minus<T>());
+          break;
+        case Times:
+          TableExprFusedArray_apply (stack[sp], isScalar[sp],
+                                     stack[sp+1], isScalar[sp+1],
+                                     out, n, std::multiplies<T>());
+          break;
+        default:
+          TableExprFusedArray_apply (stack[sp], isScalar[sp],
+                                     stack[sp+1], isScalar[sp+1],
+                                     out, n, std::divides<T>());
+          break;
+        }
+      }
+      stack[sp] = out;
+      isScalar[sp] = False;
+    }
+  }
+  result.putStorage (res, deleteRes);
+  for (uInt i=0; i<narr; ++i) {
+    arrays[i].freeStorage (data[i], deleteData[i]);
+  }
+  return True;
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
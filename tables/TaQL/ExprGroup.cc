@@ -34,6 +34,7 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <limits>
+#include <cstring>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -70,6 +71,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     case TableExprNodeRep::NTInt:
       return itsInt64 == that.itsInt64;
     case TableExprNodeRep::NTDouble:
+    case TableExprNodeRep::NTDate:
       return itsDouble == that.itsDouble;
     default:
       return itsString == that.itsString;
@@ -84,6 +86,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     case TableExprNodeRep::NTInt:
       return itsInt64 < that.itsInt64;
     case TableExprNodeRep::NTDouble:
+    case TableExprNodeRep::NTDate:
       return itsDouble < that.itsDouble;
     default:
       return itsString < that.itsString;
@@ -91,6 +94,44 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  uInt TableExprGroupKey::hash() const
+  {
+    switch (itsDT) {
+    case TableExprNodeRep::NTBool:
+      return itsBool ? 1 : 0;
+    case TableExprNodeRep::NTInt:
+      return TableExprGroupHash<Int64>::hashKey (itsInt64);
+    case TableExprNodeRep::NTDouble:
+    case TableExprNodeRep::NTDate:
+      return tableExprGroupHashDouble (itsDouble);
+    default:
+      return tableExprGroupHashString (itsString);
+    }
+  }
+
+
+  uInt tableExprGroupHashDouble (Double v)
+  {
+    // Make sure that 0 and -0 (which compare equal) get the same hash.
+    if (v == 0) {
+      v = 0;
+    }
+    uInt64 bits;
+    memcpy (&bits, &v, sizeof(bits));
+    return uInt((bits * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+
+  uInt tableExprGroupHashString (const String& v)
+  {
+    // FNV-1a hash.
+    uInt h = 2166136261u;
+    for (String::size_type i=0; i<v.size(); ++i) {
+      h = (h ^ uChar(v[i])) * 16777619u;
+    }
+    return h;
+  }
+
+
   TableExprGroupKeySet::TableExprGroupKeySet (const vector<TableExprNode>& nodes)
   {
     itsKeys.reserve (nodes.size());
@@ -147,6 +188,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  uInt TableExprGroupKeySet::hash() const
+  {
+    uInt h = 0;
+    for (size_t i=0; i<itsKeys.size(); ++i) {
+      h ^= itsKeys[i].hash() + 0x9e3779b9u + (h<<6) + (h>>2);
+    }
+    return h;
+  }
+
+
   TableExprGroupResult::TableExprGroupResult
   (const vector<CountedPtr<TableExprGroupFuncSet> >& funcSets)
   {
@@ -188,6 +239,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return False; }
   void TableExprGroupFuncBase::finish()
   {}
+  Bool TableExprGroupFuncBase::canMerge() const
+    { return False; }
+  void TableExprGroupFuncBase::merge (const TableExprGroupFuncBase&)
+  { throw TableInvExpr ("TableExprGroupFuncBase::merge not implemented"); }
   CountedPtr<vector<TableExprId> > TableExprGroupFuncBase::getIds() const
   { throw TableInvExpr ("TableExprGroupFuncBase::getIds not implemented"); }
   Bool TableExprGroupFuncBase::getBool (const vector<TableExprId>&)
@@ -241,6 +296,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsId = id;
     }
   }
+  Bool TableExprGroupFirst::canMerge() const
+    { return True; }
+  void TableExprGroupFirst::merge (const TableExprGroupFuncBase&)
+  {
+    // Keep first one; it is in this (earlier) partition.
+  }
   Bool TableExprGroupFirst::getBool (const vector<TableExprId>&)
     { return itsOperand->getBool (itsId); }
   Int64 TableExprGroupFirst::getInt (const vector<TableExprId>&)
@@ -275,6 +336,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsId = id;
   }
+  void TableExprGroupLast::merge (const TableExprGroupFuncBase& other)
+  {
+    itsId = dynamic_cast<const TableExprGroupLast&>(other).itsId;
+  }
 
   TableExprGroupExprId::TableExprGroupExprId (TableExprNodeRep* node)
     : TableExprGroupFuncBase (node)
@@ -509,5 +574,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Bool TableExprGroupFuncSet::canMerge() const
+  {
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      if (! itsFuncs[i]->canMerge()) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  void TableExprGroupFuncSet::merge (const TableExprGroupFuncSet& other)
+  {
+    AlwaysAssert (other.itsFuncs.size() == itsFuncs.size(), AipsError);
+    itsId = other.itsId;
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      itsFuncs[i]->merge (*other.itsFuncs[i]);
+    }
+  }
+
 
 } //# NAMESPACE CASACORE - END
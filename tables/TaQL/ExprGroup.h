@@ -79,6 +79,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     bool operator<  (const TableExprGroupKey&) const;
     // </group>
 
+    // Get the hash value of the key.
+    uInt hash() const;
+
   private:
     TableExprNodeRep::NodeDataType itsDT;
     Bool   itsBool;
@@ -99,8 +102,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // TaQL expression with an arbitrary data type.
   // This class contains a set of TableExprGroupKey objects, each containing
   // the value of a key for a particular table row.
-  // <br>It contains comparison functions to make it possible to use them
-  // in a std::map object to map the groupby keyset to a group.
+  // <br>It contains comparison and hash functions to make it possible to
+  // use them in a std::map or TableExprGroupHash object to map the
+  // groupby keyset to a group.
   // </synopsis> 
   class TableExprGroupKeySet
   {
@@ -121,11 +125,120 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     bool operator== (const TableExprGroupKeySet&) const;
     bool operator<  (const TableExprGroupKeySet&) const;
 
+    // Get the hash value of the keyset (combining the hash of all keys).
+    uInt hash() const;
+
   private:
     vector<TableExprGroupKey> itsKeys;
   };
 
 
+  // <summary>
+  // Hash index mapping a groupby key to a group number.
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tExprGroup">
+  // </reviewed>
+  // <synopsis>
+  // This class maps the value of a groupby key to a group number using
+  // open addressing with linear probing. The group numbers are assigned
+  // consecutively in order of first appearance of the key, so the
+  // groups keep the order in which they occur in the table.
+  // <br>The key type can be Int64, Double, String or TableExprGroupKeySet.
+  // It makes grouping O(1) per row instead of O(log(ngroups)) for a
+  // std::map which matters when grouping on a key with many values.
+  // </synopsis>
+  template<typename T>
+  class TableExprGroupHash
+  {
+  public:
+    TableExprGroupHash()
+      : itsSlots (64, -1),
+        itsMask  (63)
+    {}
+
+    // Get the number of groups.
+    uInt size() const
+      { return itsKeys.size(); }
+
+    // Get the key of the given group.
+    const T& key (uInt groupnr) const
+      { return itsKeys[groupnr]; }
+
+    // Get the group number of the key. If the key is not found, a new group
+    // is added with number size() (before the addition) and
+    // <src>isNew</src> is set to True.
+    Int find (const T& key, Bool& isNew)
+    {
+      uInt h = hashKey (key);
+      uInt slot = h & itsMask;
+      while (True) {
+        Int grp = itsSlots[slot];
+        if (grp < 0) {
+          break;
+        }
+        if (itsHashes[grp] == h  &&  itsKeys[grp] == key) {
+          isNew = False;
+          return grp;
+        }
+        slot = (slot+1) & itsMask;
+      }
+      isNew = True;
+      Int grp = itsKeys.size();
+      itsKeys.push_back (key);
+      itsHashes.push_back (h);
+      itsSlots[slot] = grp;
+      // Keep the load factor below 0.5.
+      if (2*itsKeys.size() > itsSlots.size()) {
+        rehash();
+      }
+      return grp;
+    }
+
+    // Get the hash value of the various key types.
+    // <group>
+    static uInt hashKey (Int64 v)
+      { return uInt((uInt64(v) * 0x9E3779B97F4A7C15ULL) >> 32); }
+    static uInt hashKey (Double v);
+    static uInt hashKey (const String& v);
+    static uInt hashKey (const TableExprGroupKeySet& v)
+      { return v.hash(); }
+    // </group>
+
+  private:
+    // Double the table size and reinsert all groups.
+    void rehash()
+    {
+      itsSlots.assign (2*itsSlots.size(), -1);
+      itsMask = itsSlots.size() - 1;
+      for (uInt i=0; i<itsHashes.size(); ++i) {
+        uInt slot = itsHashes[i] & itsMask;
+        while (itsSlots[slot] >= 0) {
+          slot = (slot+1) & itsMask;
+        }
+        itsSlots[slot] = i;
+      }
+    }
+
+    vector<T>    itsKeys;
+    vector<uInt> itsHashes;
+    vector<Int>  itsSlots;
+    uInt         itsMask;
+  };
+
+  // Hash functions for some basic types used by TableExprGroupHash.
+  // <group>
+  uInt tableExprGroupHashDouble (Double v);
+  uInt tableExprGroupHashString (const String& v);
+  template<typename T>
+  inline uInt TableExprGroupHash<T>::hashKey (Double v)
+    { return tableExprGroupHashDouble (v); }
+  template<typename T>
+  inline uInt TableExprGroupHash<T>::hashKey (const String& v)
+    { return tableExprGroupHashString (v); }
+  // </group>
+
+
   // <summary>
   // Class holding the results of groupby and aggregation
   // </summary>
@@ -220,6 +333,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // If needed, finish the aggregation.
     // By default nothing is done.
     virtual void finish();
+    // Can the partial result of another object of the same class be merged
+    // into this one (using the <src>merge</src> function)?
+    // The default implementation returns False.
+    virtual Bool canMerge() const;
+    // Merge the partial result of another object of the same class into
+    // this one. It is used to combine the results of the partitions of a
+    // table that are aggregated in parallel, where <src>other</src> holds
+    // the result of a later partition. It must be done before
+    // <src>finish</src> is called.
+    // The default implementation throws an exception.
+    virtual void merge (const TableExprGroupFuncBase& other);
     // Get the assembled TableExprIds of a group. It is specifically meant
     // for TableExprGroupExprId used for lazy aggregation.
     virtual CountedPtr<vector<TableExprId> > getIds() const;
@@ -288,6 +412,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupFirst (TableExprNodeRep* node);
     virtual ~TableExprGroupFirst();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual Bool getBool (const vector<TableExprId>&);
     virtual Int64 getInt (const vector<TableExprId>&);
     virtual Double getDouble (const vector<TableExprId>&);
@@ -321,6 +447,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupLast (TableExprNodeRep* node);
     virtual ~TableExprGroupLast();
     virtual void apply (const TableExprId& id);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -782,6 +909,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Apply the functions to the given row.
     void apply (const TableExprId& id);
 
+    // Can all functions merge partial results?
+    Bool canMerge() const;
+
+    // Merge the partial results of the functions in the other set, which
+    // must hold the same functions for a later part of the table.
+    // The TableExprId of the other set is used thereafter.
+    void merge (const TableExprGroupFuncSet& other);
+
     // Get the vector of functions.
     const vector<CountedPtr<TableExprGroupFuncBase> >& getFuncs() const
       { return itsFuncs; }
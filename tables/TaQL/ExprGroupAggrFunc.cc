@@ -48,6 +48,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue++;
   }
+  Bool TableExprGroupCountAll::canMerge() const
+    { return True; }
+  void TableExprGroupCountAll::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupCountAll&>(other).itsValue;
+  }
 
   TableExprGroupCount::TableExprGroupCount (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node),
@@ -72,6 +79,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsValue++;
     }
   }
+  Bool TableExprGroupCount::canMerge() const
+    { return True; }
+  void TableExprGroupCount::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupCount&>(other).itsValue;
+  }
 
   TableExprGroupAny::TableExprGroupAny (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, False)
@@ -83,6 +97,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue = True;
   }
+  Bool TableExprGroupAny::canMerge() const
+    { return True; }
+  void TableExprGroupAny::merge (const TableExprGroupFuncBase& other)
+  {
+    if (dynamic_cast<const TableExprGroupAny&>(other).itsValue) {
+      itsValue = True;
+    }
+  }
 
   TableExprGroupAll::TableExprGroupAll (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, True)
@@ -94,6 +116,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue = False;
   }
+  Bool TableExprGroupAll::canMerge() const
+    { return True; }
+  void TableExprGroupAll::merge (const TableExprGroupFuncBase& other)
+  {
+    if (! dynamic_cast<const TableExprGroupAll&>(other).itsValue) {
+      itsValue = False;
+    }
+  }
 
   TableExprGroupNTrue::TableExprGroupNTrue (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -105,6 +135,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue++;
   }
+  Bool TableExprGroupNTrue::canMerge() const
+    { return True; }
+  void TableExprGroupNTrue::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupNTrue&>(other).itsValue;
+  }
 
   TableExprGroupNFalse::TableExprGroupNFalse (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -116,6 +153,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue++;
   }
+  Bool TableExprGroupNFalse::canMerge() const
+    { return True; }
+  void TableExprGroupNFalse::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupNFalse&>(other).itsValue;
+  }
 
   TableExprGroupMinInt::TableExprGroupMinInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::max())
@@ -127,6 +171,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinInt::canMerge() const
+    { return True; }
+  void TableExprGroupMinInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMinInt& that =
+      dynamic_cast<const TableExprGroupMinInt&>(other);
+    if (that.itsValue<itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupMaxInt::TableExprGroupMaxInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::min())
@@ -138,6 +190,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxInt::canMerge() const
+    { return True; }
+  void TableExprGroupMaxInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMaxInt& that =
+      dynamic_cast<const TableExprGroupMaxInt&>(other);
+    if (that.itsValue>itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupSumInt::TableExprGroupSumInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -148,6 +208,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getInt(id);
   }
+  Bool TableExprGroupSumInt::canMerge() const
+    { return True; }
+  void TableExprGroupSumInt::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupSumInt&>(other).itsValue;
+  }
 
   TableExprGroupProductInt::TableExprGroupProductInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, 1)
@@ -181,6 +248,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinDouble::canMerge() const
+    { return True; }
+  void TableExprGroupMinDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMinDouble& that =
+      dynamic_cast<const TableExprGroupMinDouble&>(other);
+    if (that.itsValue<itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupMaxDouble::TableExprGroupMaxDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, std::numeric_limits<Double>::min())
@@ -192,6 +267,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxDouble::canMerge() const
+    { return True; }
+  void TableExprGroupMaxDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMaxDouble& that =
+      dynamic_cast<const TableExprGroupMaxDouble&>(other);
+    if (that.itsValue>itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupSumDouble::TableExprGroupSumDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -202,6 +285,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDouble(id);
   }
+  Bool TableExprGroupSumDouble::canMerge() const
+    { return True; }
+  void TableExprGroupSumDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupSumDouble&>(other).itsValue;
+  }
 
   TableExprGroupProductDouble::TableExprGroupProductDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, 1)
@@ -235,6 +325,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDouble(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDouble::canMerge() const
+    { return True; }
+  void TableExprGroupMeanDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDouble& that =
+      dynamic_cast<const TableExprGroupMeanDouble&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDouble::finish()
   {
     if (itsNr > 0) {
@@ -337,6 +436,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupSumDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupSumDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue +=
+      dynamic_cast<const TableExprGroupSumDComplex&>(other).itsValue;
+  }
 
   TableExprGroupProductDComplex::TableExprGroupProductDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node, DComplex(1,0))
@@ -370,6 +476,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDComplex(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupMeanDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDComplex& that =
+      dynamic_cast<const TableExprGroupMeanDComplex&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDComplex::finish()
   {
     if (itsNr > 0) {
@@ -30,12 +30,67 @@
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <functional>
 #include <float.h>                     // for DBL_MAX
 #include <limits.h>                     // for DBL_MAX
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Compare the values of two nodes for a block of rows.
+// The loop is simple enough to be vectorized by the compiler.
+template<typename T, typename OP>
+void TableExprNode_compareBlock (TableExprNodeRep* lnode,
+                                 TableExprNodeRep* rnode,
+                                 const Vector<uInt>& rownrs,
+                                 Block<Bool>& result, OP op)
+{
+    uInt nr = rownrs.nelements();
+    Block<T> left, right;
+    lnode->get (rownrs, left);
+    rnode->get (rownrs, right);
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    const T* l = left.storage();
+    const T* r = right.storage();
+    Bool* res = result.storage();
+    for (uInt i=0; i<nr; i++) {
+        res[i] = op(l[i], r[i]);
+    }
+}
+
+// Evaluate the node only for the rows having the given result value
+// and put its result there. It is used for the short-circuit evaluation
+// of the logical and/or.
+void TableExprNode_evalPartial (TableExprNodeRep* node,
+                                const Vector<uInt>& rownrs,
+                                Block<Bool>& result, Bool value)
+{
+    uInt nr = rownrs.nelements();
+    Vector<uInt> subRows(nr);
+    uInt nsub = 0;
+    for (uInt i=0; i<nr; i++) {
+        if (result[i] == value) {
+            subRows[nsub++] = rownrs[i];
+        }
+    }
+    if (nsub == nr) {
+        node->getBools (rownrs, result);
+    } else if (nsub > 0) {
+        subRows.resize (nsub, True);
+        Block<Bool> subResult;
+        node->getBools (subRows, subResult);
+        nsub = 0;
+        for (uInt i=0; i<nr; i++) {
+            if (result[i] == value) {
+                result[i] = subResult[nsub++];
+            }
+        }
+    }
+}
+
+
 // Implement the comparison operators for each data type.
 
 TableExprNodeEQBool::TableExprNodeEQBool (const TableExprNodeRep& node)
@@ -47,6 +102,12 @@ Bool TableExprNodeEQBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) == rnode_p->getBool(id);
 }
+void TableExprNodeEQBool::getBools (const Vector<uInt>& rownrs,
+                                    Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Bool> (lnode_p, rnode_p, rownrs, result,
+                                      std::equal_to<Bool>());
+}
 
 TableExprNodeEQInt::TableExprNodeEQInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -57,6 +118,12 @@ Bool TableExprNodeEQInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) == rnode_p->getInt(id);
 }
+void TableExprNodeEQInt::getBools (const Vector<uInt>& rownrs,
+                                   Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Int64> (lnode_p, rnode_p, rownrs, result,
+                                       std::equal_to<Int64>());
+}
 
 TableExprNodeEQDouble::TableExprNodeEQDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -67,6 +134,12 @@ Bool TableExprNodeEQDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) == rnode_p->getDouble(id);
 }
+void TableExprNodeEQDouble::getBools (const Vector<uInt>& rownrs,
+                                      Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Double> (lnode_p, rnode_p, rownrs, result,
+                                        std::equal_to<Double>());
+}
 
 TableExprNodeEQDComplex::TableExprNodeEQDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -118,6 +191,12 @@ Bool TableExprNodeNEBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) != rnode_p->getBool(id);
 }
+void TableExprNodeNEBool::getBools (const Vector<uInt>& rownrs,
+                                    Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Bool> (lnode_p, rnode_p, rownrs, result,
+                                      std::not_equal_to<Bool>());
+}
 
 TableExprNodeNEInt::TableExprNodeNEInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -128,6 +207,12 @@ Bool TableExprNodeNEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) != rnode_p->getInt(id);
 }
+void TableExprNodeNEInt::getBools (const Vector<uInt>& rownrs,
+                                   Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Int64> (lnode_p, rnode_p, rownrs, result,
+                                       std::not_equal_to<Int64>());
+}
 
 TableExprNodeNEDouble::TableExprNodeNEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -138,6 +223,12 @@ Bool TableExprNodeNEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) != rnode_p->getDouble(id);
 }
+void TableExprNodeNEDouble::getBools (const Vector<uInt>& rownrs,
+                                      Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Double> (lnode_p, rnode_p, rownrs, result,
+                                        std::not_equal_to<Double>());
+}
 
 TableExprNodeNEDComplex::TableExprNodeNEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -189,6 +280,12 @@ Bool TableExprNodeGTInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) > rnode_p->getInt(id);
 }
+void TableExprNodeGTInt::getBools (const Vector<uInt>& rownrs,
+                                   Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Int64> (lnode_p, rnode_p, rownrs, result,
+                                       std::greater<Int64>());
+}
 
 TableExprNodeGTDouble::TableExprNodeGTDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -199,6 +296,12 @@ Bool TableExprNodeGTDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) > rnode_p->getDouble(id);
 }
+void TableExprNodeGTDouble::getBools (const Vector<uInt>& rownrs,
+                                      Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Double> (lnode_p, rnode_p, rownrs, result,
+                                        std::greater<Double>());
+}
 
 TableExprNodeGTDComplex::TableExprNodeGTDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -240,6 +343,12 @@ Bool TableExprNodeGEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) >= rnode_p->getInt(id);
 }
+void TableExprNodeGEInt::getBools (const Vector<uInt>& rownrs,
+                                   Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Int64> (lnode_p, rnode_p, rownrs, result,
+                                       std::greater_equal<Int64>());
+}
 
 TableExprNodeGEDouble::TableExprNodeGEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -250,6 +359,12 @@ Bool TableExprNodeGEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) >= rnode_p->getDouble(id);
 }
+void TableExprNodeGEDouble::getBools (const Vector<uInt>& rownrs,
+                                      Block<Bool>& result)
+{
+    TableExprNode_compareBlock<Double> (lnode_p, rnode_p, rownrs, result,
+                                        std::greater_equal<Double>());
+}
 
 TableExprNodeGEDComplex::TableExprNodeGEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -374,6 +489,12 @@ Bool TableExprNodeOR::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) || rnode_p->getBool(id);
 }
+void TableExprNodeOR::getBools (const Vector<uInt>& rownrs,
+                                Block<Bool>& result)
+{
+    lnode_p->getBools (rownrs, result);
+    TableExprNode_evalPartial (rnode_p, rownrs, result, False);
+}
 
 
 TableExprNodeAND::TableExprNodeAND (const TableExprNodeRep& node)
@@ -385,6 +506,12 @@ Bool TableExprNodeAND::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) && rnode_p->getBool(id);
 }
+void TableExprNodeAND::getBools (const Vector<uInt>& rownrs,
+                                 Block<Bool>& result)
+{
+    lnode_p->getBools (rownrs, result);
+    TableExprNode_evalPartial (rnode_p, rownrs, result, True);
+}
 
 
 TableExprNodeNOT::TableExprNodeNOT (const TableExprNodeRep& node)
@@ -396,6 +523,16 @@ Bool TableExprNodeNOT::getBool (const TableExprId& id)
 {
   return ! lnode_p->getBool(id);
 }
+void TableExprNodeNOT::getBools (const Vector<uInt>& rownrs,
+                                 Block<Bool>& result)
+{
+    lnode_p->getBools (rownrs, result);
+    uInt nr = rownrs.nelements();
+    Bool* res = result.storage();
+    for (uInt i=0; i<nr; i++) {
+        res[i] = !res[i];
+    }
+}
 
 
 
@@ -469,7 +606,7 @@ void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
 	end = DBL_MAX;
     }else{
 	if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
+	&&  rnode_p->valueType() == TableExprNodeRep::VTScalar
         &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
 	    tsncol = rnode_p;
 	    end = lnode_p->getDouble (0);
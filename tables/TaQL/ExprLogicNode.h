@@ -73,6 +73,7 @@ public:
     TableExprNodeEQBool (const TableExprNodeRep&);
     ~TableExprNodeEQBool();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -103,6 +104,7 @@ public:
     TableExprNodeEQInt (const TableExprNodeRep&);
     ~TableExprNodeEQInt();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -133,6 +135,7 @@ public:
     TableExprNodeEQDouble (const TableExprNodeRep&);
     ~TableExprNodeEQDouble();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -285,6 +288,7 @@ public:
     TableExprNodeNEBool (const TableExprNodeRep&);
     ~TableExprNodeNEBool();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -315,6 +319,7 @@ public:
     TableExprNodeNEInt (const TableExprNodeRep&);
     ~TableExprNodeNEInt();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -345,6 +350,7 @@ public:
     TableExprNodeNEDouble (const TableExprNodeRep&);
     ~TableExprNodeNEDouble();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -496,6 +502,7 @@ public:
     TableExprNodeGTInt (const TableExprNodeRep&);
     ~TableExprNodeGTInt();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -526,6 +533,7 @@ public:
     TableExprNodeGTDouble (const TableExprNodeRep&);
     ~TableExprNodeGTDouble();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -648,6 +656,7 @@ public:
     TableExprNodeGEInt (const TableExprNodeRep&);
     ~TableExprNodeGEInt();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -678,6 +687,7 @@ public:
     TableExprNodeGEDouble (const TableExprNodeRep&);
     ~TableExprNodeGEDouble();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -949,6 +959,8 @@ public:
 // <synopsis> 
 // This class represents a logical or in a table select expression tree.
 // This is defined for Bool only.
+// When evaluating a block of rows, the right operand is only evaluated
+// for the rows where the left operand is False.
 // </synopsis> 
 
 class TableExprNodeOR : public TableExprNodeBinary
@@ -957,6 +969,7 @@ public:
     TableExprNodeOR (const TableExprNodeRep&);
     ~TableExprNodeOR();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -978,6 +991,8 @@ public:
 // <synopsis> 
 // This class represents a logical and in a table select expression tree.
 // This is defined for Bool only.
+// When evaluating a block of rows, the right operand is only evaluated
+// for the rows where the left operand is True.
 // </synopsis> 
 
 class TableExprNodeAND: public TableExprNodeBinary
@@ -986,6 +1001,7 @@ public:
     TableExprNodeAND (const TableExprNodeRep&);
     ~TableExprNodeAND();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
     void ranges (Block<TableExprRange>&);
 };
 
@@ -1015,6 +1031,7 @@ public:
     TableExprNodeNOT (const TableExprNodeRep&);
     ~TableExprNodeNOT();
     Bool getBool (const TableExprId& id);
+    void getBools (const Vector<uInt>& rownrs, Block<Bool>& result);
 };
 
 
@@ -29,10 +29,36 @@
 #include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <functional>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Apply an operator to the values of two nodes for a block of rows.
+// The operands have type T, the result type R.
+// The loop is simple enough to be vectorized by the compiler.
+template<typename T, typename R, typename OP>
+void TableExprNode_calcBlock (TableExprNodeRep* lnode,
+                              TableExprNodeRep* rnode,
+                              const Vector<uInt>& rownrs,
+                              Block<R>& result, OP op)
+{
+    uInt nr = rownrs.nelements();
+    Block<T> left, right;
+    lnode->get (rownrs, left);
+    rnode->get (rownrs, right);
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    const T* l = left.storage();
+    const T* r = right.storage();
+    R* res = result.storage();
+    for (uInt i=0; i<nr; i++) {
+        res[i] = R(op(l[i], r[i]));
+    }
+}
+
+
 // Implement the arithmetic operators for each data type.
 
 TableExprNodePlus::TableExprNodePlus (NodeDataType dt,
@@ -53,6 +79,18 @@ Double TableExprNodePlusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) + rnode_p->getInt(id); }
 DComplex TableExprNodePlusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) + rnode_p->getInt(id)); }
+void TableExprNodePlusInt::getInts (const Vector<uInt>& rownrs,
+                                    Block<Int64>& result)
+{
+    TableExprNode_calcBlock<Int64,Int64> (lnode_p, rnode_p, rownrs, result,
+                                          std::plus<Int64>());
+}
+void TableExprNodePlusInt::getDoubles (const Vector<uInt>& rownrs,
+                                       Block<Double>& result)
+{
+    TableExprNode_calcBlock<Int64,Double> (lnode_p, rnode_p, rownrs, result,
+                                           std::plus<Int64>());
+}
 
 TableExprNodePlusDouble::TableExprNodePlusDouble (const TableExprNodeRep& node)
 : TableExprNodePlus (NTDouble, node)
@@ -63,6 +101,12 @@ Double TableExprNodePlusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
 DComplex TableExprNodePlusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
+void TableExprNodePlusDouble::getDoubles (const Vector<uInt>& rownrs,
+                                          Block<Double>& result)
+{
+    TableExprNode_calcBlock<Double,Double> (lnode_p, rnode_p, rownrs, result,
+                                            std::plus<Double>());
+}
 
 TableExprNodePlusDComplex::TableExprNodePlusDComplex (const TableExprNodeRep& node)
 : TableExprNodePlus (NTComplex, node)
@@ -125,6 +169,18 @@ Double TableExprNodeMinusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) - rnode_p->getInt(id); }
 DComplex TableExprNodeMinusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) - rnode_p->getInt(id)); }
+void TableExprNodeMinusInt::getInts (const Vector<uInt>& rownrs,
+                                     Block<Int64>& result)
+{
+    TableExprNode_calcBlock<Int64,Int64> (lnode_p, rnode_p, rownrs, result,
+                                          std::minus<Int64>());
+}
+void TableExprNodeMinusInt::getDoubles (const Vector<uInt>& rownrs,
+                                        Block<Double>& result)
+{
+    TableExprNode_calcBlock<Int64,Double> (lnode_p, rnode_p, rownrs, result,
+                                           std::minus<Int64>());
+}
 
 TableExprNodeMinusDouble::TableExprNodeMinusDouble (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTDouble, node)
@@ -143,6 +199,12 @@ Double TableExprNodeMinusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
 DComplex TableExprNodeMinusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
+void TableExprNodeMinusDouble::getDoubles (const Vector<uInt>& rownrs,
+                                           Block<Double>& result)
+{
+    TableExprNode_calcBlock<Double,Double> (lnode_p, rnode_p, rownrs, result,
+                                            std::minus<Double>());
+}
 
 TableExprNodeMinusDComplex::TableExprNodeMinusDComplex (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTComplex, node)
@@ -198,6 +260,18 @@ Double TableExprNodeTimesInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) * rnode_p->getInt(id); }
 DComplex TableExprNodeTimesInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) * rnode_p->getInt(id)); }
+void TableExprNodeTimesInt::getInts (const Vector<uInt>& rownrs,
+                                     Block<Int64>& result)
+{
+    TableExprNode_calcBlock<Int64,Int64> (lnode_p, rnode_p, rownrs, result,
+                                          std::multiplies<Int64>());
+}
+void TableExprNodeTimesInt::getDoubles (const Vector<uInt>& rownrs,
+                                        Block<Double>& result)
+{
+    TableExprNode_calcBlock<Int64,Double> (lnode_p, rnode_p, rownrs, result,
+                                           std::multiplies<Int64>());
+}
 
 TableExprNodeTimesDouble::TableExprNodeTimesDouble (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTDouble, node)
@@ -208,6 +282,12 @@ Double TableExprNodeTimesDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
 DComplex TableExprNodeTimesDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
+void TableExprNodeTimesDouble::getDoubles (const Vector<uInt>& rownrs,
+                                           Block<Double>& result)
+{
+    TableExprNode_calcBlock<Double,Double> (lnode_p, rnode_p, rownrs, result,
+                                            std::multiplies<Double>());
+}
 
 TableExprNodeTimesDComplex::TableExprNodeTimesDComplex (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTComplex, node)
@@ -255,6 +335,12 @@ Double TableExprNodeDivideDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
 DComplex TableExprNodeDivideDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
+void TableExprNodeDivideDouble::getDoubles (const Vector<uInt>& rownrs,
+                                            Block<Double>& result)
+{
+    TableExprNode_calcBlock<Double,Double> (lnode_p, rnode_p, rownrs, result,
+                                            std::divides<Double>());
+}
 
 TableExprNodeDivideDComplex::TableExprNodeDivideDComplex (const TableExprNodeRep& node)
 : TableExprNodeDivide (NTComplex, node)
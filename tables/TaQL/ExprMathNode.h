@@ -103,6 +103,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
@@ -135,6 +137,7 @@ public:
     ~TableExprNodePlusDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
@@ -291,6 +294,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
@@ -323,6 +328,7 @@ public:
     virtual void handleUnits();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
@@ -446,6 +452,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
@@ -477,6 +485,7 @@ public:
     ~TableExprNodeTimesDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
@@ -567,6 +576,7 @@ public:
     ~TableExprNodeDivideDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubles (const Vector<uInt>& rownrs, Block<Double>& result);
 };
 
 
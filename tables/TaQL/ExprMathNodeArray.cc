@@ -73,6 +73,10 @@ TableExprNodeArrayPlusDouble::~TableExprNodeArrayPlusDouble()
 Array<Double> TableExprNodeArrayPlusDouble::getArrayDouble
                                             (const TableExprId& id)
 {
+    Array<Double> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDouble (id) + rnode_p->getDouble (id);
@@ -93,6 +97,10 @@ TableExprNodeArrayPlusDComplex::~TableExprNodeArrayPlusDComplex()
 Array<DComplex> TableExprNodeArrayPlusDComplex::getArrayDComplex
                                             (const TableExprId& id)
 {
+    Array<DComplex> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDComplex (id) + rnode_p->getDComplex (id);
@@ -240,6 +248,10 @@ TableExprNodeArrayMinusDouble::~TableExprNodeArrayMinusDouble()
 Array<Double> TableExprNodeArrayMinusDouble::getArrayDouble
                                             (const TableExprId& id)
 {
+    Array<Double> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDouble (id) - rnode_p->getDouble (id);
@@ -260,6 +272,10 @@ TableExprNodeArrayMinusDComplex::~TableExprNodeArrayMinusDComplex()
 Array<DComplex> TableExprNodeArrayMinusDComplex::getArrayDComplex
                                             (const TableExprId& id)
 {
+    Array<DComplex> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDComplex (id) - rnode_p->getDComplex (id);
@@ -353,6 +369,10 @@ TableExprNodeArrayTimesDouble::~TableExprNodeArrayTimesDouble()
 Array<Double> TableExprNodeArrayTimesDouble::getArrayDouble
                                             (const TableExprId& id)
 {
+    Array<Double> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDouble (id) * rnode_p->getDouble (id);
@@ -373,6 +393,10 @@ TableExprNodeArrayTimesDComplex::~TableExprNodeArrayTimesDComplex()
 Array<DComplex> TableExprNodeArrayTimesDComplex::getArrayDComplex
                                             (const TableExprId& id)
 {
+    Array<DComplex> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDComplex (id) * rnode_p->getDComplex (id);
@@ -413,6 +437,10 @@ TableExprNodeArrayDivideDouble::~TableExprNodeArrayDivideDouble()
 Array<Double> TableExprNodeArrayDivideDouble::getArrayDouble
                                             (const TableExprId& id)
 {
+    Array<Double> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDouble (id) / rnode_p->getDouble (id);
@@ -433,6 +461,10 @@ TableExprNodeArrayDivideDComplex::~TableExprNodeArrayDivideDComplex()
 Array<DComplex> TableExprNodeArrayDivideDComplex::getArrayDComplex
                                             (const TableExprId& id)
 {
+    Array<DComplex> result;
+    if (fused_p.eval (this, id, result)) {
+	return result;
+    }
     switch (argtype_p) {
     case ArrSca:
 	return lnode_p->getArrayDComplex (id) / rnode_p->getDComplex (id);
@@ -569,9 +601,21 @@ TableExprNodeArrayMIN::~TableExprNodeArrayMIN()
 Array<Int64> TableExprNodeArrayMIN::getArrayInt (const TableExprId& id)
     { return -(lnode_p->getArrayInt(id)); }
 Array<Double> TableExprNodeArrayMIN::getArrayDouble (const TableExprId& id)
-    { return -(lnode_p->getArrayDouble(id)); }
+{
+    Array<Double> result;
+    if (fusedDouble_p.eval (this, id, result)) {
+	return result;
+    }
+    return -(lnode_p->getArrayDouble(id));
+}
 Array<DComplex> TableExprNodeArrayMIN::getArrayDComplex (const TableExprId& id)
-    { return -(lnode_p->getArrayDComplex(id)); }
+{
+    Array<DComplex> result;
+    if (fusedDComplex_p.eval (this, id, result)) {
+	return result;
+    }
+    return -(lnode_p->getArrayDComplex(id));
+}
 
 
 TableExprNodeArrayBitNegate::TableExprNodeArrayBitNegate
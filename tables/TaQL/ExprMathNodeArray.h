@@ -31,6 +31,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/tables/TaQL/ExprFusedArray.h>
 #include <casacore/casa/Arrays/Array.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -134,6 +135,8 @@ public:
     TableExprNodeArrayPlusDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayPlusDouble();
     Array<Double> getArrayDouble (const TableExprId& id);
+private:
+    TableExprFusedArray<Double> fused_p;
 };
 
 
@@ -165,6 +168,8 @@ public:
     TableExprNodeArrayPlusDComplex (const TableExprNodeRep&);
     ~TableExprNodeArrayPlusDComplex();
     Array<DComplex> getArrayDComplex (const TableExprId& id);
+private:
+    TableExprFusedArray<DComplex> fused_p;
 };
 
 
@@ -322,6 +327,8 @@ public:
     TableExprNodeArrayMinusDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayMinusDouble();
     Array<Double> getArrayDouble (const TableExprId& id);
+private:
+    TableExprFusedArray<Double> fused_p;
 };
 
 
@@ -352,6 +359,8 @@ public:
     TableExprNodeArrayMinusDComplex (const TableExprNodeRep&);
     ~TableExprNodeArrayMinusDComplex();
     Array<DComplex> getArrayDComplex (const TableExprId& id);
+private:
+    TableExprFusedArray<DComplex> fused_p;
 };
 
 
@@ -473,6 +482,8 @@ public:
     TableExprNodeArrayTimesDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayTimesDouble();
     Array<Double> getArrayDouble (const TableExprId& id);
+private:
+    TableExprFusedArray<Double> fused_p;
 };
 
 
@@ -503,6 +514,8 @@ public:
     TableExprNodeArrayTimesDComplex (const TableExprNodeRep&);
     ~TableExprNodeArrayTimesDComplex();
     Array<DComplex> getArrayDComplex (const TableExprId& id);
+private:
+    TableExprFusedArray<DComplex> fused_p;
 };
 
 
@@ -562,6 +575,8 @@ public:
     TableExprNodeArrayDivideDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayDivideDouble();
     Array<Double> getArrayDouble (const TableExprId& id);
+private:
+    TableExprFusedArray<Double> fused_p;
 };
 
 
@@ -592,6 +607,8 @@ public:
     TableExprNodeArrayDivideDComplex (const TableExprNodeRep&);
     ~TableExprNodeArrayDivideDComplex();
     Array<DComplex> getArrayDComplex (const TableExprId& id);
+private:
+    TableExprFusedArray<DComplex> fused_p;
 };
 
 
@@ -798,6 +815,9 @@ public:
     Array<Int64>    getArrayInt      (const TableExprId& id);
     Array<Double>   getArrayDouble   (const TableExprId& id);
     Array<DComplex> getArrayDComplex (const TableExprId& id);
+private:
+    TableExprFusedArray<Double>   fusedDouble_p;
+    TableExprFusedArray<DComplex> fusedDComplex_p;
 };
 
 
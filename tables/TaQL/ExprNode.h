@@ -958,6 +958,17 @@ public:
 
     // </group>
 
+    // Get the scalar values for this node in the given rows.
+    // It evaluates the expression for a block of rows at once, which is
+    // much faster than getting the values row by row.
+    // Element i of the result is the value in row <src>rownrs[i]</src>.
+    // The result block is resized if it is too small.
+    // <group>
+    void get (const Vector<uInt>& rownrs, Block<Bool>& values) const;
+    void get (const Vector<uInt>& rownrs, Block<Int64>& values) const;
+    void get (const Vector<uInt>& rownrs, Block<Double>& values) const;
+    // </group>
+
     // Get the data type for doing a getColumn on the expression.
     // This is the data type of the column if the expression
     // consists of a single column only.
@@ -1146,6 +1157,15 @@ inline void TableExprNode::get (const TableExprId& id, TaqlRegex& value) const
     { value = node_p->getRegex (id); }
 inline void TableExprNode::get (const TableExprId& id, MVTime& value) const
     { value = node_p->getDate (id); }
+inline void TableExprNode::get (const Vector<uInt>& rownrs,
+                                Block<Bool>& values) const
+    { node_p->getBools (rownrs, values); }
+inline void TableExprNode::get (const Vector<uInt>& rownrs,
+                                Block<Int64>& values) const
+    { node_p->getInts (rownrs, values); }
+inline void TableExprNode::get (const Vector<uInt>& rownrs,
+                                Block<Double>& values) const
+    { node_p->getDoubles (rownrs, values); }
 inline void TableExprNode::get (const TableExprId& id,
 				Array<Bool>& value) const
     { value = node_p->getArrayBool (id); }
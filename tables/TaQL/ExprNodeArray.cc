@@ -40,17 +40,23 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 TableExprNodeArray::TableExprNodeArray (NodeDataType dtype, OperType otype)
-: TableExprNodeBinary (dtype, VTArray, otype, Table())
+: TableExprNodeBinary (dtype, VTArray, otype, Table()),
+  caching_p           (False),
+  cacheRow_p          (-1)
 {
     ndim_p = -1;
 }
 TableExprNodeArray::TableExprNodeArray (const TableExprNodeRep& node,
 					NodeDataType dtype, OperType otype)
-: TableExprNodeBinary (dtype, node, otype)
+: TableExprNodeBinary (dtype, node, otype),
+  caching_p           (False),
+  cacheRow_p          (-1)
 {}
 TableExprNodeArray::TableExprNodeArray (NodeDataType dtype, OperType otype,
 					const IPosition& shape)
-: TableExprNodeBinary (dtype, VTArray, otype, Table())
+: TableExprNodeBinary (dtype, VTArray, otype, Table()),
+  caching_p           (False),
+  cacheRow_p          (-1)
 {
     shape_p = shape;
     ndim_p  = shape.nelements();
@@ -482,6 +488,87 @@ Array<DComplex> TableExprNodeArray::makeArray (const IPosition& shape,
     return arr;
 }
 
+void TableExprNodeArray::setCaching (Bool caching)
+{
+    caching_p = caching;
+    clearCache();
+}
+
+void TableExprNodeArray::clearCache()
+{
+    cacheRow_p = -1;
+    cacheBool_p.resize();
+    cacheInt_p.resize();
+    cacheDouble_p.resize();
+    cacheDComplex_p.resize();
+    cacheString_p.resize();
+    cacheDate_p.resize();
+}
+
+template<typename T>
+Bool TableExprNodeArray::getCachedValue (const TableExprId& id,
+                                         NodeDataType dtype,
+                                         const Array<T>& cache,
+                                         Array<T>& value) const
+{
+    if (caching_p  &&  dtype == dataType()  &&  id.byRow()
+    &&  id.rownr() == cacheRow_p) {
+        value.reference (cache);
+        return True;
+    }
+    return False;
+}
+
+template<typename T>
+void TableExprNodeArray::setCachedValue (const TableExprId& id,
+                                         NodeDataType dtype,
+                                         Array<T>& cache,
+                                         const Array<T>& value)
+{
+    if (caching_p  &&  dtype == dataType()  &&  id.byRow()) {
+        cache.reference (value);
+        cacheRow_p = id.rownr();
+    }
+}
+
+Bool TableExprNodeArray::getCached (const TableExprId& id,
+                                    Array<Bool>& value) const
+    { return getCachedValue (id, NTBool, cacheBool_p, value); }
+Bool TableExprNodeArray::getCached (const TableExprId& id,
+                                    Array<Int64>& value) const
+    { return getCachedValue (id, NTInt, cacheInt_p, value); }
+Bool TableExprNodeArray::getCached (const TableExprId& id,
+                                    Array<Double>& value) const
+    { return getCachedValue (id, NTDouble, cacheDouble_p, value); }
+Bool TableExprNodeArray::getCached (const TableExprId& id,
+                                    Array<DComplex>& value) const
+    { return getCachedValue (id, NTComplex, cacheDComplex_p, value); }
+Bool TableExprNodeArray::getCached (const TableExprId& id,
+                                    Array<String>& value) const
+    { return getCachedValue (id, NTString, cacheString_p, value); }
+Bool TableExprNodeArray::getCached (const TableExprId& id,
+                                    Array<MVTime>& value) const
+    { return getCachedValue (id, NTDate, cacheDate_p, value); }
+
+void TableExprNodeArray::setCached (const TableExprId& id,
+                                    const Array<Bool>& value)
+    { setCachedValue (id, NTBool, cacheBool_p, value); }
+void TableExprNodeArray::setCached (const TableExprId& id,
+                                    const Array<Int64>& value)
+    { setCachedValue (id, NTInt, cacheInt_p, value); }
+void TableExprNodeArray::setCached (const TableExprId& id,
+                                    const Array<Double>& value)
+    { setCachedValue (id, NTDouble, cacheDouble_p, value); }
+void TableExprNodeArray::setCached (const TableExprId& id,
+                                    const Array<DComplex>& value)
+    { setCachedValue (id, NTComplex, cacheDComplex_p, value); }
+void TableExprNodeArray::setCached (const TableExprId& id,
+                                    const Array<String>& value)
+    { setCachedValue (id, NTString, cacheString_p, value); }
+void TableExprNodeArray::setCached (const TableExprId& id,
+                                    const Array<MVTime>& value)
+    { setCachedValue (id, NTDate, cacheDate_p, value); }
+
 
 
 // ----------------------------------
@@ -604,7 +691,12 @@ Bool TableExprNodeArrayColumnBool::getElemBool (const TableExprId& id,
 }
 Array<Bool> TableExprNodeArrayColumnBool::getArrayBool (const TableExprId& id)
 {
-    return col_p(id.rownr());
+    Array<Bool> out;
+    if (! getCached (id, out)) {
+        out.reference (col_p (id.rownr()));
+        setCached (id, out);
+    }
+    return out;
 }
 Array<Bool> TableExprNodeArrayColumnBool::getSliceBool (const TableExprId& id,
 							const Slicer& index)
@@ -641,9 +733,13 @@ Int64 TableExprNodeArrayColumnuChar::getElemInt (const TableExprId& id,
 Array<Int64> TableExprNodeArrayColumnuChar::getArrayInt
                                                     (const TableExprId& id)
 {
-    Array<uChar> arr = col_p (id.rownr());
-    Array<Int64> out (arr.shape());
-    convertArray (out, arr);
+    Array<Int64> out;
+    if (! getCached (id, out)) {
+        Array<uChar> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<Int64> TableExprNodeArrayColumnuChar::getSliceInt
@@ -685,9 +781,13 @@ Int64 TableExprNodeArrayColumnShort::getElemInt (const TableExprId& id,
 Array<Int64> TableExprNodeArrayColumnShort::getArrayInt
                                                     (const TableExprId& id)
 {
-    Array<Short> arr = col_p (id.rownr());
-    Array<Int64> out (arr.shape());
-    convertArray (out, arr);
+    Array<Int64> out;
+    if (! getCached (id, out)) {
+        Array<Short> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<Int64> TableExprNodeArrayColumnShort::getSliceInt
@@ -729,9 +829,13 @@ Int64 TableExprNodeArrayColumnuShort::getElemInt (const TableExprId& id,
 Array<Int64> TableExprNodeArrayColumnuShort::getArrayInt
                                                      (const TableExprId& id)
 {
-    Array<uShort> arr = col_p (id.rownr());
-    Array<Int64> out (arr.shape());
-    convertArray (out, arr);
+    Array<Int64> out;
+    if (! getCached (id, out)) {
+        Array<uShort> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<Int64> TableExprNodeArrayColumnuShort::getSliceInt
@@ -773,9 +877,13 @@ Int64 TableExprNodeArrayColumnInt::getElemInt (const TableExprId& id,
 Array<Int64> TableExprNodeArrayColumnInt::getArrayInt
                                                   (const TableExprId& id)
 {
-    Array<Int> arr = col_p (id.rownr());
-    Array<Int64> out (arr.shape());
-    convertArray (out, arr);
+    Array<Int64> out;
+    if (! getCached (id, out)) {
+        Array<Int> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<Int64> TableExprNodeArrayColumnInt::getSliceInt
@@ -817,9 +925,13 @@ Int64 TableExprNodeArrayColumnuInt::getElemInt (const TableExprId& id,
 Array<Int64> TableExprNodeArrayColumnuInt::getArrayInt
                                                    (const TableExprId& id)
 {
-    Array<uInt> arr = col_p (id.rownr());
-    Array<Int64> out (arr.shape());
-    convertArray (out, arr);
+    Array<Int64> out;
+    if (! getCached (id, out)) {
+        Array<uInt> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<Int64> TableExprNodeArrayColumnuInt::getSliceInt
@@ -861,9 +973,13 @@ Double TableExprNodeArrayColumnFloat::getElemDouble (const TableExprId& id,
 Array<Double> TableExprNodeArrayColumnFloat::getArrayDouble
                                                     (const TableExprId& id)
 {
-    Array<Float> arr = col_p (id.rownr());
-    Array<Double> out (arr.shape());
-    convertArray (out, arr);
+    Array<Double> out;
+    if (! getCached (id, out)) {
+        Array<Float> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<Double> TableExprNodeArrayColumnFloat::getSliceDouble
@@ -905,7 +1021,12 @@ Double TableExprNodeArrayColumnDouble::getElemDouble (const TableExprId& id,
 Array<Double> TableExprNodeArrayColumnDouble::getArrayDouble
                                                      (const TableExprId& id)
 {
-    return col_p (id.rownr());
+    Array<Double> out;
+    if (! getCached (id, out)) {
+        out.reference (col_p (id.rownr()));
+        setCached (id, out);
+    }
+    return out;
 }
 Array<Double> TableExprNodeArrayColumnDouble::getSliceDouble
                                                      (const TableExprId& id,
@@ -944,9 +1065,13 @@ DComplex TableExprNodeArrayColumnComplex::getElemDComplex
 Array<DComplex> TableExprNodeArrayColumnComplex::getArrayDComplex
                                                      (const TableExprId& id)
 {
-    Array<Complex> arr = col_p (id.rownr());
-    Array<DComplex> out (arr.shape());
-    convertArray (out, arr);
+    Array<DComplex> out;
+    if (! getCached (id, out)) {
+        Array<Complex> arr = col_p (id.rownr());
+        out.resize (arr.shape());
+        convertArray (out, arr);
+        setCached (id, out);
+    }
     return out;
 }
 Array<DComplex> TableExprNodeArrayColumnComplex::getSliceDComplex
@@ -989,7 +1114,12 @@ DComplex TableExprNodeArrayColumnDComplex::getElemDComplex
 Array<DComplex> TableExprNodeArrayColumnDComplex::getArrayDComplex
                                                      (const TableExprId& id)
 {
-    return col_p (id.rownr());
+    Array<DComplex> out;
+    if (! getCached (id, out)) {
+        out.reference (col_p (id.rownr()));
+        setCached (id, out);
+    }
+    return out;
 }
 Array<DComplex> TableExprNodeArrayColumnDComplex::getSliceDComplex
                                                      (const TableExprId& id,
@@ -1027,7 +1157,12 @@ String TableExprNodeArrayColumnString::getElemString (const TableExprId& id,
 Array<String> TableExprNodeArrayColumnString::getArrayString
                                                      (const TableExprId& id)
 {
-    return col_p (id.rownr());
+    Array<String> out;
+    if (! getCached (id, out)) {
+        out.reference (col_p (id.rownr()));
+        setCached (id, out);
+    }
+    return out;
 }
 Array<String> TableExprNodeArrayColumnString::getSliceString
                                                      (const TableExprId& id,
@@ -178,8 +178,59 @@ public:
     static Array<DComplex> makeArray (const IPosition& shape,
 				      const DComplex& value);
 
+    // Enable or disable caching of the array value of the last row
+    // evaluated. TaQL enables it for a node used in multiple places
+    // of a query, so its value is read or calculated once per row.
+    void setCaching (Bool caching);
+
+    // Clear the cached value. It has to be done if the row numbers
+    // get a different meaning (e.g. when a selection is applied).
+    void clearCache();
+
 protected:
+    // Get the cached value for the row given in the id.
+    // It returns False if caching is disabled or if the row is not cached.
+    // Only the value of the node's data type is cached.
+    // <group>
+    Bool getCached (const TableExprId& id, Array<Bool>& value) const;
+    Bool getCached (const TableExprId& id, Array<Int64>& value) const;
+    Bool getCached (const TableExprId& id, Array<Double>& value) const;
+    Bool getCached (const TableExprId& id, Array<DComplex>& value) const;
+    Bool getCached (const TableExprId& id, Array<String>& value) const;
+    Bool getCached (const TableExprId& id, Array<MVTime>& value) const;
+    // </group>
+
+    // Cache the value for the row given in the id if caching is enabled.
+    // <group>
+    void setCached (const TableExprId& id, const Array<Bool>& value);
+    void setCached (const TableExprId& id, const Array<Int64>& value);
+    void setCached (const TableExprId& id, const Array<Double>& value);
+    void setCached (const TableExprId& id, const Array<DComplex>& value);
+    void setCached (const TableExprId& id, const Array<String>& value);
+    void setCached (const TableExprId& id, const Array<MVTime>& value);
+    // </group>
+
     IPosition varShape_p;
+
+private:
+    // Get or set the cached value.
+    // <group>
+    template<typename T>
+    Bool getCachedValue (const TableExprId& id, NodeDataType dtype,
+                         const Array<T>& cache, Array<T>& value) const;
+    template<typename T>
+    void setCachedValue (const TableExprId& id, NodeDataType dtype,
+                         Array<T>& cache, const Array<T>& value);
+    // </group>
+
+    Bool            caching_p;
+    Int64           cacheRow_p;
+    Array<Bool>     cacheBool_p;
+    Array<Int64>    cacheInt_p;
+    Array<Double>   cacheDouble_p;
+    Array<DComplex> cacheDComplex_p;
+    Array<String>   cacheString_p;
+    Array<MVTime>   cacheDate_p;
 };
 
 
@@ -126,6 +126,11 @@ void TableExprNodeRep::getAggrNodes (vector<TableExprNodeRep*>&)
 void TableExprNodeRep::getColumnNodes (vector<TableExprNodeRep*>&)
 {}
 
+Bool TableExprNodeRep::isThreadSafe() const
+{
+  return False;
+}
+
 void TableExprNodeRep::checkAggrFuncs (const TableExprNodeRep* node)
 {
   vector<TableExprNodeRep*> aggr;
@@ -274,6 +279,46 @@ MVTime TableExprNodeRep::getDate (const TableExprId&)
     TableExprNode::throwInvDT ("(getDate not implemented)");
     return MVTime(0.);
 }
+
+void TableExprNodeRep::getBools (const Vector<uInt>& rownrs,
+                                 Block<Bool>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    TableExprId id;
+    for (uInt i=0; i<nr; i++) {
+        id.setRownr (rownrs[i]);
+        result[i] = getBool (id);
+    }
+}
+void TableExprNodeRep::getInts (const Vector<uInt>& rownrs,
+                                Block<Int64>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    TableExprId id;
+    for (uInt i=0; i<nr; i++) {
+        id.setRownr (rownrs[i]);
+        result[i] = getInt (id);
+    }
+}
+void TableExprNodeRep::getDoubles (const Vector<uInt>& rownrs,
+                                   Block<Double>& result)
+{
+    uInt nr = rownrs.nelements();
+    if (result.nelements() < nr) {
+        result.resize (nr, False, False);
+    }
+    TableExprId id;
+    for (uInt i=0; i<nr; i++) {
+        id.setRownr (rownrs[i]);
+        result[i] = getDouble (id);
+    }
+}
 Array<Bool> TableExprNodeRep::getArrayBool (const TableExprId&)
 {
     TableExprNode::throwInvDT ("(getArrayBool not implemented)");
@@ -737,6 +782,43 @@ void TableExprNodeBinary::getColumnNodes (vector<TableExprNodeRep*>& cols)
   }
 }
 
+Bool TableExprNodeBinary::isThreadSafe() const
+{
+  if (vtype_p != VTScalar  ||  dtype_p == NTRegex) {
+    return False;
+  }
+  switch (optype_p) {
+  case OtPlus:
+  case OtMinus:
+  case OtTimes:
+  case OtDivide:
+  case OtModulo:
+  case OtBitAnd:
+  case OtBitOr:
+  case OtBitXor:
+  case OtBitNegate:
+  case OtEQ:
+  case OtGE:
+  case OtGT:
+  case OtNE:
+  case OtAND:
+  case OtOR:
+  case OtNOT:
+  case OtMIN:
+  case OtColumn:
+  case OtLiteral:
+  case OtRownr:
+  case OtUndef:              //# unit conversion
+    break;
+  case OtIN:
+    return (lnode_p->isThreadSafe()  &&  rnode_p->isConstant());
+  default:
+    return False;
+  }
+  return ((lnode_p == 0  ||  lnode_p->isThreadSafe())  &&
+          (rnode_p == 0  ||  rnode_p->isThreadSafe()));
+}
+
 // Check the datatypes and get the common one.
 // For use with operands.
 TableExprNodeRep::NodeDataType TableExprNodeBinary::getDT
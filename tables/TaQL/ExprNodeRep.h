@@ -243,6 +243,10 @@ public:
   
     // Get the nodes representing a table column.
     virtual void getColumnNodes (vector<TableExprNodeRep*>& cols);
+
+    // Can the expression be evaluated by multiple threads at the same time?
+    // The default implementation returns False.
+    virtual Bool isThreadSafe() const;
   
     // Create the correct immediate aggregate function object.
     // The default implementation throws an exception, because it should
@@ -268,6 +272,21 @@ public:
     virtual MVTime getDate       (const TableExprId& id);
     // </group>
 
+    // Get the scalar values for this node in the given rows.
+    // It makes it possible to evaluate an expression for a block of rows
+    // at once, thus with one virtual call per node instead of one per
+    // node and row. Column nodes read the values of all rows in one go
+    // and the operator nodes do their operation in a simple loop.
+    // <br>Element i of the result is the value in row <src>rownrs[i]</src>.
+    // The result block is resized if it is too small.
+    // The default implementations call the scalar get function per row.
+    // <group>
+    virtual void getBools   (const Vector<uInt>& rownrs, Block<Bool>& result);
+    virtual void getInts    (const Vector<uInt>& rownrs, Block<Int64>& result);
+    virtual void getDoubles (const Vector<uInt>& rownrs,
+                             Block<Double>& result);
+    // </group>
+
     // Get an array value for this node in the given row.
     // The appropriate functions are implemented in the derived classes and
     // will usually invoke the get in their children and apply the
@@ -307,6 +326,12 @@ public:
       { value = getArrayDate (id); }
     void get (const TableExprId& id, Array<String>& value)
       { value = getArrayString (id); }
+    void get (const Vector<uInt>& rownrs, Block<Bool>& values)
+      { getBools (rownrs, values); }
+    void get (const Vector<uInt>& rownrs, Block<Int64>& values)
+      { getInts (rownrs, values); }
+    void get (const Vector<uInt>& rownrs, Block<Double>& values)
+      { getDoubles (rownrs, values); }
     // </group>
 
     // Get a value as an array, even it it is a scalar.
@@ -564,6 +589,12 @@ public:
   
     // Get the nodes representing a table column.
     virtual void getColumnNodes (vector<TableExprNodeRep*>& cols);
+
+    // Can the expression be evaluated by multiple threads at the same time?
+    // It can for scalar operators (except regex matching) on constants
+    // and scalar columns (which serialize their reads). An IN operator
+    // is only thread-safe if its set is constant.
+    virtual Bool isThreadSafe() const;
   
     // Check the data types and get the common one.
     static NodeDataType getDT (NodeDataType leftDtype,
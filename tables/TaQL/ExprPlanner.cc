@@ -0,0 +1,333 @@
+//# ExprPlanner.cc: Plan the evaluation of a table selection expression
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <casacore/tables/TaQL/ExprPlanner.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprRange.h>
+#include <casacore/tables/Tables/BaseTable.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/GenSort.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <algorithm>
+#include <float.h>
+#include <limits>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// Test if the values of a scalar column are in ascending order.
+// The column is read in chunks to limit the memory usage.
+// The test is written such that a NaN makes the column unsorted.
+template<typename T>
+Bool TableExprPlanner_isSorted (const TableColumn& column)
+{
+  ScalarColumn<T> scol(column);
+  uInt nrow = scol.nrow();
+  const uInt chunkSize = 65536;
+  Vector<T> vals;
+  T last = T();
+  for (uInt st=0; st<nrow; st+=chunkSize) {
+    uInt nr = std::min (chunkSize, nrow-st);
+    scol.getColumnRange (Slicer(IPosition(1,st), IPosition(1,nr)),
+                         vals, True);
+    for (uInt i=0; i<nr; i++) {
+      if (!(vals[i] == vals[i])  ||  (st+i > 0  &&  !(vals[i] >= last))) {
+        return False;
+      }
+      last = vals[i];
+    }
+  }
+  return True;
+}
+
+Bool TableExprPlanner::isSorted (const TableColumn& column)
+{
+  switch (column.columnDesc().dataType()) {
+  case TpUChar:
+    return TableExprPlanner_isSorted<uChar> (column);
+  case TpShort:
+    return TableExprPlanner_isSorted<Short> (column);
+  case TpUShort:
+    return TableExprPlanner_isSorted<uShort> (column);
+  case TpInt:
+    return TableExprPlanner_isSorted<Int> (column);
+  case TpUInt:
+    return TableExprPlanner_isSorted<uInt> (column);
+  case TpFloat:
+    return TableExprPlanner_isSorted<Float> (column);
+  case TpDouble:
+    return TableExprPlanner_isSorted<Double> (column);
+  default:
+    break;
+  }
+  return False;
+}
+
+
+TableExprPlanner::TableExprPlanner (const TableExprNode& node,
+                                    const Table& table)
+: hasRows_p (False)
+{
+  uInt nrow = table.nrow();
+  description_p = "full scan of " + String::toString(nrow) + " rows";
+  if (node.isNull()  ||  nrow == 0) {
+    return;
+  }
+  Block<TableExprRange> ranges;
+  TableExprNode expr(node);
+  expr.ranges (ranges);
+  // Use the column giving the fewest candidate rows.
+  Vector<uInt> rows;
+  uInt nrinterval;
+  for (uInt i=0; i<ranges.nelements(); i++) {
+    String path;
+    switch (accessPath (ranges[i], table)) {
+    case SortedColumn:
+      findRows (ranges[i], rows, nrinterval);
+      path = "binary search on sorted column ";
+      break;
+    case PersistentIndex:
+      findIndexRows (ranges[i], table, rows, nrinterval);
+      path = "lookup in persistent index on column ";
+      break;
+    case ZoneMap:
+      findZoneRows (ranges[i], rows, nrinterval);
+      path = "zone map on column ";
+      break;
+    default:
+      continue;
+    }
+    if (rows.nelements() < nrow  &&
+        (!hasRows_p  ||  rows.nelements() < rows_p.nelements())) {
+      hasRows_p = True;
+      rows_p.reference (rows);
+      rows.resize();
+      description_p = path + ranges[i].getColumn().columnDesc().name() +
+        " (" + String::toString(nrinterval) +
+        (nrinterval == 1  ?  " interval" : " intervals") + "), evaluating " +
+        String::toString(rows_p.nelements()) + " of " +
+        String::toString(nrow) + " rows";
+    }
+  }
+}
+
+TableExprPlanner::AccessPath TableExprPlanner::accessPath
+                                            (const TableExprRange& range,
+                                             const Table& table)
+{
+  // Only a root table can be used. Because such a plain table is open
+  // only once in a process, the column belongs to the table if the names
+  // match.
+  const TableColumn& column = range.getColumn();
+  if (table.tableType() != Table::Plain  ||  !table.isRootTable()
+  ||  column.table().tableName() != table.tableName()
+  ||  column.table().nrow() != table.nrow()
+  ||  !column.columnDesc().isScalar()) {
+    return FullScan;
+  }
+  // The sort order and persistent index can only be used for a readonly
+  // table, because changes made by this process do not update the modify
+  // counter used to validate them.
+  if (table.isWritable()) {
+    return (hasZoneMap(column)  ?  ZoneMap : FullScan);
+  }
+  BaseTable* btab = table.baseTablePtr();
+  const String& name = column.columnDesc().name();
+  Int sorted = btab->getColumnSorted (name);
+  if (sorted < 0) {
+    sorted = (isSorted(column) ? 1 : 0);
+    btab->setColumnSorted (name, sorted > 0);
+  }
+  if (sorted > 0) {
+    return SortedColumn;
+  }
+  // A persistent index can be used for an Int or Double column.
+  // Other types would need a conversion of the range to the key type.
+  // It must be up to date, otherwise the index has to be created which
+  // is more expensive than a scan.
+  DataType dtype = column.columnDesc().dataType();
+  if ((dtype == TpInt  ||  dtype == TpDouble)  &&
+      ColumnsIndex::canUsePersistent (table, Vector<String>(1, name))) {
+    return PersistentIndex;
+  }
+  return (hasZoneMap(column)  ?  ZoneMap : FullScan);
+}
+
+Bool TableExprPlanner::hasZoneMap (const TableColumn& column)
+{
+  Vector<uInt> lastRow;
+  Vector<Double> minVal, maxVal;
+  return column.getZoneMap (lastRow, minVal, maxVal);
+}
+
+void TableExprPlanner::findZoneRows (const TableExprRange& range,
+                                     Vector<uInt>& rows, uInt& nrinterval)
+{
+  // A block of rows is a candidate if its [min,max] overlaps an interval.
+  // A boundary at DBL_MAX is taken as infinity, so infinite values match.
+  // A block without values (min > max) cannot match.
+  const TableColumn& column = range.getColumn();
+  Vector<uInt> lastRow;
+  Vector<Double> minVal, maxVal;
+  column.getZoneMap (lastRow, minVal, maxVal);
+  const Vector<Double>& st  = range.start();
+  const Vector<Double>& end = range.end();
+  nrinterval = st.nelements();
+  uInt nblock = lastRow.nelements();
+  Block<Bool> use(nblock, False);
+  uInt nr = 0;
+  uInt firstRow = 0;
+  for (uInt i=0; i<nblock; i++) {
+    if (minVal[i] <= maxVal[i]) {
+      for (uInt j=0; j<nrinterval; j++) {
+        if ((st[j] <= -DBL_MAX  ||  maxVal[i] >= st[j])  &&
+            (end[j] >= DBL_MAX  ||  minVal[i] <= end[j])) {
+          use[i] = True;
+          nr += lastRow[i] + 1 - firstRow;
+          break;
+        }
+      }
+    }
+    firstRow = lastRow[i] + 1;
+  }
+  rows.resize (nr);
+  nr = 0;
+  firstRow = 0;
+  for (uInt i=0; i<nblock; i++) {
+    if (use[i]) {
+      for (uInt row=firstRow; row<=lastRow[i]; row++) {
+        rows[nr++] = row;
+      }
+    }
+    firstRow = lastRow[i] + 1;
+  }
+}
+
+void TableExprPlanner::findIndexRows (const TableExprRange& range,
+                                      const Table& table,
+                                      Vector<uInt>& rows, uInt& nrinterval)
+{
+  // Look up each interval (which are disjoint) in the index.
+  // The interval boundaries are converted to the key type.
+  const TableColumn& column = range.getColumn();
+  const String& name = column.columnDesc().name();
+  ColumnsIndex index(table, name);
+  Record& lower = index.accessLowerKey();
+  Record& upper = index.accessUpperKey();
+  Bool isInt = (column.columnDesc().dataType() == TpInt);
+  const Vector<Double>& st  = range.start();
+  const Vector<Double>& end = range.end();
+  nrinterval = st.nelements();
+  Block<uInt> allRows;
+  uInt nr = 0;
+  for (uInt i=0; i<nrinterval; i++) {
+    Double stval  = (st[i] <= -DBL_MAX  ?  -doubleInf() : st[i]);
+    Double endval = (end[i] >= DBL_MAX  ?  doubleInf() : end[i]);
+    if (isInt) {
+      stval  = std::max (ceil(stval),  Double(std::numeric_limits<Int>::min()));
+      endval = std::min (floor(endval), Double(std::numeric_limits<Int>::max()));
+      if (stval > endval) {
+        continue;
+      }
+      lower.define (name, Int(stval));
+      upper.define (name, Int(endval));
+    } else {
+      lower.define (name, stval);
+      upper.define (name, endval);
+    }
+    Vector<uInt> irows = index.getRowNumbers (True, True);
+    allRows.resize (nr + irows.nelements(), False, True);
+    for (uInt j=0; j<irows.nelements(); j++) {
+      allRows[nr++] = irows[j];
+    }
+  }
+  // Put the rows in ascending order.
+  rows.resize (nr);
+  for (uInt i=0; i<nr; i++) {
+    rows[i] = allRows[i];
+  }
+  GenSort<uInt>::sort (rows);
+}
+
+void TableExprPlanner::findRows (const TableExprRange& range,
+                                 Vector<uInt>& rows, uInt& nrinterval)
+{
+  // The intervals are ordered and disjoint (see TableExprRange::mixOr),
+  // thus the resulting row numbers are in ascending order.
+  // A boundary at DBL_MAX is taken as infinity, so infinite values match.
+  const TableColumn& column = range.getColumn();
+  uInt nrow = column.nrow();
+  const Vector<Double>& st  = range.start();
+  const Vector<Double>& end = range.end();
+  nrinterval = st.nelements();
+  Block<uInt> rowst(nrinterval);
+  Block<uInt> rowend(nrinterval);
+  uInt nr = 0;
+  for (uInt i=0; i<nrinterval; i++) {
+    rowst[i]  = (st[i] <= -DBL_MAX  ?  0 : findRow (column, st[i], False));
+    rowend[i] = (end[i] >= DBL_MAX  ?  nrow : findRow (column, end[i], True));
+    if (i > 0  &&  rowst[i] < rowend[i-1]) {
+      rowst[i] = rowend[i-1];
+    }
+    if (rowend[i] < rowst[i]) {
+      rowend[i] = rowst[i];
+    }
+    nr += rowend[i] - rowst[i];
+  }
+  rows.resize (nr);
+  nr = 0;
+  for (uInt i=0; i<nrinterval; i++) {
+    for (uInt row=rowst[i]; row<rowend[i]; row++) {
+      rows[nr++] = row;
+    }
+  }
+}
+
+uInt TableExprPlanner::findRow (const TableColumn& column, Double value,
+                                Bool after)
+{
+  uInt st = 0;
+  uInt end = column.nrow();
+  while (st < end) {
+    uInt mid = st + (end-st)/2;
+    Double val = column.asdouble (mid);
+    if (val < value  ||  (after  &&  val == value)) {
+      st = mid+1;
+    } else {
+      end = mid;
+    }
+  }
+  return st;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,189 @@
+//# ExprPlanner.h: Plan the evaluation of a table selection expression
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef TABLES_EXPRPLANNER_H
+#define TABLES_EXPRPLANNER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class TableExprNode;
+class TableExprRange;
+class TableColumn;
+
+
+// <summary>
+// Plan the evaluation of a table selection expression
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tExprPlanner.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TableExprNode>TableExprNode</linkto>
+//   <li> <linkto class=TableExprRange>TableExprRange</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TableExprPlanner determines how a selection expression on a table can
+// be evaluated. By default the expression is evaluated for all rows
+// (a full scan). However, if the
+// <linkto class=TableExprRange>ranges</linkto> of the expression tell
+// that the values of a scalar column have to be in some intervals
+// (e.g. <src>TIME > t1 && TIME < t2</src>) and that column is in
+// ascending order (which is usually the case for the TIME column in
+// a MeasurementSet), the rows matching the intervals can be found using
+// a binary search on the column. The expression only needs to be
+// evaluated for these candidate rows.
+// <br>Because the ranges of an expression are a superset of the values
+// that can match, evaluating the full expression for the candidate rows
+// gives exactly the same result as a full scan.
+// <p>
+// Whether a column is in ascending order, is determined by reading it once.
+// The result is cached in the table object, so later selections on the
+// same table only need to do the binary search.
+// The cache is invalidated when the number of rows or the modify counter
+// of the table changes.
+// Because changes made by the process itself do not change the
+// modify counter until the table is unlocked, the sort order is only
+// used for readonly root tables.
+// <p>
+// <br>If the column is not in ascending order, but an up-to-date persistent
+// <linkto class=ColumnsIndex>ColumnsIndex</linkto> exists for it
+// (see <src>ColumnsIndex::makePersistent</src>), the index is used to
+// look up the rows matching the intervals. It can only be done for
+// an Int or Double column. An outdated index is not used, because
+// recreating it is more expensive than the other access paths.
+// <p>
+// Otherwise, if the storage manager keeps a zone map for the column
+// (see <linkto class=StandardStMan>StandardStMan</linkto>), the blocks of
+// rows whose minimum and maximum do not overlap the intervals are skipped.
+// Zone maps are always kept up-to-date by the storage manager, so they
+// can also be used for a writable table.
+// <p>
+// If multiple columns can be used, the one resulting in the fewest
+// candidate rows is chosen.
+// The function <src>description</src> tells which plan is used;
+// TaQL shows it when timings or tracing are requested.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms");
+//   TableExprNode expr (tab.col("TIME") > 4.5e9  &&  tab.col("ANTENNA1") == 1);
+//   TableExprPlanner planner (expr, tab);
+//   cout << planner.description() << endl;
+//   if (planner.hasRows()) {
+//     // Only these rows can match the expression.
+//     const Vector<uInt>& rows = planner.rows();
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Selections on a time range are very common for MeasurementSets.
+// Scanning the entire table for them is needlessly expensive.
+// </motivation>
+
+class TableExprPlanner
+{
+public:
+    // Make the plan for selecting rows in the table using the expression.
+    TableExprPlanner (const TableExprNode& node, const Table& table);
+
+    // Can the selection be limited to the candidate rows?
+    Bool hasRows() const
+      { return hasRows_p; }
+
+    // Get the candidate row numbers (in ascending order).
+    const Vector<uInt>& rows() const
+      { return rows_p; }
+
+    // Get a description of the plan.
+    const String& description() const
+      { return description_p; }
+
+    // Test if the values in a scalar numeric column are in ascending order.
+    // It returns False if the column contains a NaN.
+    static Bool isSorted (const TableColumn& column);
+
+private:
+    // The possible ways to find the candidate rows.
+    enum AccessPath {
+      FullScan,
+      SortedColumn,
+      PersistentIndex,
+      ZoneMap
+    };
+
+    // Determine how the range can be used for the table.
+    static AccessPath accessPath (const TableExprRange& range,
+                                  const Table& table);
+
+    // Find the rows matching the intervals of the range using the
+    // persistent index of the column.
+    static void findIndexRows (const TableExprRange& range,
+                               const Table& table,
+                               Vector<uInt>& rows, uInt& nrinterval);
+
+    // Does the storage manager keep a zone map for the column?
+    static Bool hasZoneMap (const TableColumn& column);
+
+    // Find the rows in the blocks of the zone map of the column
+    // overlapping the intervals of the range.
+    static void findZoneRows (const TableExprRange& range,
+                              Vector<uInt>& rows, uInt& nrinterval);
+
+    // Find the rows matching the intervals of the range.
+    // The column must be in ascending order.
+    static void findRows (const TableExprRange& range, Vector<uInt>& rows,
+                          uInt& nrinterval);
+
+    // Find the first row with a value >= (or > if <src>after</src> is set)
+    // the given value.
+    static uInt findRow (const TableColumn& column, Double value, Bool after);
+
+    //# Data members
+    Bool         hasRows_p;
+    Vector<uInt> rows_p;
+    String       description_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
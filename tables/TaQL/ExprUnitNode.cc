@@ -139,6 +139,17 @@ Double TableExprNodeUnit::getDouble (const TableExprId& id)
 DComplex TableExprNodeUnit::getDComplex (const TableExprId& id)
   { return factor_p * lnode_p->getDComplex(id); }
 
+void TableExprNodeUnit::getDoubles (const Vector<uInt>& rownrs,
+                                    Block<Double>& result)
+{
+  lnode_p->getDoubles (rownrs, result);
+  uInt nr = rownrs.nelements();
+  Double* res = result.storage();
+  for (uInt i=0; i<nr; i++) {
+    res[i] *= factor_p;
+  }
+}
+
 
 
 
@@ -91,6 +91,8 @@ public:
 
   virtual Double   getDouble   (const TableExprId& id);
   virtual DComplex getDComplex (const TableExprId& id);
+  virtual void getDoubles (const Vector<uInt>& rownrs,
+                           Block<Double>& result);
 private:
   Double factor_p;
 };
@@ -247,12 +247,47 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   TaQLNodeResult TaQLNodeHandler::visitFuncNode (const TaQLFuncNodeRep& node)
   {
-    TaQLNodeResult result = visitNode (node.itsArgs);
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
-    hrval->setExpr (topStack()->handleFunc (node.itsName,
-					    getHR(result).getExprSet(),
-					    node.style()));
+    TableParseSelect* sel = topStack();
+    sel->startFuncArgs (node.itsName);
+    TaQLNodeResult result = visitNode (node.itsArgs);
+    sel->endFuncArgs (node.itsName);
+    const TableExprNodeSet& args = getHR(result).getExprSet();
+    // An identical function call in the query can share the node.
+    // The call is identical if the function and the operand nodes are the
+    // same, thus if all operands are shared nodes themselves. The key
+    // consists of the keys of the operands.
+    // Note that the text cannot be used, because a name can resolve to
+    // different columns in different clauses.
+    String key = downcase(node.itsName) + '(';
+    Bool canShare = True;
+    for (uInt i=0; i<args.nelements(); ++i) {
+      String argKey;
+      if (args[i].isSingle()) {
+        argKey = sel->sharedNodeKey (args[i].start());
+      }
+      if (argKey.empty()) {
+        canShare = False;
+        break;
+      }
+      if (i > 0) {
+        key += ',';
+      }
+      key += argKey;
+    }
+    key += ')';
+    if (canShare) {
+      TableExprNode shared = sel->findSharedNode (key);
+      if (! shared.isNull()) {
+        hrval->setExpr (shared);
+        return res;
+      }
+    }
+    hrval->setExpr (sel->handleFunc (node.itsName, args, node.style()));
+    if (canShare) {
+      sel->addSharedNode (key, hrval->getExpr());
+    }
     return res;
   }
 
@@ -497,7 +532,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (! node.getNoExecute()) {
       if (outer) {
 	curSel->execute (node.style().doTiming(), False, False, 0,
-                         node.style().doTracing());
+                         node.style().doTracing(), node.style().nthread());
 	hrval->setTable (curSel->getTable());
 	hrval->setNames (new Vector<String>(curSel->getColumnNames()));
 	hrval->setString ("select");
@@ -522,7 +557,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     handleWhere   (node.itsWhere);
     visitNode     (node.itsSort);
     visitNode     (node.itsLimitOff);
-    curSel->execute (node.style().doTiming(), False, True, 0);
+    curSel->execute (node.style().doTiming(), False, True, 0, False,
+                     node.style().nthread());
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
     hrval->setTable (curSel->getTable());
@@ -549,7 +585,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       curSel->handleInsert (topStack());
       addedSel = True;
     }
-    curSel->execute (node.style().doTiming(), False, True, 0);
+    curSel->execute (node.style().doTiming(), False, True, 0, False,
+                     node.style().nthread());
     if (addedSel) {
       popStack();        // remove insert subquery
     }
@@ -569,7 +606,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     handleWhere   (node.itsWhere);
     visitNode     (node.itsSort);
     visitNode     (node.itsLimitOff);
-    curSel->execute (node.style().doTiming(), False, True, 0);
+    curSel->execute (node.style().doTiming(), False, True, 0, False,
+                     node.style().nthread());
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
     hrval->setTable (curSel->getTable());
@@ -590,7 +628,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TaQLNodeResult res(hrval);
     AlwaysAssert (! node.getNoExecute(), AipsError);
     if (outer) {
-      curSel->execute (node.style().doTiming(), False, True, 0);
+      curSel->execute (node.style().doTiming(), False, True, 0, False,
+                       node.style().nthread());
       hrval->setTable (curSel->getTable());
       hrval->setNames (new Vector<String>(curSel->getColumnNames()));
       hrval->setString ("count");
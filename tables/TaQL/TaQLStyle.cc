@@ -28,6 +28,8 @@
 #include <casacore/tables/TaQL/TaQLStyle.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <ctype.h>
+#include <stdlib.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -37,7 +39,8 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsNThread   (0)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -47,7 +50,18 @@ TaQLStyle::TaQLStyle (uInt origin)
 void TaQLStyle::set (const String& value)
 {
   String val = upcase(value);
-  if (val == "GLISH") {
+  String::size_type pos = val.find ('=');
+  if (pos != String::npos) {
+    if (trim(String(val.before(pos))) == "NTHREADS") {
+      String nthr = trim(String(val.after(pos)));
+      if (nthr.empty()  ||  !isdigit(nthr[0])) {
+        throw TableError(value + " is an invalid TaQL STYLE value");
+      }
+      itsNThread = atoi(nthr.c_str());
+    } else {
+      defineSynonym (value);
+    }
+  } else if (val == "GLISH") {
     itsOrigin  = 1;
     itsEndExcl = False;
     itsCOrder  = False;
@@ -85,6 +99,7 @@ void TaQLStyle::reset()
   set ("GLISH"); 
   itsDoTiming  = False;
   itsDoTracing = False;
+  itsNThread   = 0;
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
@@ -54,7 +54,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // The default style is Glish.
 //
 // The class is also used to tell the TaQL execution engine if timings
-// or tracing of the various parts of the TaQL command need to be done.
+// or tracing of the various parts of the TaQL command need to be done
+// and how many threads can be used to evaluate the WHERE and GROUPBY
+// clauses (using <src>NTHREADS=n</src>).
 //
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
@@ -73,6 +75,8 @@ public:
   // Set the style according to the (case-insensitive) value.
   // Possible values are Glish, Python, Base0, Base1, FortranOrder, Corder,
   // InclEnd, and ExclEnd.
+  // A value like <src>NTHREADS=n</src> sets the number of threads;
+  // another value containing an = defines a UDF library synonym.
   void set (const String& value);
 
   // Define a UDF library name synonym.
@@ -99,6 +103,10 @@ public:
     { return itsCOrder; }
   // </group>
 
+  // Get the number of threads to use (0 means the default).
+  uInt nthread() const
+    { return itsNThread; }
+
   // Set if timing needs to be done.
   void setTiming (Bool doTiming)
     { itsDoTiming = doTiming; }
@@ -121,6 +129,7 @@ private:
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  uInt itsNThread;
   std::map<String,String> itsUDFLibNameMap;
 };
 
@@ -149,7 +149,7 @@ NAME      \\?[A-Za-z_]([A-Za-z_0-9]|(\\.))*
 NAMEFLD   {NAME}?"."?{NAME}?("::")?{NAME}("."{NAME})*
 TEMPTAB   [$]{INT}
 NAMETAB   ([A-Za-z0-9_./+\-~$@:]|(\\.))+
-UDFLIBSYN {NAME}{WHITE}"="{WHITE}{NAME}
+UDFLIBSYN {NAME}{WHITE}"="{WHITE}({NAME}|{INT})
 REGEX1    m"/"[^/]+"/"
 REGEX2    m%[^%]+%
 REGEX3    m#[^#]+#
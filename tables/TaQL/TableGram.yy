@@ -230,9 +230,9 @@ stylelist: stylelist COMMA NAME
          | NAME
              { TaQLNode::theirStyle.set ($1->getString()); }
          | stylelist COMMA UDFLIBSYN
-             { TaQLNode::theirStyle.defineSynonym ($3->getString()); }
+             { TaQLNode::theirStyle.set ($3->getString()); }
          | UDFLIBSYN
-             { TaQLNode::theirStyle.defineSynonym ($1->getString()); }
+             { TaQLNode::theirStyle.set ($1->getString()); }
          ;
 
 command:   selcomm
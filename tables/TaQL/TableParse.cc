@@ -34,7 +34,9 @@
 #include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/TaQL/ExprDerNodeArray.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
+#include <casacore/tables/TaQL/ExprPlanner.h>
 #include <casacore/tables/TaQL/ExprAggrNode.h>
+#include <casacore/tables/TaQL/ExprAggrNodeArray.h>
 #include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
 #include <casacore/tables/TaQL/ExprRange.h>
@@ -59,14 +61,21 @@
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/GenSort.h>
+#include <casacore/casa/Utilities/ExternalSort.h>
 #include <casacore/casa/Utilities/LinearSearch.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/ostream.h>
+#include <casacore/casa/sstream.h>
 
 #include <casacore/casa/Containers/BlockIO.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -170,7 +179,8 @@ TableParseSelect::TableParseSelect (CommandType commandType)
     stride_p        (1),
     insSel_p        (0),
     noDupl_p        (False),
-    order_p         (Sort::Ascending)
+    order_p         (Sort::Ascending),
+    aggrLevel_p     (0)
 {}
 
 TableParseSelect::~TableParseSelect()
@@ -473,9 +483,27 @@ TableExprNode TableParseSelect::handleKeyCol (const String& name, Bool tryProj)
       }
     }
     // Create column or keyword node.
+    // A column used multiple times in the query can share the node.
+    // The key is the column the name resolves to (not the name itself,
+    // because it can be a new name of a column in the projection).
+    // A table always has a unique name (also a temporary one).
+    std::ostringstream key;
+    if (tryProj) {
+      key << tab.tableName() << "::" << columnName;
+      for (uInt i=0; i<fieldNames.size(); ++i) {
+        key << '.' << fieldNames[i];
+      }
+      TableExprNode node = findSharedNode (key.str());
+      if (! node.isNull()) {
+        return node;
+      }
+    }
     try {
       TableExprNode node(tab.keyCol (columnName, fieldNames));
       addApplySelNode (node);
+      if (tryProj) {
+        addSharedNode (key.str(), node);
+      }
       return node;
     } catch (const TableError&) {
       throw TableInvExpr (name + " is an unknown column (or keyword) in table "
@@ -918,6 +946,64 @@ TableExprNode TableParseSelect::handleFunc (const String& name,
   return node;
 }
 
+TableExprNode TableParseSelect::findSharedNode (const String& key)
+{
+  if (aggrLevel_p > 0) {
+    return TableExprNode();
+  }
+  std::map<String,TableExprNode>::iterator iter = sharedNodes_p.find (key);
+  if (iter == sharedNodes_p.end()) {
+    return TableExprNode();
+  }
+  TableExprNodeArray* node = dynamic_cast<TableExprNodeArray*>
+    (const_cast<TableExprNodeRep*>(iter->second.getNodeRep()));
+  node->setCaching (True);
+  return iter->second;
+}
+
+void TableParseSelect::addSharedNode (const String& key,
+                                      const TableExprNode& node)
+{
+  if ((commandType_p != PSELECT  &&  commandType_p != PCOUNT  &&
+       commandType_p != PCALC)  ||  aggrLevel_p > 0) {
+    return;
+  }
+  const TableExprNodeRep* rep = node.getNodeRep();
+  if (dynamic_cast<const TableExprNodeArrayColumn*>(rep)  ||
+      (dynamic_cast<const TableExprFuncNodeArray*>(rep)  &&
+       ! dynamic_cast<const TableExprAggrNodeArray*>(rep))) {
+    sharedNodes_p[key] = node;
+  }
+}
+
+String TableParseSelect::sharedNodeKey (const TableExprNodeRep* node) const
+{
+  for (std::map<String,TableExprNode>::const_iterator
+         iter=sharedNodes_p.begin(); iter!=sharedNodes_p.end(); ++iter) {
+    if (iter->second.getNodeRep() == node) {
+      return iter->first;
+    }
+  }
+  return String();
+}
+
+void TableParseSelect::startFuncArgs (const String& funcName)
+{
+  // Note that a user defined function can also be an aggregate.
+  if (findFunc (funcName, 0, Vector<Int>()) >=
+      TableExprFuncNode::FirstAggrFunc) {
+    aggrLevel_p++;
+  }
+}
+
+void TableParseSelect::endFuncArgs (const String& funcName)
+{
+  if (findFunc (funcName, 0, Vector<Int>()) >=
+      TableExprFuncNode::FirstAggrFunc) {
+    aggrLevel_p--;
+  }
+}
+
 TableExprNode TableParseSelect::makeUDFNode (TableParseSelect* sel,
                                              const String& name,
                                              const TableExprNodeSet& arguments,
@@ -2274,7 +2360,8 @@ Table TableParseSelect::doCount (Bool showTimings, const Table& table)
 
 //# Execute the groupby.
 CountedPtr<TableExprGroupResult> TableParseSelect::doGroupby
-(Bool showTimings, vector<TableExprNodeRep*> aggrNodes, Int groupAggrUsed)
+(Bool showTimings, vector<TableExprNodeRep*> aggrNodes, Int groupAggrUsed,
+ uInt nthread)
 {
   Timer timer;
   // If only 'select count(*)' was given, get the size of the WHERE,
@@ -2284,7 +2371,7 @@ CountedPtr<TableExprGroupResult> TableParseSelect::doGroupby
       (groupAggrUsed & GROUPBY) == 0) {
     result = doOnlyCountAll (aggrNodes[0]);
   } else {
-    result = doGroupByAggr (aggrNodes);
+    result = doGroupByAggr (aggrNodes, nthread);
   }
   if (showTimings) {
     timer.show ("  Groupby     ");
@@ -2292,12 +2379,36 @@ CountedPtr<TableExprGroupResult> TableParseSelect::doGroupby
   return result;
 }
 
+uInt TableParseSelect::getNThread (uInt nthread)
+{
+  if (nthread == 0) {
+    Int nthr;
+    AipsrcValue<Int>::find (nthr, "table.taql.nthreads", 1);
+#ifdef _OPENMP
+    if (nthr <= 0) {
+      nthr = omp_get_max_threads();
+    }
+#endif
+    nthread = std::max (nthr, 1);
+  }
+#ifndef _OPENMP
+  nthread = 1;
+#endif
+  return nthread;
+}
+
 Table TableParseSelect::adjustApplySelNodes (const Table& table)
 {
   for (vector<TableExprNode>::iterator iter=applySelNodes_p.begin();
        iter!=applySelNodes_p.end(); ++iter) {
     iter->applySelection (rownrs_p);
   }
+  // The row numbers change, so cached values of shared nodes are invalid.
+  for (std::map<String,TableExprNode>::iterator iter=sharedNodes_p.begin();
+       iter!=sharedNodes_p.end(); ++iter) {
+    dynamic_cast<TableExprNodeArray*>
+      (const_cast<TableExprNodeRep*>(iter->second.getNodeRep()))->clearCache();
+  }
   // Create the subset.
   Table tab(table(rownrs_p));
   // From now on use row numbers 0..n.
@@ -2355,52 +2466,39 @@ CountedPtr<TableExprGroupResult> TableParseSelect::doOnlyCountAll
   return CountedPtr<TableExprGroupResult>(new TableExprGroupResult(funcSets));
 }
 
-vector<CountedPtr<TableExprGroupFuncSet> >
-TableParseSelect::doGroupByAggrMultipleKeys
-(const vector<TableExprNodeRep*>& aggrNodes)
-{
-  // We have to group the data according to the (maybe empty) groupby.
-  // We step through the table in the normal order which may not be the
-  // groupby order.
-  // A map<key,int> is used to keep track of the results where the int
-  // is the index in a vector of a set of aggregate function objects.
-  vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-  std::map<TableExprGroupKeySet, int> keyFuncMap;
-  // Create the set of groupby key objects.
-  TableExprGroupKeySet keySet(groupbyNodes_p);
-  // Loop through all rows.
-  // For each row generate the key to get the right entry.
-  TableExprId rowid(0);
-  for (uInt i=0; i<rownrs_p.size(); ++i) {
-    rowid.setRownr (rownrs_p[i]);
-    keySet.fill (groupbyNodes_p, rowid);
-    int groupnr = funcSets.size();
-    std::map<TableExprGroupKeySet, int>::iterator iter=keyFuncMap.find (keySet);
-    if (iter == keyFuncMap.end()) {
-      keyFuncMap[keySet] = groupnr;
-      funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
-    } else {
-      groupnr = iter->second;
-    }
-    funcSets[groupnr]->apply (rowid);
-  }
-  return funcSets;
-}
-
 CountedPtr<TableExprGroupResult> TableParseSelect::doGroupByAggr
-(const vector<TableExprNodeRep*>& aggrNodes)
+(const vector<TableExprNodeRep*>& aggrNodes, uInt nthread)
 {
   // Get the aggregate functions to be evaluated lazily.
+  // The groups can only be formed in parallel if the partial results of
+  // all aggregate functions can be merged and if the operands can be
+  // evaluated by multiple threads.
   vector<TableExprNodeRep*> immediateNodes;
   vector<TableExprNodeRep*> lazyNodes;
+  Bool canMerge = True;
   for (uInt i=0; i<aggrNodes.size(); ++i) {
-    aggrNodes[i]->makeGroupAggrFunc();
+    CountedPtr<TableExprGroupFuncBase> func =
+      aggrNodes[i]->makeGroupAggrFunc();
     if (aggrNodes[i]->isLazyAggregate()) {
       lazyNodes.push_back (aggrNodes[i]);
+      canMerge = False;
     } else {
       immediateNodes.push_back (aggrNodes[i]);
+      TableExprAggrNode* node = dynamic_cast<TableExprAggrNode*>(aggrNodes[i]);
+      if (!func->canMerge()  ||  !node  ||
+          (node->operand()  &&  !node->operand()->isThreadSafe())) {
+        canMerge = False;
+      }
+    }
+  }
+  for (uInt i=0; i<groupbyNodes_p.size(); ++i) {
+    if (! groupbyNodes_p[i].getNodeRep()->isThreadSafe()) {
+      canMerge = False;
     }
   }
+  nthread = (canMerge  ?  getNThread(nthread) : 1);
+  // Use at least some rows per thread.
+  nthread = std::max (1u, std::min (nthread, uInt(rownrs_p.size() / 1024)));
   uInt nimmediate = immediateNodes.size();
   // For lazy nodes a vector of TableExprId-s needs to be filled per group.
   // So add a node collecting the ids.
@@ -2416,12 +2514,14 @@ CountedPtr<TableExprGroupResult> TableParseSelect::doGroupByAggr
   // Use a faster way for a single groupby key.
   if (groupbyNodes_p.size() == 1  &&
       groupbyNodes_p[0].dataType() == TpDouble) {
-    funcSets = doGroupByAggrSingleKey<Double> (immediateNodes);
+    funcSets = doGroupByAggrKey (immediateNodes, Double(0), nthread);
   } else if (groupbyNodes_p.size() == 1  &&
              groupbyNodes_p[0].dataType() == TpInt) {
-    funcSets = doGroupByAggrSingleKey<Int64> (immediateNodes);
+    funcSets = doGroupByAggrKey (immediateNodes, Int64(0), nthread);
   } else {
-    funcSets = doGroupByAggrMultipleKeys (immediateNodes);
+    funcSets = doGroupByAggrKey (immediateNodes,
+                                 TableExprGroupKeySet(groupbyNodes_p),
+                                 nthread);
   }
   // Let the function nodes finish their operation.
   // Form the rownr vector from the rows kept in the aggregate objects.
@@ -2507,7 +2607,63 @@ void TableParseSelect::doSort (Bool showTimings)
     //# This throws an exception for unknown data types (datetime, regex).
     key.node().getColumnDataType();
   }
+  uInt nrrow = rownrs_p.size();
+  uInt runSize = sortRunSize();
+  if (runSize >= nrrow) {
+    rownrs_p.reference (sortRows (rownrs_p, 0));
+  } else {
+    // Too many rows to sort in memory, so sort in runs and merge them.
+    String dir;
+    AipsrcValue<String>::find (dir, "table.taql.sortdirectory", ".");
+    ExternalSort extSort(dir);
+    for (i=0; i<nrkey; i++) {
+      const TableParseSort& key = sort_p[i];
+      extSort.sortKey (key.node().getColumnDataType(), getOrder(key));
+    }
+    for (uInt st=0; st<nrrow; st+=runSize) {
+      uInt nr = std::min (runSize, nrrow-st);
+      sortRows (rownrs_p(Slice(st, nr)).copy(), &extSort);
+    }
+    Vector<uInt> newRownrs;
+    extSort.merge (newRownrs, noDupl_p);
+    rownrs_p.reference (newRownrs);
+  }
+  if (showTimings) {
+    timer.show ("  Orderby     ");
+  }
+}
+
+uInt TableParseSelect::sortRunSize() const
+{
+  Double mem;
+  AipsrcValue<Double>::find (mem, "table.taql.sortmemory", 0.);
+  uInt nrrow = rownrs_p.size();
+  if (mem <= 0) {
+    return nrrow;
+  }
+  // Each row needs the key values, an index and a row number.
+  uInt rowSize = 2*sizeof(uInt);
+  for (uInt i=0; i<sort_p.size(); i++) {
+    DataType dtype = sort_p[i].node().getColumnDataType();
+    rowSize += ValType::getTypeSize (dtype);
+    if (dtype == TpString) {
+      rowSize += 16;            // guess for the string contents
+    }
+  }
+  Double nr = mem * 1024*1024 / rowSize;
+  if (nr >= nrrow) {
+    return nrrow;
+  }
+  return std::max (uInt(nr), 1024u);
+}
+
+Vector<uInt> TableParseSelect::sortRows (const Vector<uInt>& rownrs,
+                                         ExternalSort* extSort)
+{
+  uInt i;
+  uInt nrkey = sort_p.size();
   Block<void*> arrays(nrkey);
+  Block<const void*> keyData(nrkey);
   Sort sort;
   Bool deleteIt;
   for (i=0; i<nrkey; i++) {
@@ -2516,8 +2672,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpBool:
       {
         Array<Bool>* array = new Array<Bool>
-          (key.node().getColumnBool(rownrs_p));
+          (key.node().getColumnBool(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const Bool* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpBool, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2526,8 +2683,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpUChar:
       {
         Array<uChar>* array = new Array<uChar>
-          (key.node().getColumnuChar(rownrs_p));
+          (key.node().getColumnuChar(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const uChar* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpUChar, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2536,8 +2694,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpShort:
       {
         Array<Short>* array = new Array<Short>
-          (key.node().getColumnShort(rownrs_p));
+          (key.node().getColumnShort(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const Short* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpShort, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2546,8 +2705,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpUShort:
       {
         Array<uShort>* array = new Array<uShort>
-          (key.node().getColumnuShort(rownrs_p));
+          (key.node().getColumnuShort(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const uShort* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpUShort, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2556,8 +2716,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpInt:
       {
         Array<Int>* array = new Array<Int>
-          (key.node().getColumnInt(rownrs_p));
+          (key.node().getColumnInt(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const Int* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpInt, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2566,8 +2727,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpUInt:
       {
         Array<uInt>* array = new Array<uInt>
-          (key.node().getColumnuInt(rownrs_p));
+          (key.node().getColumnuInt(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const uInt* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpUInt, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2576,8 +2738,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpFloat:
       {
         Array<Float>* array = new Array<Float>
-          (key.node().getColumnFloat(rownrs_p));
+          (key.node().getColumnFloat(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const Float* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpFloat, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2586,8 +2749,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpDouble:
       {
         Array<Double>* array = new Array<Double>
-          (key.node().getColumnDouble(rownrs_p));
+          (key.node().getColumnDouble(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const Double* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpDouble, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2596,8 +2760,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpComplex:
       {
         Array<Complex>* array = new Array<Complex>
-          (key.node().getColumnComplex(rownrs_p));
+          (key.node().getColumnComplex(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const Complex* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpComplex, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2606,8 +2771,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpDComplex:
       {
         Array<DComplex>* array = new Array<DComplex>
-          (key.node().getColumnDComplex(rownrs_p));
+          (key.node().getColumnDComplex(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const DComplex* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpDComplex, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2616,8 +2782,9 @@ void TableParseSelect::doSort (Bool showTimings)
     case TpString:
       {
         Array<String>* array = new Array<String>
-          (key.node().getColumnString(rownrs_p));
+          (key.node().getColumnString(rownrs));
         arrays[i] = array;
+        keyData[i] = array->data();
         const String* data = array->getStorage (deleteIt);
         sort.sortKey (data, TpString, 0, getOrder(key));
         array->freeStorage (data, deleteIt);
@@ -2627,13 +2794,17 @@ void TableParseSelect::doSort (Bool showTimings)
       AlwaysAssert (False, AipsError);
     }
   }
-  uInt nrrow = rownrs_p.size();
+  uInt nrrow = rownrs.size();
   Vector<uInt> newRownrs (nrrow);
   int sortOpt = Sort::HeapSort;                  
   if (noDupl_p) {
     sortOpt += Sort::NoDuplicates;
   }
   sort.sort (newRownrs, nrrow, sortOpt);
+  if (extSort) {
+    extSort->addRun (keyData, newRownrs, rownrs);
+    newRownrs.resize();
+  }
   for (i=0; i<nrkey; i++) {
     const TableParseSort& key = sort_p[i];
     switch (key.node().getColumnDataType()) {
@@ -2674,14 +2845,11 @@ void TableParseSelect::doSort (Bool showTimings)
       AlwaysAssert (False, AipsError);
     }
   }
-  if (showTimings) {
-    timer.show ("  Orderby     ");
-  }
   // Convert index to rownr.
   for (uInt i=0; i<newRownrs.size(); ++i) {
-    newRownrs[i] = rownrs_p[newRownrs[i]];
+    newRownrs[i] = rownrs[newRownrs[i]];
   }
-  rownrs_p.reference (newRownrs);
+  return newRownrs;
 }
 
 
@@ -3017,19 +3185,59 @@ Table TableParseSelect::doDistinct (Bool showTimings, const Table& table)
 {
   Timer timer;
   Table result;
-  // Sort the table uniquely on all columns.
-  Table tabs = table.sort (columnNames_p, Sort::Ascending,
-                           Sort::QuickSort|Sort::NoDuplicates);
-  if (tabs.nrow() == table.nrow()) {
+  // Make a key node for each column. A hash index on the keys can be used
+  // if all columns are scalars with a type usable as a groupby key.
+  vector<TableExprNode> keyNodes;
+  keyNodes.reserve (columnNames_p.size());
+  Bool useHash = True;
+  for (uInt i=0; i<columnNames_p.size(); ++i) {
+    TableExprNode node = table.col (columnNames_p[i]);
+    if (!node.isScalar()  ||
+        node.getNodeRep()->dataType() == TableExprNodeRep::NTComplex) {
+      useHash = False;
+      break;
+    }
+    keyNodes.push_back (node);
+  }
+  Vector<uInt> rownrs;
+  Bool allUnique = False;
+  if (useHash) {
+    // Keep the first row of each distinct keyset. Doing it in a single
+    // pass retains the original row order, so no sort is needed.
+    TableExprGroupHash<TableExprGroupKeySet> keyIndex;
+    TableExprGroupKeySet keySet(keyNodes);
+    rownrs.resize (table.nrow());
+    TableExprId rowid(0);
+    Bool isNew;
+    uInt nr = 0;
+    for (uInt i=0; i<table.nrow(); ++i) {
+      rowid.setRownr (i);
+      keySet.fill (keyNodes, rowid);
+      keyIndex.find (keySet, isNew);
+      if (isNew) {
+        rownrs[nr++] = i;
+      }
+    }
+    rownrs.resize (nr, True);
+    allUnique = (nr == table.nrow());
+  } else {
+    // Sort the table uniquely on all columns.
+    Table tabs = table.sort (columnNames_p, Sort::Ascending,
+                             Sort::QuickSort|Sort::NoDuplicates);
+    allUnique = (tabs.nrow() == table.nrow());
+    if (! allUnique) {
+      // Get the rownumbers.
+      // Make sure it does not reference an internal array.
+      rownrs = tabs.rowNumbers(table);
+      rownrs.unique();
+      // Put the rownumbers back in the original order.
+      GenSort<uInt>::sort (rownrs);
+    }
+  }
+  if (allUnique) {
     // Everything was already unique.
     result = table;
   } else {
-    // Get the rownumbers.
-    // Make sure it does not reference an internal array.
-    Vector<uInt> rownrs(tabs.rowNumbers(table));
-    rownrs.unique();
-    // Put the rownumbers back in the original order.
-    GenSort<uInt>::sort (rownrs);
     result = table(rownrs);
     rownrs_p.reference (rownrs);
   }
@@ -3066,7 +3274,7 @@ void TableParseSelect::handleGiving (const TableExprNodeSet& set)
 //# Execute all parts of a TaQL command doing some selection.
 void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
 				Bool mustSelect, uInt maxRow,
-                                Bool doTracing)
+                                Bool doTracing, uInt nthread)
 {
   //# A selection query consists of:
   //#  - SELECT to do projection
@@ -3173,10 +3381,19 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
 //#//		 << rang[i].end() << endl;
 //#//	}
     Timer timer;
-    resultTable = table(node_p, nrmax);
+    resultTable = table(node_p, nrmax, 0, nthread);
     if (showTimings) {
       timer.show ("  Where       ");
     }
+    if (showTimings  ||  doTracing) {
+      TableExprPlanner planner (node_p, table);
+      if (showTimings) {
+        cout << "    plan: " << planner.description() << endl;
+      }
+      if (doTracing) {
+        cerr << "WHERE plan: " << planner.description() << endl;
+      }
+    }
     if (doTracing) {
       cerr << "WHERE resulted in " << resultTable.nrow() << " rows" << endl;
     }
@@ -3186,7 +3403,8 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
   // Execute possible groupby/aggregate.
   CountedPtr<TableExprGroupResult> groupResult;
   if (groupAggrUsed != 0) {
-    groupResult = doGroupby (showTimings, aggrNodes, groupAggrUsed);
+    groupResult = doGroupby (showTimings, aggrNodes, groupAggrUsed,
+                             nthread);
     // Aggregate results and normal table rows need to have the same rownrs,
     // so set the selected rows in the table column objects.
     resultTable = adjustApplySelNodes(table);
@@ -50,6 +50,7 @@ class TableExprNodeSetElem;
 class TableExprNodeIndex;
 class TableColumn;
 class AipsIO;
+class ExternalSort;
 template<class T> class Vector;
 
 
@@ -383,8 +384,11 @@ public:
   // Optionally the maximum nr of rows to be selected can be given.
   // It will be used as the default value for the LIMIT clause.
   // 0 = no maximum.
+  // The WHERE and GROUPBY clauses are evaluated using <src>nthread</src>
+  // threads if possible (0 = default, see Table::operator()).
   void execute (Bool showTimings, Bool setInGiving,
-                Bool mustSelect, uInt maxRow, Bool doTracing=False);
+                Bool mustSelect, uInt maxRow, Bool doTracing=False,
+                uInt nthread=0);
 
   // Execute a query in a from clause resulting in a Table.
   Table doFromQuery (Bool showTimings);
@@ -476,6 +480,32 @@ public:
 			    const TableExprNodeSet& arguments,
 			    const TaQLStyle&);
 
+  // Find the node made before for an identical subexpression in one of
+  // the clauses of a query. The key identifies the column or the function
+  // and the keys of its operand nodes.
+  // It returns a null node if not found. If found, the node is used
+  // multiple times, so caching of its value per row is enabled.
+  TableExprNode findSharedNode (const String& key);
+
+  // Add a node that can be shared by identical subexpressions.
+  // Only array columns and array functions (except aggregates) are shared,
+  // because their values are expensive to get. It is only done for
+  // commands not modifying the data (SELECT, COUNT and CALC).
+  void addSharedNode (const String& key, const TableExprNode& node);
+
+  // Get the key of a shared node. An empty string is returned if the
+  // node is not shared.
+  String sharedNodeKey (const TableExprNodeRep* node) const;
+
+  // Tell that the arguments of a function are handled (start) or have
+  // been handled (end). Nodes used in the arguments of an aggregate
+  // function are not shared, because after a GROUPBY they are evaluated
+  // for the original rows, while other nodes use the selected rows.
+  // <group>
+  void startFuncArgs (const String& funcName);
+  void endFuncArgs (const String& funcName);
+  // </group>
+
   // Make a function object node for the given function name and arguments.
   // The ignoreFuncs vector contains invalid function codes.
   static TableExprNode makeFuncNode (TableParseSelect*,
@@ -579,9 +609,11 @@ private:
   Table adjustApplySelNodes (const Table&);
 
   // Do the groupby/aggregate step and return its result.
+  // The groups are formed using <src>nthread</src> threads if possible
+  // (0 = default, see Table::operator()).
   CountedPtr<TableExprGroupResult> doGroupby
   (bool showTimings, vector<TableExprNodeRep*> aggrNodes,
-   Int groupAggrUsed);
+   Int groupAggrUsed, uInt nthread);
 
   // Do the HAVING step.
   void doHaving (Bool showTimings,
@@ -590,13 +622,34 @@ private:
   // Do a groupby/aggregate step that only does a 'select count(*)'.
   CountedPtr<TableExprGroupResult> doOnlyCountAll (TableExprNodeRep* aggrNode);
 
+  // Get the number of threads to use. If 0 is given, it is taken from the
+  // aipsrc variable <src>table.taql.nthreads</src> (default 1) where a
+  // value <= 0 means all available cores. It is always 1 without OpenMP.
+  static uInt getNThread (uInt nthread);
+
   // Do a full groupby/aggregate step.
+  // Multiple threads are only used if all aggregate functions can merge
+  // partial results and if the groupby keys and aggregate operands are
+  // thread-safe.
   CountedPtr<TableExprGroupResult> doGroupByAggr
-  (const vector<TableExprNodeRep*>& aggrNodes);
+  (const vector<TableExprNodeRep*>& aggrNodes, uInt nthread);
 
   // Do the sort step.
+  // If the sort keys of all rows do not fit in the memory given by the
+  // aipsrc variable <src>table.taql.sortmemory</src> (in MB; 0 is
+  // unlimited), the rows are sorted in runs which are written to
+  // temporary files in directory <src>table.taql.sortdirectory</src>
+  // (default the working directory) and merged thereafter.
   void doSort (Bool showTimings);
 
+  // Sort the given rows. If <src>extSort</src> is given, the sorted rows
+  // are added to it as a run and an empty vector is returned.
+  // Otherwise the sorted row numbers are returned.
+  Vector<uInt> sortRows (const Vector<uInt>& rownrs, ExternalSort* extSort);
+
+  // Get the number of rows whose sort keys fit in the memory for sorting.
+  uInt sortRunSize() const;
+
   // Do the limit/offset step.
   void  doLimOff (Bool showTimings);
   Table doLimOff (Bool showTimings, const Table& table);
@@ -687,49 +740,110 @@ private:
   static Table findTableKey (const Table& table, const String& columnName,
 			     const Vector<String>& keyNames);
 
-  // Create the set of aggregate functions and groupby keys in case
-  // a single groupby key is given.
-  // This offers much faster map access then doGroupByAggrMultiple.
+  // Get the groupby key for the given row.
+  // A Double or Int64 key is used for a single groupby key, because it
+  // offers much faster hash access than TableExprGroupKeySet used for
+  // multiple keys.
+  // <group>
+  void getGroupKey (const TableExprId& rowid, Double& key)
+    { groupbyNodes_p[0].get (rowid, key); }
+  void getGroupKey (const TableExprId& rowid, Int64& key)
+    { groupbyNodes_p[0].get (rowid, key); }
+  void getGroupKey (const TableExprId& rowid, TableExprGroupKeySet& key)
+    { key.fill (groupbyNodes_p, rowid); }
+  // </group>
+
+  // Create the set of aggregate functions and groupby keys for the rows
+  // rownrs_p[st..end) using the given hash index.
+  // The given key object is used to hold the key values.
   template<typename T>
-  vector<CountedPtr<TableExprGroupFuncSet> > doGroupByAggrSingleKey
-  (const vector<TableExprNodeRep*>& aggrNodes)
+  vector<CountedPtr<TableExprGroupFuncSet> > doGroupByAggrPart
+  (const vector<TableExprNodeRep*>& aggrNodes,
+   TableExprGroupHash<T>& keyFuncMap, T key, uInt st, uInt end)
   {
     // We have to group the data according to the (possibly empty) groupby.
     // We step through the table in the normal order which may not be the
     // groupby order.
-    // A map<key,int> is used to keep track of the results where the int
-    // is the index in a vector of a set of aggregate function objects.
+    // A hash index is used to map the key to the index in a vector of
+    // a set of aggregate function objects.
     vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-    std::map<T, int> keyFuncMap;
-    T lastKey = std::numeric_limits<Double>::max();
+    // Consecutive rows with the same key do not need a lookup.
+    T lastKey (key);
     int groupnr = -1;
     // Loop through all rows.
     // For each row generate the key to get the right entry.
     TableExprId rowid(0);
-    T key;
-    for (uInt i=0; i<rownrs_p.size(); ++i) {
+    Bool isNew;
+    for (uInt i=st; i<end; ++i) {
       rowid.setRownr (rownrs_p[i]);
-      groupbyNodes_p[0].get (rowid, key);
-      if (key != lastKey) {
-        typename std::map<T, int>::iterator iter = keyFuncMap.find (key);
-        if (iter == keyFuncMap.end()) {
-          groupnr = funcSets.size();
-          keyFuncMap[key] = groupnr;
-          funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
-        } else {
-          groupnr = iter->second;
+      getGroupKey (rowid, key);
+      if (groupnr < 0  ||  !(key == lastKey)) {
+        groupnr = keyFuncMap.find (key, isNew);
+        if (isNew) {
+          // Making the function objects changes the aggregate nodes,
+          // so it cannot be done by multiple threads at the same time.
+          TableExprGroupFuncSet* funcSet;
+#ifdef _OPENMP
+#pragma omp critical(TableParseSelect_doGroupByAggrPart)
+#endif
+          funcSet = new TableExprGroupFuncSet (aggrNodes);
+          funcSets.push_back (funcSet);
         }
+        lastKey = key;
       }
-      rowid.setRownr (rownrs_p[i]);
       funcSets[groupnr]->apply (rowid);
     }
     return funcSets;
   }
 
-  // Create the set of aggregate functions and groupby keys in case
-  // multiple keys are given.
-  vector<CountedPtr<TableExprGroupFuncSet> > doGroupByAggrMultipleKeys
-  (const vector<TableExprNodeRep*>& aggrNodes);
+  // Create the set of aggregate functions and groupby keys for all rows.
+  // If multiple threads are used, the rows are divided in consecutive
+  // partitions which are grouped in parallel. Thereafter the partial
+  // results are merged in order of partition, so the groups keep the order
+  // of first appearance and the last row of a group is kept.
+  template<typename T>
+  vector<CountedPtr<TableExprGroupFuncSet> > doGroupByAggrKey
+  (const vector<TableExprNodeRep*>& aggrNodes, const T& key, uInt nthread)
+  {
+    uInt nrow = rownrs_p.size();
+    TableExprGroupHash<T> keyFuncMap;
+    if (nthread <= 1) {
+      return doGroupByAggrPart (aggrNodes, keyFuncMap, key, 0, nrow);
+    }
+    vector<TableExprGroupHash<T> > partMaps (nthread);
+    vector<vector<CountedPtr<TableExprGroupFuncSet> > > partSets (nthread);
+    // An exception cannot be thrown inside the parallel loop.
+    Bool failed = False;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread)
+#endif
+    for (Int i=0; i<Int(nthread); ++i) {
+      try {
+        partSets[i] = doGroupByAggrPart (aggrNodes, partMaps[i], key,
+                                         uInt(Int64(i) * nrow / nthread),
+                                         uInt(Int64(i+1) * nrow / nthread));
+      } catch (const AipsError&) {
+        failed = True;
+      }
+    }
+    // Redo the grouping sequentially to get the exception.
+    if (failed) {
+      return doGroupByAggrPart (aggrNodes, keyFuncMap, key, 0, nrow);
+    }
+    vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
+    Bool isNew;
+    for (uInt i=0; i<nthread; ++i) {
+      for (uInt j=0; j<partSets[i].size(); ++j) {
+        Int groupnr = keyFuncMap.find (partMaps[i].key(j), isNew);
+        if (isNew) {
+          funcSets.push_back (partSets[i][j]);
+        } else {
+          funcSets[groupnr]->merge (*partSets[i][j]);
+        }
+      }
+    }
+    return funcSets;
+  }
 
   //# Command type.
   CommandType commandType_p;
@@ -788,6 +902,11 @@ private:
   //# It can consist of column nodes and the rowid function node.
   //# Some nodes (in aggregate functions) can later be disabled for adjustment.
   vector<TableExprNode> applySelNodes_p;
+  //# The nodes shared by identical subexpressions (keyed by the column
+  //# or by the function and the keys of its operands).
+  std::map<String,TableExprNode> sharedNodes_p;
+  //# The nesting level of aggregate functions whose arguments are handled.
+  uInt aggrLevel_p;
   //# The resulting table.
   Table table_p;
   //# The first table used when creating a column object.
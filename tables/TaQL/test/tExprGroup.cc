@@ -28,6 +28,7 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprAggrNode.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
+#include <casacore/tables/TaQL/ExprGroup.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -444,6 +445,90 @@ void doDComplexArr()
          recs, mean(vecd), "meanDComplex");
 }
 
+void doHash()
+{
+  // Test the hash index with a single key.
+  // Use many groups to make sure rehashing is done.
+  {
+    TableExprGroupHash<Int64> index;
+    Bool isNew;
+    for (Int64 i=0; i<1000; ++i) {
+      AlwaysAssertExit (index.find (i*7, isNew) == i  &&  isNew);
+    }
+    for (Int64 i=999; i>=0; --i) {
+      AlwaysAssertExit (index.find (i*7, isNew) == i  &&  !isNew);
+    }
+    AlwaysAssertExit (index.size() == 1000);
+  }
+  {
+    TableExprGroupHash<Double> index;
+    Bool isNew;
+    AlwaysAssertExit (index.find (0., isNew) == 0  &&  isNew);
+    AlwaysAssertExit (index.find (-0., isNew) == 0  &&  !isNew);
+    AlwaysAssertExit (index.find (1.5, isNew) == 1  &&  isNew);
+  }
+  // Test the hash index with a keyset.
+  Record rec;
+  rec.define ("fldi", Int(0));
+  rec.define ("flds", String());
+  vector<TableExprNode> nodes(2);
+  nodes[0] = makeRecordExpr (rec, "fldi");
+  nodes[1] = makeRecordExpr (rec, "flds");
+  TableExprGroupKeySet keySet(nodes);
+  TableExprGroupHash<TableExprGroupKeySet> index;
+  Bool isNew;
+  Int expgrp[]  = {0, 1, 2, 0, 3, 1};
+  Bool expnew[] = {True, True, True, False, True, False};
+  Int ivals[]  = {1, 1, 2, 1, 2, 1};
+  const char* svals[] = {"a", "b", "b", "a", "a", "b"};
+  for (uInt i=0; i<6; ++i) {
+    rec.define ("fldi", ivals[i]);
+    rec.define ("flds", String(svals[i]));
+    keySet.fill (nodes, TableExprId(rec));
+    Int grp = index.find (keySet, isNew);
+    if (grp != expgrp[i]  ||  isNew != expnew[i]) {
+      cout << "keyset hash: unexpected group " << grp << " for row "
+           << i << endl;
+      foundError = True;
+    }
+  }
+  AlwaysAssertExit (index.size() == 4);
+  // Test date keys, which are compared as doubles.
+  // The first two dates have the same hash value.
+  Record drec;
+  drec.define ("fldd", Double(0));
+  vector<TableExprNode> dnodes(1, mjdtodate(makeRecordExpr (drec, "fldd")));
+  AlwaysAssertExit (dnodes[0].getNodeRep()->dataType() ==
+                    TableExprNodeRep::NTDate);
+  TableExprGroupKeySet dkeySet(dnodes);
+  TableExprGroupHash<TableExprGroupKeySet> dindex;
+  Double dvals[] = {50439.413906048569, 50734.825067540842,
+                    50439.413906048569, 50734.825067540842};
+  Int dexpgrp[] = {0, 1, 0, 1};
+  uInt dhash = 0;
+  for (uInt i=0; i<4; ++i) {
+    drec.define ("fldd", dvals[i]);
+    dkeySet.fill (dnodes, TableExprId(drec));
+    if (i == 0) {
+      dhash = dkeySet.hash();
+    }
+    AlwaysAssertExit (dkeySet.hash() == dhash);
+    Int grp = dindex.find (dkeySet, isNew);
+    if (grp != dexpgrp[i]) {
+      cout << "date hash: unexpected group " << grp << " for row "
+           << i << endl;
+      foundError = True;
+    }
+  }
+  AlwaysAssertExit (dindex.size() == 2);
+  TableExprGroupKey date1(TableExprNodeRep::NTDate);
+  TableExprGroupKey date2(TableExprNodeRep::NTDate);
+  date1.set (dvals[0]);
+  date2.set (dvals[1]);
+  AlwaysAssertExit (!(date1 == date2)  &&  date1 < date2  &&
+                    !(date2 < date1));
+}
+
 
 int main()
 {
@@ -458,6 +543,8 @@ int main()
     doIntArr();
     doDoubleArr();
     doDComplexArr();
+    cout << "test groupby hash index ..." << endl;
+    doHash();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
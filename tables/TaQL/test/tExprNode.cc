@@ -29,6 +29,15 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -1097,11 +1106,390 @@ void doShow()
   expr2.show (cout);
 }
 
+// Check that the values of an expression for a block of rows are the
+// same as the values obtained row by row.
+void checkBlock (const String& str, const TableExprNode& expr, uInt nrow)
+{
+  cout << "checkBlock " << str << endl;
+  // Use rows out of order and with gaps.
+  Vector<uInt> rownrs(nrow/2);
+  for (uInt i=0; i<rownrs.nelements(); i++) {
+    rownrs[i] = (i%2 == 0  ?  i : nrow-i);
+  }
+  Block<Bool> bvals;
+  Block<Int64> ivals;
+  Block<Double> dvals;
+  TableExprId exprid;
+  if (expr.dataType() == TpBool) {
+    expr.get (rownrs, bvals);
+  } else if (expr.dataType() == TpInt) {
+    expr.get (rownrs, ivals);
+  }
+  if (expr.dataType() != TpBool) {
+    expr.get (rownrs, dvals);
+  }
+  for (uInt i=0; i<rownrs.nelements(); i++) {
+    exprid.setRownr (rownrs[i]);
+    if (expr.dataType() == TpBool) {
+      if (bvals[i] != expr.getBool(exprid)) {
+        foundError = True;
+        cout << str << ": block value mismatch in row " << rownrs[i] << endl;
+      }
+    } else {
+      if ((expr.dataType() == TpInt  &&  ivals[i] != expr.getInt(exprid))
+      ||  dvals[i] != expr.getDouble(exprid)) {
+        foundError = True;
+        cout << str << ": block value mismatch in row " << rownrs[i] << endl;
+      }
+    }
+  }
+}
+
+void doBlock()
+{
+  // Create a table with a few scalar columns.
+  const uInt nrow = 1000;
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("ci"));
+    td.addColumn (ScalarColumnDesc<uInt>("cu"));
+    td.addColumn (ScalarColumnDesc<Float>("cf"));
+    td.addColumn (ScalarColumnDesc<Double>("cd"));
+    td.addColumn (ScalarColumnDesc<Bool>("cb"));
+    SetupNewTable newtab("tExprNode_tmp.tab", td, Table::New);
+    StandardStMan ssm(512);
+    newtab.bindAll (ssm);
+    Table tab(newtab, nrow);
+    ScalarColumn<Int> ci(tab, "ci");
+    ScalarColumn<uInt> cu(tab, "cu");
+    ScalarColumn<Float> cf(tab, "cf");
+    ScalarColumn<Double> cd(tab, "cd");
+    ScalarColumn<Bool> cb(tab, "cb");
+    for (uInt i=0; i<nrow; i++) {
+      ci.put (i, Int(i%10) - 3);
+      cu.put (i, i);
+      cf.put (i, i/4.);
+      cd.put (i, i*1.5);
+      cb.put (i, i%3 == 0);
+    }
+  }
+  Table tab("tExprNode_tmp.tab");
+  TableExprNode ci = tab.col("ci");
+  TableExprNode cu = tab.col("cu");
+  TableExprNode cf = tab.col("cf");
+  TableExprNode cd = tab.col("cd");
+  TableExprNode cb = tab.col("cb");
+  checkBlock ("ci", ci, nrow);
+  checkBlock ("cu", cu, nrow);
+  checkBlock ("cf", cf, nrow);
+  checkBlock ("cd", cd, nrow);
+  checkBlock ("cb", cb, nrow);
+  checkBlock ("rownr", tab.nodeRownr(1), nrow);
+  checkBlock ("ci+cu*2-1", ci+cu*2-1, nrow);
+  checkBlock ("cd/(cf+1)+cu", cd/(cf+1)+cu, nrow);
+  checkBlock ("cd>cu&&ci!=0", cd>cu && ci!=0, nrow);
+  checkBlock ("cb||ci>=cf", cb || ci>=cf, nrow);
+  checkBlock ("!(cb==(ci<0))", !(cb==(ci<0)), nrow);
+  checkBlock ("ci<=2&&cd<500||cb", (ci<=2 && cd<500) || cb, nrow);
+  // The right operand of && must not be evaluated if the left is false,
+  // otherwise an integer modulo by zero would be done.
+  checkBlock ("ci!=0&&cu%ci==0", ci!=0 && cu%ci==0, nrow);
+  checkBlock ("ci==0||cu%ci==0", ci==0 || cu%ci==0, nrow);
+  // Check the selection (also with a limit and offset).
+  TableExprNode expr (ci!=0 && cu%ci==0);
+  Table sel = tab(expr);
+  uInt nsel = 0;
+  TableExprId exprid;
+  for (uInt i=0; i<nrow; i++) {
+    exprid.setRownr (i);
+    if (expr.getBool (exprid)) {
+      AlwaysAssertExit (sel.rowNumbers()[nsel] == i);
+      nsel++;
+    }
+  }
+  AlwaysAssertExit (sel.nrow() == nsel);
+  Table sel2 = tab(expr, 100, 10);
+  AlwaysAssertExit (sel2.nrow() == 100);
+  AlwaysAssertExit (allEQ (sel2.rowNumbers(),
+                           sel.rowNumbers()(Slice(10,100))));
+  Table sel3 = tab(cd>cu && ci!=0);
+  AlwaysAssertExit (sel3.nrow() == 899);
+  // Evaluate in parallel; the result must be in row order.
+  AlwaysAssertExit (expr.getNodeRep()->isThreadSafe());
+  Table sel4 = tab(expr, 0, 0, 4);
+  AlwaysAssertExit (allEQ (sel4.rowNumbers(), sel.rowNumbers()));
+  Table sel5 = tab(expr, 100, 10, 4);
+  AlwaysAssertExit (allEQ (sel5.rowNumbers(), sel2.rowNumbers()));
+  // An expression using a function is evaluated sequentially.
+  TableExprNode expr2 (sin(cd) > 0.5  ||  cb);
+  AlwaysAssertExit (! expr2.getNodeRep()->isThreadSafe());
+  AlwaysAssertExit (allEQ (tab(expr2, 0, 0, 4).rowNumbers(),
+                           tab(expr2).rowNumbers()));
+}
+
+void doFused()
+{
+  // Array expressions with multiple operations are evaluated in a fused way.
+  // Use more elements than fit in a single chunk.
+  IPosition shp(2,30,43);
+  Matrix<Double> a(shp), b(shp);
+  Matrix<DComplex> z(shp);
+  indgen (a, -100.);
+  indgen (b, 1., 0.5);
+  indgen (z, DComplex(1.,2.));
+  Record rec;
+  rec.define ("a", a);
+  rec.define ("b", b);
+  rec.define ("z", z);
+  rec.define ("s", 2.5);
+  rec.define ("m", Matrix<Double>(3,4, 1.));
+  TableExprNode ea = makeRecordExpr (rec, "a");
+  TableExprNode eb = makeRecordExpr (rec, "b");
+  TableExprNode ez = makeRecordExpr (rec, "z");
+  TableExprNode es = makeRecordExpr (rec, "s");
+  TableExprNode em = makeRecordExpr (rec, "m");
+  TableExprId exprid(rec);
+  Array<Double> ad = a*2. + b*3. - a/b;
+  TableExprNode expr1 (ea*2. + eb*3. - ea/eb);
+  checkArrDouble ("a*2+b*3-a/b", exprid, expr1, ad);
+  checkArrDouble ("a*2+b*3-a/b", exprid, expr1, ad);
+  checkArrDouble ("-(a+s)*b", exprid, -(ea+es)*eb, -(a+2.5)*b);
+  checkArrDouble ("(a+b)*(a-(b-s))/s", exprid, (ea+eb)*(ea-(eb-es))/es,
+                  (a+b)*(a-(b-2.5))/2.5);
+  checkArrDouble ("s-(s/b+a)", exprid, es-(es/eb+ea), 2.5-(2.5/b+a));
+  Array<DComplex> ac(shp);
+  convertArray (ac, a);
+  checkArrDComplex ("z*a+z/s-a", exprid, ez*ea + ez/es - ea,
+                    z*ac + z/DComplex(2.5) - ac);
+  checkArrDComplex ("-(z+a)", exprid, -(ez+ea), -(z+ac));
+  // Arrays with a different shape give the normal exception.
+  Bool excp = False;
+  try {
+    Array<Double> res;
+    TableExprNode expr2 (ea + eb*em);
+    expr2.get (exprid, res);
+  } catch (std::exception&) {
+    excp = True;
+  }
+  AlwaysAssertExit (excp);
+}
+
+void doCache()
+{
+  // Create a table with an array column.
+  {
+    TableDesc td;
+    td.addColumn (ArrayColumnDesc<Float>("arr", IPosition(1,4),
+                                         ColumnDesc::FixedShape));
+    SetupNewTable newtab("tExprNode_tmp.tab", td, Table::New);
+    Table tab(newtab, 3);
+    ArrayColumn<Float> arr(tab, "arr");
+    for (uInt i=0; i<3; i++) {
+      arr.put (i, Vector<Float>(4, -Float(i)));
+    }
+  }
+  Table tab("tExprNode_tmp.tab", Table::Update);
+  ArrayColumn<Float> arr(tab, "arr");
+  TableExprNode ecol = tab.col("arr");
+  TableExprNode efunc = abs(ecol);
+  TableExprNodeArray* colNode = dynamic_cast<TableExprNodeArray*>
+    (const_cast<TableExprNodeRep*>(ecol.getNodeRep()));
+  TableExprNodeArray* funcNode = dynamic_cast<TableExprNodeArray*>
+    (const_cast<TableExprNodeRep*>(efunc.getNodeRep()));
+  AlwaysAssertExit (colNode != 0  &&  funcNode != 0);
+  colNode->setCaching (True);
+  funcNode->setCaching (True);
+  TableExprId exprid(1);
+  Array<Double> val;
+  efunc.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, 1.));
+  // The cached values are used for the same row, so a change of the
+  // data is not seen until the cache is cleared.
+  arr.put (1, Vector<Float>(4, 5.));
+  efunc.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, 1.));
+  ecol.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, -1.));
+  exprid.setRownr (2);
+  efunc.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, 2.));
+  exprid.setRownr (1);
+  efunc.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, 5.));
+  arr.put (1, Vector<Float>(4, 3.));
+  colNode->clearCache();
+  funcNode->clearCache();
+  efunc.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, 3.));
+  // Without caching the data are always read.
+  colNode->setCaching (False);
+  funcNode->setCaching (False);
+  arr.put (1, Vector<Float>(4, 7.));
+  efunc.get (exprid, val);
+  AlwaysAssertExit (allEQ (val, 7.));
+}
+
+void doSharedAlias()
+{
+  // Create a table with two array columns.
+  {
+    TableDesc td;
+    td.addColumn (ArrayColumnDesc<Float>("DATA", IPosition(1,4),
+                                         ColumnDesc::FixedShape));
+    td.addColumn (ArrayColumnDesc<Float>("CORRECTED_DATA", IPosition(1,4),
+                                         ColumnDesc::FixedShape));
+    SetupNewTable newtab("tExprNode_tmp.tab2", td, Table::New);
+    Table tab(newtab, 4);
+    ArrayColumn<Float> data(tab, "DATA");
+    ArrayColumn<Float> corr(tab, "CORRECTED_DATA");
+    Float corrVal[] = {40, 30, 10, 20};
+    for (uInt i=0; i<4; i++) {
+      data.put (i, Vector<Float>(4, Float(i)));
+      corr.put (i, Vector<Float>(4, -corrVal[i]));
+    }
+  }
+  // DATA in WHERE is the column DATA, but in ORDERBY it is the new name of
+  // CORRECTED_DATA. So these uses of DATA cannot share a node.
+  TaQLResult result = tableCommand
+    ("select CORRECTED_DATA as DATA from tExprNode_tmp.tab2"
+     " where any(DATA > 0) orderby sum(abs(DATA))");
+  Vector<uInt> rownrs = result.table().rowNumbers();
+  AlwaysAssertExit (rownrs.size() == 3);
+  AlwaysAssertExit (rownrs[0] == 2  &&  rownrs[1] == 3  &&  rownrs[2] == 1);
+  ArrayColumn<Float> data(result.table(), "DATA");
+  AlwaysAssertExit (allEQ (data(0), Float(-10)));
+}
+
+void doSharedAggr()
+{
+  // Create a table with rows grouped by ANTENNA1.
+  // All rows in a group have the same FLAG array; group i has i flags set.
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("ANTENNA1"));
+    td.addColumn (ArrayColumnDesc<Bool>("FLAG", IPosition(1,4),
+                                        ColumnDesc::FixedShape));
+    SetupNewTable newtab("tExprNode_tmp.tab3", td, Table::New);
+    Table tab(newtab, 6);
+    ScalarColumn<Int> ant(tab, "ANTENNA1");
+    ArrayColumn<Bool> flag(tab, "FLAG");
+    for (uInt i=0; i<6; i++) {
+      ant.put (i, i/2);
+      Vector<Bool> flags(4, False);
+      flags(Slice(0, i/2)) = True;
+      flag.put (i, flags);
+    }
+  }
+  // FLAG in the aggregate is evaluated for the original rows, while the
+  // projected FLAG is evaluated for the group rows. So they cannot share
+  // a node.
+  TaQLResult result = tableCommand
+    ("select ANTENNA1, FLAG, gsum(ntrue(FLAG)) as NFLAG"
+     " from tExprNode_tmp.tab3 groupby ANTENNA1");
+  Table tab = result.table();
+  AlwaysAssertExit (tab.nrow() == 3);
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ScalarColumn<Int> nflag(tab, "NFLAG");
+  for (uInt i=0; i<tab.nrow(); i++) {
+    AlwaysAssertExit (ntrue(flag(i)) == uInt(ant(i)));
+    AlwaysAssertExit (nflag(i) == 2*ant(i));
+  }
+}
+
+void doGroupDate()
+{
+  // Create a table with two dates (as MJD) having the same group hash value.
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Double>("TIME"));
+    SetupNewTable newtab("tExprNode_tmp.tab4", td, Table::New);
+    Table tab(newtab, 5);
+    ScalarColumn<Double> time(tab, "TIME");
+    for (uInt i=0; i<5; i++) {
+      time.put (i, (i%2 == 0  ?  50439.413906048569 : 50734.825067540842));
+    }
+  }
+  // The dates must form different groups.
+  TaQLResult result = tableCommand
+    ("select gcount() as N from tExprNode_tmp.tab4 groupby mjdtodate(TIME)");
+  AlwaysAssertExit (result.table().nrow() == 2);
+  ScalarColumn<Int> ncol(result.table(), "N");
+  AlwaysAssertExit (ncol(0) == 3  &&  ncol(1) == 2);
+  // A date is stored as an MJD, so DISTINCT on it uses the double values.
+  result = tableCommand ("select distinct TIME from tExprNode_tmp.tab4");
+  AlwaysAssertExit (result.table().nrow() == 2);
+  AlwaysAssertExit (result.table().rowNumbers()[0] == 0  &&
+                    result.table().rowNumbers()[1] == 1);
+}
+
+void checkGroupThreads (const String& command)
+{
+  // The result using multiple threads must match the sequential result.
+  Table tab1 = tableCommand ("using style NTHREADS=1 " + command).table();
+  Table tab4 = tableCommand ("using style NTHREADS=4 " + command).table();
+  AlwaysAssertExit (tab1.nrow() > 1  &&  tab4.nrow() == tab1.nrow());
+  Vector<String> names = tab1.tableDesc().columnNames();
+  for (uInt i=0; i<names.size(); ++i) {
+    TableColumn col1(tab1, names[i]);
+    TableColumn col4(tab4, names[i]);
+    Bool isBool = (col1.columnDesc().dataType() == TpBool);
+    for (uInt j=0; j<tab1.nrow(); ++j) {
+      AlwaysAssertExit (isBool  ?  col4.asBool(j) == col1.asBool(j)
+                        : col4.asdouble(j) == col1.asdouble(j));
+    }
+  }
+}
+
+void doGroupThreads()
+{
+  // Create a table with enough rows to group them in parallel.
+  const uInt nrow = 10000;
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("ANT"));
+    td.addColumn (ScalarColumnDesc<Double>("X"));
+    td.addColumn (ScalarColumnDesc<String>("S"));
+    td.addColumn (ScalarColumnDesc<Bool>("FLAG"));
+    SetupNewTable newtab("tExprNode_tmp.tab5", td, Table::New);
+    Table tab(newtab, nrow);
+    ScalarColumn<Int> ant(tab, "ANT");
+    ScalarColumn<Double> x(tab, "X");
+    ScalarColumn<String> str(tab, "S");
+    ScalarColumn<Bool> flag(tab, "FLAG");
+    for (uInt i=0; i<nrow; i++) {
+      ant.put (i, (i*7919) % 37);
+      x.put (i, Double((i*13) % 97) - 40);
+      str.put (i, (i%3 == 0  ?  "a" : (i%3 == 1  ?  "bb" : "ccc")));
+      flag.put (i, (i*17) % 5 != 0);
+    }
+  }
+  const String aggr ("select ANT, X, gcount() as N, gsum(X) as SUM,"
+                     " gmin(X) as MIN, gmax(X) as MAX, gmean(X) as MEAN,"
+                     " gfirst(X) as FIRST, glast(X) as LAST,"
+                     " gntrue(FLAG) as NTRUE, gall(FLAG) as ALL"
+                     " from tExprNode_tmp.tab5");
+  checkGroupThreads (aggr + " groupby ANT");
+  checkGroupThreads (aggr + " groupby X+1");
+  checkGroupThreads (aggr + " groupby ANT,S");
+  // A lazy aggregate is done sequentially.
+  checkGroupThreads ("select ANT, gmedian(X) as MEDIAN"
+                     " from tExprNode_tmp.tab5 groupby ANT");
+  checkGroupThreads ("select ANT from tExprNode_tmp.tab5 where X>0");
+}
+
 int main()
 {
   try {
     doIt();
     doShow();
+    doBlock();
+    doFused();
+    doCache();
+    doSharedAlias();
+    doSharedAggr();
+    doGroupDate();
+    doGroupThreads();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
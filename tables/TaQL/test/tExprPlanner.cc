@@ -0,0 +1,294 @@
+//# tExprPlanner.cc: Test program for class TableExprPlanner
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/TaQL/ExprPlanner.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TableExprPlanner.
+// </summary>
+
+const uInt nrow = 1000;
+
+void createTable()
+{
+  // TIME is ascending (with duplicates and an infinite value at the end),
+  // ITIME is an ascending integer column, RTIME is descending.
+  // AINT is an unsorted integer column and NTIME contains a NaN.
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<Int>("ITIME"));
+  td.addColumn (ScalarColumnDesc<Float>("RTIME"));
+  td.addColumn (ScalarColumnDesc<Double>("NTIME"));
+  td.addColumn (ScalarColumnDesc<Int>("AINT"));
+  SetupNewTable newtab("tExprPlanner_tmp.tab", td, Table::New);
+  IncrementalStMan ism;
+  StandardStMan ssm(512);
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("TIME", ism);
+  Table tab(newtab, nrow);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> itime(tab, "ITIME");
+  ScalarColumn<Float> rtime(tab, "RTIME");
+  ScalarColumn<Double> ntime(tab, "NTIME");
+  ScalarColumn<Int> aint(tab, "AINT");
+  for (uInt i=0; i<nrow; i++) {
+    time.put (i, (i == nrow-1  ?  doubleInf() : Double(i/10)));
+    itime.put (i, i);
+    rtime.put (i, nrow-i);
+    ntime.put (i, (i == 500  ?  doubleNaN() : Double(i)));
+    aint.put (i, (i*7)%nrow);
+  }
+}
+
+// Check the selection against a brute-force evaluation of all rows.
+void checkSelect (const Table& tab, const TableExprNode& expr,
+                  Bool expectRows, uInt expectNrow)
+{
+  TableExprPlanner planner (expr, tab);
+  cout << planner.description() << endl;
+  AlwaysAssertExit (planner.hasRows() == expectRows);
+  if (expectRows) {
+    AlwaysAssertExit (planner.rows().nelements() == expectNrow);
+  }
+  Vector<uInt> rows(tab.nrow());
+  uInt nr = 0;
+  for (uInt i=0; i<tab.nrow(); i++) {
+    Bool val;
+    expr.get (i, val);
+    if (val) {
+      rows[nr++] = i;
+    }
+  }
+  rows.resize (nr, True);
+  Table sel = tab(expr);
+  AlwaysAssertExit (allEQ (sel.rowNumbers(), rows));
+  // Also check with a limited number of rows.
+  if (nr > 2) {
+    Table sel2 = tab(expr, 2);
+    AlwaysAssertExit (sel2.nrow() == 2);
+    AlwaysAssertExit (sel2.rowNumbers()[0] == rows[0]  &&
+                      sel2.rowNumbers()[1] == rows[1]);
+  }
+}
+
+void doReadonly()
+{
+  Table tab("tExprPlanner_tmp.tab");
+  TableExprNode time  = tab.col("TIME");
+  TableExprNode itime = tab.col("ITIME");
+  TableExprNode rtime = tab.col("RTIME");
+  TableExprNode ntime = tab.col("NTIME");
+  AlwaysAssertExit (TableExprPlanner::isSorted (TableColumn(tab, "TIME")));
+  AlwaysAssertExit (TableExprPlanner::isSorted (TableColumn(tab, "ITIME")));
+  AlwaysAssertExit (! TableExprPlanner::isSorted (TableColumn(tab, "RTIME")));
+  AlwaysAssertExit (! TableExprPlanner::isSorted (TableColumn(tab, "NTIME")));
+  checkSelect (tab, time == 5., True, 10);
+  checkSelect (tab, time >= 5.  &&  time < 7., True, 30);
+  checkSelect (tab, time > 5.  &&  time <= 7., True, 30);
+  // The infinite value at the end has to be found.
+  checkSelect (tab, time > 90., True, 100);
+  checkSelect (tab, time < 10.  ||  time > 95., True, 160);
+  checkSelect (tab, time == 3.  ||  time == 50.5, True, 10);
+  checkSelect (tab, time > 200., True, 1);
+  checkSelect (tab, time > 5.  &&  time < 3., True, 0);
+  // The ranges are closed intervals, thus a superset of the matching rows.
+  // Other parts of the expression are evaluated for the candidate rows.
+  checkSelect (tab, time >= 5.  &&  time < 7.  &&  itime%2 == 0, True, 30);
+  checkSelect (tab, time >= 5.  &&  itime > 100.5, True, 899);
+  // The column giving the fewest rows is used.
+  checkSelect (tab, time >= 5.  &&  itime < 60.5, True, 61);
+  // No plan if not sorted, not a range or everything matches.
+  checkSelect (tab, rtime > 100., False, 0);
+  checkSelect (tab, ntime > 100., False, 0);
+  checkSelect (tab, time >= 5.  ||  itime < 60.5, False, 0);
+  checkSelect (tab, !(time >= 5.), False, 0);
+  checkSelect (tab, time > -1., False, 0);
+}
+
+void doIndex()
+{
+  // Make a persistent index for AINT, which is used by the planner.
+  {
+    Table tab("tExprPlanner_tmp.tab");
+    TableExprNode aint = tab.col("AINT");
+    checkSelect (tab, aint < 10., False, 0);
+    ColumnsIndex colInx (tab, "AINT");
+    colInx.makePersistent();
+  }
+  Table tab("tExprPlanner_tmp.tab");
+  TableExprNode aint = tab.col("AINT");
+  TableExprNode time = tab.col("TIME");
+  checkSelect (tab, aint < 10., True, 11);
+  checkSelect (tab, aint >= 10.5  &&  aint <= 20.5, True, 10);
+  checkSelect (tab, aint == 7.  ||  aint > 990., True, 11);
+  checkSelect (tab, aint > 5.  &&  time == 3., True, 10);
+  checkSelect (tab, aint > 5., True, 995);
+}
+
+void doStaleIndex()
+{
+  // Change AINT, which makes the persistent index outdated.
+  {
+    Table tab("tExprPlanner_tmp.tab", Table::Update);
+    ScalarColumn<Int> aint(tab, "AINT");
+    for (uInt i=0; i<nrow; i++) {
+      aint.put (i, (i*3)%nrow);
+    }
+  }
+  {
+    // An outdated index is not used by the planner.
+    Table tab("tExprPlanner_tmp.tab");
+    TableExprNode aint = tab.col("AINT");
+    Vector<String> names(1, "AINT");
+    AlwaysAssertExit (ColumnsIndex::hasPersistent (tab, names));
+    AlwaysAssertExit (! ColumnsIndex::canUsePersistent (tab, names));
+    checkSelect (tab, aint < 10., False, 0);
+    // Creating the index rewrites the file, after which it is used.
+    ColumnsIndex colInx (tab, "AINT");
+    AlwaysAssertExit (ColumnsIndex::canUsePersistent (tab, names));
+    checkSelect (tab, aint < 10., True, 11);
+  }
+  {
+    // A table opened without locking cannot use the index.
+    Table tab("tExprPlanner_tmp.tab", TableLock(TableLock::NoLocking));
+    TableExprNode aint = tab.col("AINT");
+    checkSelect (tab, aint < 10., False, 0);
+  }
+}
+
+void doWritable()
+{
+  // A writable table is always fully scanned.
+  Table tab("tExprPlanner_tmp.tab", Table::Update);
+  TableExprNode time = tab.col("TIME");
+  checkSelect (tab, time == 5., False, 0);
+  // A selection of a selection is fully scanned.
+  Table tab1("tExprPlanner_tmp.tab");
+  Table sel = tab1(tab1.col("ITIME") < 500.5);
+  checkSelect (sel, sel.col("TIME") == 5., False, 0);
+}
+
+void doZoneMap()
+{
+  // Create a table with zone maps (100 rows per bucket).
+  // SCAN is clustered in descending order, DVAL has a NaN.
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("SCAN"));
+    td.addColumn (ScalarColumnDesc<Double>("DVAL"));
+    td.addColumn (ScalarColumnDesc<String>("NAME"));
+    SetupNewTable newtab("tExprPlanner_tmp.zone", td, Table::New);
+    StandardStMan ssm("SSMZ", -100, 1, True);
+    newtab.bindAll (ssm);
+    Table tab(newtab, nrow);
+    ScalarColumn<Int> scan(tab, "SCAN");
+    ScalarColumn<Double> dval(tab, "DVAL");
+    for (uInt i=0; i<nrow; i++) {
+      scan.put (i, 9 - i/100);
+      dval.put (i, (i == 250  ?  doubleNaN() : Double(i)));
+    }
+    // No zone map for a string column.
+    Vector<uInt> lastRow;
+    Vector<Double> minVal, maxVal;
+    AlwaysAssertExit (! TableColumn(tab, "NAME").getZoneMap (lastRow, minVal,
+                                                             maxVal));
+  }
+  {
+    Table tab("tExprPlanner_tmp.zone");
+    Vector<uInt> lastRow;
+    Vector<Double> minVal, maxVal;
+    AlwaysAssertExit (TableColumn(tab, "DVAL").getZoneMap (lastRow, minVal,
+                                                           maxVal));
+    AlwaysAssertExit (lastRow.nelements() == 10  &&  lastRow[2] == 299);
+    AlwaysAssertExit (minVal[2] == 200  &&  maxVal[2] == 299);
+    TableExprNode scan = tab.col("SCAN");
+    TableExprNode dval = tab.col("DVAL");
+    checkSelect (tab, scan == 3., True, 100);
+    checkSelect (tab, scan > 6.5  ||  scan < 0.5, True, 400);
+    checkSelect (tab, dval >= 240.  &&  dval < 260., True, 100);
+    checkSelect (tab, dval > 990.  &&  scan == 0., True, 100);
+    checkSelect (tab, scan > 20., True, 0);
+  }
+  {
+    // The zone of a changed bucket is unknown until flushed.
+    Table tab("tExprPlanner_tmp.zone", Table::Update);
+    TableExprNode scan = tab.col("SCAN");
+    ScalarColumn<Int> scol(tab, "SCAN");
+    scol.put (150, 3);
+    checkSelect (tab, scan == 3., True, 200);
+    tab.flush();
+    checkSelect (tab, scan == 3., True, 200);
+    scol.put (150, 8);
+    tab.flush();
+    checkSelect (tab, scan == 3., True, 100);
+    // Added rows are taken into account.
+    tab.addRow (50);
+    for (uInt i=nrow; i<nrow+50; i++) {
+      scol.put (i, 100);
+    }
+    checkSelect (tab, scan == 100., True, 50);
+  }
+  // The zone maps are persistent.
+  Table tab("tExprPlanner_tmp.zone");
+  TableExprNode scan = tab.col("SCAN");
+  checkSelect (tab, scan == 100., True, 50);
+  checkSelect (tab, scan >= 8., True, 250);
+}
+
+int main()
+{
+  try {
+    createTable();
+    doReadonly();
+    doIndex();
+    doStaleIndex();
+    doWritable();
+    doZoneMap();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -240,6 +240,21 @@ public:
     Array<T> getColumn() const;
     // </group>
 
+    // Get a readonly view of the arrays in the column starting at the
+    // given row. The view is an (n+1)-dim array with the last dimension
+    // representing the rows. It refers directly to the data in the storage
+    // manager (e.g. a memory-mapped file), so no data are copied.
+    // The view can contain fewer rows than remaining in the column
+    // (e.g. only till the end of a bucket), so the function has to be
+    // called repeatedly to iterate through the column.
+    // <br>False is returned (and the view is made empty) if no direct access
+    // is possible. It is only possible for columns with a fixed shape.
+    // Currently only StandardStMan can give direct access if the data are
+    // stored in the native format.
+    // <br>Note that the data in the view are readonly and are only valid
+    // as long as the column is not changed and the table is open.
+    Bool getColumnView (uInt rownr, Array<T>& view) const;
+
     // Get regular slices from all arrays in the column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // with the last dimension representing the number of rows and the
@@ -32,6 +32,7 @@
 #include <casacore/tables/Tables/ArrayColumnFunc.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/Arrays/IPosition.h>
@@ -40,6 +41,7 @@
 #include <casacore/casa/Utilities/ValTypeId.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -447,6 +449,26 @@ void ArrayColumn<T>::getColumn (Array<T>& arr, Bool resize) const
 }
 
 
+template<class T>
+Bool ArrayColumn<T>::getColumnView (uInt rownr, Array<T>& view) const
+{
+    TABLECOLUMNCHECKROW(rownr);
+    uInt nr = 0;
+    const T* ptr = 0;
+    if ((columnDesc().options() & ColumnDesc::FixedShape) != 0) {
+	ptr = static_cast<const T*>(baseColPtr_p->getColumnView (rownr, nr));
+    }
+    if (ptr == 0  ||  nr == 0) {
+	view.resize();
+	return False;
+    }
+    nr = std::min (nr, nrow() - rownr);
+    IPosition shp = shapeColumn();
+    shp.append (IPosition(1,nr));
+    view.takeStorage (shp, const_cast<T*>(ptr), SHARE);
+    return True;
+}
+
 template<class T>
 Array<T> ArrayColumn<T>::getColumn (const Slicer& arraySection) const
 {
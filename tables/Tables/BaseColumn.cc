@@ -123,6 +123,19 @@ Bool BaseColumn::canAccessColumnSlice (Bool& reask) const
     return False;                      // can never be accessed
 }
 
+const void* BaseColumn::getColumnView (uInt, uInt& nrrow) const
+{
+    nrrow = 0;
+    return 0;
+}
+
+
+Bool BaseColumn::getZoneMap (Vector<uInt>&, Vector<Double>&,
+                             Vector<Double>&) const
+{
+    return False;
+}
+
 
 void BaseColumn::getSlice (uInt, const Slicer&, void*) const
 {
@@ -173,6 +173,18 @@ public:
     // Default is never.
     virtual Bool canAccessColumnSlice (Bool& reask) const;
 
+    // Get a direct readonly pointer to the data of the given row and the
+    // <src>nrrow</src> rows following it (see
+    // <linkto class=DataManagerColumn>DataManagerColumn::getColumnViewV</linkto>).
+    // Default is a null pointer meaning that no direct access is possible.
+    virtual const void* getColumnView (uInt rownr, uInt& nrrow) const;
+
+    // Get the zone map of the column (see
+    // <linkto class=DataManagerColumn>DataManagerColumn::getZoneMap</linkto>).
+    // Default is False meaning that no zone map is available.
+    virtual Bool getZoneMap (Vector<uInt>& lastRow, Vector<Double>& minVal,
+                             Vector<Double>& maxVal) const;
+
     // Initialize the rows from startRow till endRow (inclusive)
     // with the default value defined in the column description.
     virtual void initialize (uInt startRownr, uInt endRownr) = 0;
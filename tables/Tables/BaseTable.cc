@@ -34,6 +34,7 @@
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprPlanner.h>
 #include <casacore/tables/Tables/BaseTabIter.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
@@ -52,6 +53,13 @@
 #include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/OS/Directory.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/Copy.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -68,7 +76,9 @@ BaseTable::BaseTable (const String& name, int option, uInt nrrow)
   noWrite_p   (False),
   delete_p    (False),
   madeDir_p   (True),
-  itsTraceId  (-1)
+  itsTraceId  (-1),
+  sortedNrow_p     (0),
+  sortedModCount_p (0)
 {
     if (name_p.empty()) {
 	name_p = File::newUniqueName ("", "tab").originalName();
@@ -676,9 +686,71 @@ BaseTable* BaseTable::select (uInt maxRow, uInt offset)
     return select(rownrs);
 }
 
+// Fill the row numbers to evaluate starting at index st.
+// If no candidate rows are given, all rows are used.
+void BaseTable_fillRownrs (Vector<uInt>& rownrs, const Vector<uInt>& rows,
+                           Bool useRows, uInt st)
+{
+    if (useRows) {
+        for (uInt i=0; i<rownrs.nelements(); i++) {
+            rownrs[i] = rows[st+i];
+        }
+    } else {
+        indgen (rownrs, st);
+    }
+}
+
+// Evaluate the select expression for nr rows starting at index st.
+// The rows are evaluated in blocks, in parallel if multiple threads are used.
+void BaseTable_evalSelect (const TableExprNode& node,
+                           const Vector<uInt>& rows, Bool useRows,
+                           uInt st, uInt nr,
+                           uInt blockSize, uInt nthread, Block<Bool>& mask)
+{
+    if (mask.nelements() < nr) {
+        mask.resize (nr, False, False);
+    }
+    Int nblock = (nr + blockSize - 1) / blockSize;
+    if (nthread <= 1  ||  nblock <= 1) {
+        Vector<uInt> rownrs;
+        Block<Bool> vals;
+        for (Int i=0; i<nblock; i++) {
+            uInt first = i*blockSize;
+            rownrs.resize (std::min (blockSize, nr-first));
+            BaseTable_fillRownrs (rownrs, rows, useRows, st+first);
+            node.get (rownrs, vals);
+            objcopy (mask.storage() + first, vals.storage(),
+                     rownrs.nelements());
+        }
+        return;
+    }
+    // An exception cannot be thrown inside the parallel loop.
+    Bool failed = False;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread) schedule(dynamic)
+#endif
+    for (Int i=0; i<nblock; i++) {
+        uInt first = i*blockSize;
+        Vector<uInt> rownrs(std::min (blockSize, nr-first));
+        BaseTable_fillRownrs (rownrs, rows, useRows, st+first);
+        Block<Bool> vals;
+        try {
+            node.get (rownrs, vals);
+            objcopy (mask.storage() + first, vals.storage(),
+                     rownrs.nelements());
+        } catch (const AipsError&) {
+            failed = True;
+        }
+    }
+    // Redo the evaluation sequentially to get the exception.
+    if (failed) {
+        BaseTable_evalSelect (node, rows, useRows, st, nr, blockSize, 1, mask);
+    }
+}
+
 // Do the row selection.
 BaseTable* BaseTable::select (const TableExprNode& node,
-                              uInt maxRow, uInt offset)
+                              uInt maxRow, uInt offset, uInt nthread)
 {
     // Check we don't deal with a null table.
     AlwaysAssert (!isNull(), AipsError);
@@ -708,31 +780,98 @@ BaseTable* BaseTable::select (const TableExprNode& node,
                            node.table().tableName() +
                            " is used on a differently sized table " + name_p));
     }
+    //# Determine the number of threads to use. It can only be done if
+    //# the expression is thread-safe.
+    if (nthread == 0) {
+      Int nthr;
+      AipsrcValue<Int>::find (nthr, "table.taql.nthreads", 1);
+#ifdef _OPENMP
+      if (nthr <= 0) {
+        nthr = omp_get_max_threads();
+      }
+#endif
+      nthread = std::max (nthr, 1);
+    }
+#ifndef _OPENMP
+    nthread = 1;
+#endif
+    if (nthread > 1  &&  !node.getNodeRep()->isThreadSafe()) {
+      nthread = 1;
+    }
+    //# Determine if the expression only needs to be evaluated for some
+    //# candidate rows (e.g. using a binary search on a sorted column).
+    TableExprPlanner planner (node, Table(this, False));
+    Bool useRows = planner.hasRows();
+    const Vector<uInt>& rows = planner.rows();
     //# Create a reference table, which will be in row order.
-    //# Loop through all rows and add to reference table if true.
+    //# Evaluate the expression for blocks of rows (a few blocks per thread
+    //# at a time) and collect the matching rows.
+    //# If the number of rows is limited, start with a small block to
+    //# avoid evaluating many more rows than needed and add the (limited
+    //# number of) rownrs directly to the reference table.
+    //# Otherwise collect them in a bit mask (one bit per row), which is
+    //# much smaller than a vector of row numbers. The row number vector is
+    //# then created in one go, avoiding repeated growing and copying.
+    //# If all rows are selected, the row numbers of this table are used
+    //# (which are shared if this is a reference table).
     //# Add the rownr of the root table (one may search a reference table).
     //# Adjust the row numbers to reflect row numbers in the root table.
     SPtrHolder<RefTable> resultTable (makeRefTable (True, 0));
-    Bool val;
-    uInt nrrow = nrow();
-    TableExprId id;
-    for (uInt i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
+    const uInt maxBlockSize = 4096;
+    uInt blockSize = (maxRow == 0  ?  maxBlockSize : 64);
+    uInt nblock = (nthread > 1  ?  4*nthread : 1);
+    uInt nrrow = (useRows  ?  rows.nelements() : nrow());
+    Bool useBits = (maxRow == 0);
+    Block<uInt> bits (useBits ? (nrrow+31) / 32 : 0, 0u);
+    uInt nrsel = 0;
+    Block<Bool> mask;
+    Bool done = False;
+    for (uInt st=0; st<nrrow && !done;) {
+      uInt nr = std::min (nblock*blockSize, nrrow-st);
+      BaseTable_evalSelect (node, rows, useRows, st, nr, blockSize, nthread,
+                            mask);
+      for (uInt i=0; i<nr; i++) {
+        if (mask[i]) {
+          if (offset > 0) {
+            // Skip first offset matching rows.
+            offset--;
+          } else if (useBits) {
+            uInt inx = st+i;
+            bits[inx/32] |= 1u << (inx%32);
+            nrsel++;
+          } else {
+            resultTable->addRownr (useRows ? rows[st+i] : st+i);  // add row
+            // Stop if max #rows reached.
+            if (resultTable->nrow() == maxRow) {
+              done = True;
+              break;
+            }
+          }
+        }
+      }
+      st += nr;
+      blockSize = std::min (2*blockSize, maxBlockSize);
+    }
+    if (!useBits) {
+      adjustRownrs (resultTable->nrow(), *(resultTable->rowStorage()), False);
+    } else if (nrsel == nrow()) {
+      resultTable->setRootRownrs (rowNumbers());
+    } else {
+      Vector<uInt> rownrs(nrsel);
+      uInt* rowPtr = RefTable::getStorage (rownrs);
+      for (uInt i=0; i<bits.nelements(); i++) {
+        if (bits[i] != 0) {
+          for (uInt j=0; j<32; j++) {
+            if ((bits[i] & (1u << j)) != 0) {
+              uInt inx = 32*i + j;
+              *rowPtr++ = (useRows ? rows[inx] : inx);
+            }
           }
-        } else {
-          // Skip first offset matching rows.
-          offset--;
         }
       }
+      adjustRownrs (nrsel, rownrs, False);
+      resultTable->setRootRownrs (rownrs);
     }
-    adjustRownrs (resultTable->nrow(), *(resultTable->rowStorage()), False);
     return resultTable.transfer();
 }
 
@@ -1002,6 +1141,30 @@ void BaseTable::checkRowNumberThrow (uInt rownr) const
 		       + " in table " + tableName()));
 }
 
+Int BaseTable::getColumnSorted (const String& columnName)
+{
+    if (nrow() != sortedNrow_p  ||  getModifyCounter() != sortedModCount_p) {
+        sortedColumns_p.clear();
+        return -1;
+    }
+    std::map<String,Bool>::const_iterator iter =
+                                    sortedColumns_p.find (columnName);
+    if (iter == sortedColumns_p.end()) {
+        return -1;
+    }
+    return (iter->second ? 1 : 0);
+}
+
+void BaseTable::setColumnSorted (const String& columnName, Bool sorted)
+{
+    if (nrow() != sortedNrow_p  ||  getModifyCounter() != sortedModCount_p) {
+        sortedColumns_p.clear();
+        sortedNrow_p     = nrow();
+        sortedModCount_p = getModifyCounter();
+    }
+    sortedColumns_p[columnName] = sorted;
+}
+
 void BaseTable::showStructure (ostream& os, Bool showDataMans, Bool showColumns,
                                Bool showSubTables, Bool sortColumns)
 {
@@ -38,6 +38,7 @@
 #include <casacore/casa/Utilities/CountedPtr.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/IO/FileLocker.h>
+#include <map>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -339,7 +340,10 @@ public:
     // Select rows using the given expression (which can be null).
     // Skip first <src>offset</src> matching rows.
     // Return at most <src>maxRow</src> matching rows.
-    BaseTable* select (const TableExprNode&, uInt maxRow, uInt offset);
+    // The expression is evaluated by <src>nthread</src> threads if it is
+    // thread-safe; 0 means using aipsrc variable table.taql.nthreads.
+    BaseTable* select (const TableExprNode&, uInt maxRow, uInt offset,
+                       uInt nthread=0);
 
     // Select maxRow rows and skip first offset rows. maxRow=0 means all.
     BaseTable* select (uInt maxRow, uInt offset);
@@ -472,6 +476,17 @@ public:
     int traceId() const
         { return itsTraceId; }
 
+    // Get or set the cached flag telling if the values of a scalar column
+    // are in ascending order. It is used by the TaQL selection planner
+    // (see class TableExprPlanner) to avoid reading the column each time.
+    // The cache is cleared if the number of rows or the modify counter
+    // of the table has changed.
+    // <src>getColumnSorted</src> returns -1 if the flag is not known.
+    // <group>
+    Int getColumnSorted (const String& columnName);
+    void setColumnSorted (const String& columnName, Bool sorted);
+    // </group>
+
 
 protected:
     uInt           nrlink_p;            //# #references to this table
@@ -485,6 +500,9 @@ protected:
     TableInfo      info_p;              //# Table information (type, etc.)
     Bool           madeDir_p;           //# True = table dir has been created
     int            itsTraceId;          //# table-id for TableTrace tracing
+    std::map<String,Bool> sortedColumns_p; //# cached column sort flags
+    uInt           sortedNrow_p;        //# #rows when flags were cached
+    uInt           sortedModCount_p;    //# modify counter of cached flags
 
 
     // Do the callback for scratch tables (if callback is set).
@@ -31,12 +31,26 @@
 #include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/BaseTable.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/Containers/BlockIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/casa/Utilities/Regex.h>
 #include <casacore/casa/Containers/RecordField.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -83,6 +97,7 @@ void ColumnsIndex::copy (const ColumnsIndex& that)
     itsTable = that.itsTable;
     itsNrrow   = itsTable.nrow();
     itsNoSort  = that.itsNoSort;
+    itsFromFile = False;
     itsCompare = that.itsCompare;
     makeObjects (that.itsLowerKeyPtr->description());
   }
@@ -189,6 +204,7 @@ void ColumnsIndex::create (const Table& table,
   itsNrrow = itsTable.nrow();
   itsCompare = (compareFunction == 0  ?  compare : compareFunction);
   itsNoSort = noSort;
+  itsFromFile = False;
   // Loop through all column names.
   // Always add it to the RecordDesc.
   RecordDesc description;
@@ -315,6 +331,19 @@ void ColumnsIndex::readData()
   if (!itsChanged) {
     return;
   }
+  // Use a persistent index if possible and up to date.
+  // It can only be done if all columns have to be read.
+  Bool allChanged = True;
+  for (uInt i=0; i<itsColumnChanged.nelements(); i++) {
+    if (!itsColumnChanged[i]) {
+      allChanged = False;
+    }
+  }
+  itsFromFile = False;
+  Bool usePersistent = (allChanged  &&  canBePersistent());
+  if (usePersistent  &&  readPersistent()) {
+    return;
+  }
   Sort sort;
   Bool deleteIt;
   const RecordDesc& desc = itsLowerKeyPtr->description();
@@ -441,6 +470,320 @@ void ColumnsIndex::readData()
   itsDataInx = itsDataIndex.getStorage (deleteIt);
   itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
   itsChanged = False;
+  // Rewrite an outdated persistent index (if possible).
+  if (usePersistent
+  &&  File(persistentName(itsTable, columnNames())).isRegular()) {
+    try {
+      writePersistent();
+    } catch (AipsError&) {
+      // Ignore errors like a readonly table directory.
+    }
+  }
+}
+
+// Read or write the data vector of a key column.
+template<typename T>
+void ColumnsIndex_ioVector (AipsIO& aio, void* vec, Bool write)
+{
+  if (write) {
+    aio << *static_cast<Vector<T>*>(vec);
+  } else {
+    aio >> *static_cast<Vector<T>*>(vec);
+  }
+}
+
+// Test if the data vector of a key column contains a NaN.
+template<typename T>
+Bool ColumnsIndex_hasNaN (const void* vec)
+{
+  const Vector<T>& data = *static_cast<const Vector<T>*>(vec);
+  for (uInt i=0; i<data.nelements(); i++) {
+    if (isNaN (data[i])) {
+      return True;
+    }
+  }
+  return False;
+}
+
+// Get the names, sizes and modification times of the data files of a table.
+// They are stored in a persistent index to detect changes made by a process
+// not using table locking, which does not update the modify counter.
+void ColumnsIndex_dataFileStamp (const Table& table, Vector<String>& names,
+                                 Vector<Int64>& sizes, Vector<uInt>& mtimes)
+{
+  Directory dir(table.tableName());
+  std::vector<String> files;
+  for (DirectoryIterator iter(dir, Regex("table\\.(dat|f.*)"));
+       !iter.pastEnd(); iter++) {
+    files.push_back (iter.name());
+  }
+  std::sort (files.begin(), files.end());
+  uInt nfile = files.size();
+  names.resize (nfile);
+  sizes.resize (nfile);
+  mtimes.resize (nfile);
+  for (uInt i=0; i<nfile; i++) {
+    File file(table.tableName() + '/' + files[i]);
+    names[i]  = files[i];
+    sizes[i]  = (file.isRegular()  ?  RegularFile(file).size() : 0);
+    mtimes[i] = file.modifyTime();
+  }
+}
+
+String ColumnsIndex::persistentName (const Table& table,
+                                     const Vector<String>& columnNames)
+{
+  String name = table.tableName() + "/table.index";
+  for (uInt i=0; i<columnNames.nelements(); i++) {
+    name += '_' + columnNames[i];
+  }
+  return name;
+}
+
+Bool ColumnsIndex::hasPersistent (const Table& table,
+                                  const Vector<String>& columnNames)
+{
+  return File(persistentName(table, columnNames)).isRegular();
+}
+
+Bool ColumnsIndex::canUsePersistent (const Table& table,
+                                     const Vector<String>& columnNames)
+{
+  String fileName = persistentName (table, columnNames);
+  if (!canBePersistent(table)  ||  !File(fileName).isRegular()) {
+    return False;
+  }
+  const TableDesc& tdesc = table.tableDesc();
+  Block<Int> dataTypes(columnNames.nelements());
+  for (uInt i=0; i<columnNames.nelements(); i++) {
+    if (! tdesc.isColumn (columnNames[i])) {
+      return False;
+    }
+    dataTypes[i] = tdesc[columnNames[i]].dataType();
+  }
+  try {
+    AipsIO aio(fileName);
+    return readPersistentHeader (aio, table, columnNames, dataTypes);
+  } catch (AipsError&) {
+    return False;
+  }
+}
+
+Bool ColumnsIndex::canBePersistent() const
+{
+  return (!itsNoSort  &&  itsCompare == compare  &&
+          canBePersistent (itsTable));
+}
+
+Bool ColumnsIndex::canBePersistent (const Table& table)
+{
+  // Changes made by this process are not reflected in the modify counter
+  // until the table is flushed, so a writable table cannot use the file.
+  // Without locking the modify counter is not maintained at all.
+  return (table.tableType() == Table::Plain  &&
+          table.isRootTable()  &&  !table.isWritable()  &&
+          table.lockOptions().option() != TableLock::NoLocking);
+}
+
+Bool ColumnsIndex::readPersistentHeader (AipsIO& aio, const Table& table,
+                                         const Vector<String>& names,
+                                         const Block<Int>& dataTypes)
+{
+  uInt version = aio.getstart ("ColumnsIndex");
+  if (version < 2) {
+    return False;
+  }
+  uInt nrrow, modCounter;
+  Vector<String> fileNames;
+  Block<Int> fileTypes;
+  Vector<String> stampNames, curNames;
+  Vector<Int64> stampSizes, curSizes;
+  Vector<uInt> stampTimes, curTimes;
+  aio >> nrrow >> modCounter >> fileNames >> fileTypes
+      >> stampNames >> stampSizes >> stampTimes;
+  ColumnsIndex_dataFileStamp (table, curNames, curSizes, curTimes);
+  Bool match = (nrrow == table.nrow()  &&
+                modCounter == table.baseTablePtr()->getModifyCounter()  &&
+                fileNames.nelements() == names.nelements()  &&
+                allEQ (fileNames, names)  &&
+                fileTypes.nelements() == dataTypes.nelements()  &&
+                stampNames.nelements() == curNames.nelements()  &&
+                allEQ (stampNames, curNames)  &&
+                allEQ (stampSizes, curSizes)  &&
+                allEQ (stampTimes, curTimes));
+  for (uInt i=0; match && i<dataTypes.nelements(); i++) {
+    match = (fileTypes[i] == dataTypes[i]);
+  }
+  return match;
+}
+
+Bool ColumnsIndex::readPersistent()
+{
+  Vector<String> names = columnNames();
+  String fileName = persistentName (itsTable, names);
+  if (! File(fileName).isRegular()) {
+    return False;
+  }
+  try {
+    AipsIO aio(fileName);
+    if (! readPersistentHeader (aio, itsTable, names, itsDataTypes)) {
+      return False;
+    }
+    Bool deleteIt;
+    for (uInt i=0; i<itsDataTypes.nelements(); i++) {
+      switch (itsDataTypes[i]) {
+      case TpBool:
+        ColumnsIndex_ioVector<Bool> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<Bool>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpUChar:
+        ColumnsIndex_ioVector<uChar> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<uChar>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpShort:
+        ColumnsIndex_ioVector<Short> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<Short>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpInt:
+        ColumnsIndex_ioVector<Int> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<Int>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpUInt:
+        ColumnsIndex_ioVector<uInt> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<uInt>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpFloat:
+        ColumnsIndex_ioVector<Float> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<Float>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpDouble:
+        ColumnsIndex_ioVector<Double> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<Double>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpComplex:
+        ColumnsIndex_ioVector<Complex> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<Complex>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpDComplex:
+        ColumnsIndex_ioVector<DComplex> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<DComplex>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      case TpString:
+        ColumnsIndex_ioVector<String> (aio, itsDataVectors[i], False);
+        itsData[i] = ((Vector<String>*)itsDataVectors[i])->getStorage (deleteIt);
+        break;
+      default:
+        throw (TableError ("ColumnsIndex: unknown data type"));
+      }
+    }
+    aio >> itsDataIndex >> itsUniqueIndex;
+    aio.getend();
+  } catch (AipsError&) {
+    // A corrupt file is ignored; all columns are reread.
+    itsColumnChanged.set (True);
+    return False;
+  }
+  Bool deleteIt;
+  itsDataInx = itsDataIndex.getStorage (deleteIt);
+  itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
+  itsColumnChanged.set (False);
+  itsChanged = False;
+  itsFromFile = True;
+  return True;
+}
+
+void ColumnsIndex::writePersistent() const
+{
+  Vector<String> names = columnNames();
+  // Write into a temporary file which is renamed at the end, so other
+  // processes cannot see a partially written file. The name is unique,
+  // because several readers can rewrite an outdated index at the same time.
+  String fileName = persistentName (itsTable, names);
+  String tmpName = File::newUniqueName (itsTable.tableName(),
+                                        "table.index_tmp").absoluteName();
+  Vector<String> stampNames;
+  Vector<Int64> stampSizes;
+  Vector<uInt> stampTimes;
+  ColumnsIndex_dataFileStamp (itsTable, stampNames, stampSizes, stampTimes);
+  {
+    AipsIO aio(tmpName, ByteIO::New);
+    aio.putstart ("ColumnsIndex", 2);
+    aio << itsNrrow << itsTable.baseTablePtr()->getModifyCounter()
+        << names << itsDataTypes
+        << stampNames << stampSizes << stampTimes;
+    for (uInt i=0; i<itsDataTypes.nelements(); i++) {
+      Bool hasNaN = False;
+      switch (itsDataTypes[i]) {
+      case TpBool:
+        ColumnsIndex_ioVector<Bool> (aio, itsDataVectors[i], True);
+        break;
+      case TpUChar:
+        ColumnsIndex_ioVector<uChar> (aio, itsDataVectors[i], True);
+        break;
+      case TpShort:
+        ColumnsIndex_ioVector<Short> (aio, itsDataVectors[i], True);
+        break;
+      case TpInt:
+        ColumnsIndex_ioVector<Int> (aio, itsDataVectors[i], True);
+        break;
+      case TpUInt:
+        ColumnsIndex_ioVector<uInt> (aio, itsDataVectors[i], True);
+        break;
+      case TpFloat:
+        hasNaN = ColumnsIndex_hasNaN<Float> (itsDataVectors[i]);
+        ColumnsIndex_ioVector<Float> (aio, itsDataVectors[i], True);
+        break;
+      case TpDouble:
+        hasNaN = ColumnsIndex_hasNaN<Double> (itsDataVectors[i]);
+        ColumnsIndex_ioVector<Double> (aio, itsDataVectors[i], True);
+        break;
+      case TpComplex:
+        hasNaN = ColumnsIndex_hasNaN<Complex> (itsDataVectors[i]);
+        ColumnsIndex_ioVector<Complex> (aio, itsDataVectors[i], True);
+        break;
+      case TpDComplex:
+        hasNaN = ColumnsIndex_hasNaN<DComplex> (itsDataVectors[i]);
+        ColumnsIndex_ioVector<DComplex> (aio, itsDataVectors[i], True);
+        break;
+      case TpString:
+        ColumnsIndex_ioVector<String> (aio, itsDataVectors[i], True);
+        break;
+      default:
+        throw (TableError ("ColumnsIndex: unknown data type"));
+      }
+      // A NaN value makes the sort order undefined.
+      if (hasNaN) {
+        aio.close();
+        RegularFile(tmpName).remove();
+        throw (TableError ("ColumnsIndex: column " + names[i] +
+                           " contains NaN values; the index cannot be"
+                           " made persistent"));
+      }
+    }
+    aio << itsDataIndex << itsUniqueIndex;
+    aio.putend();
+  }
+  RegularFile(tmpName).move (fileName);
+}
+
+void ColumnsIndex::makePersistent()
+{
+  if (itsTable.tableType() != Table::Plain  ||  !itsTable.isRootTable()) {
+    throw (TableError ("ColumnsIndex: a persistent index can only be made"
+                       " for a plain table"));
+  }
+  if (itsNoSort  ||  itsCompare != compare) {
+    throw (TableError ("ColumnsIndex: a persistent index cannot be made"
+                       " if noSort or a specific compare function is used"));
+  }
+  // Make sure all changes are written, so the modify counter is up to date.
+  if (itsTable.isWritable()) {
+    itsTable.flush();
+  }
+  TableLocker locker(itsTable, FileLocker::Read);
+  setChanged();
+  readData();
+  writePersistent();
 }
 
 uInt ColumnsIndex::bsearch (Bool& found, const Block<void*>& fieldPtrs) const
@@ -110,6 +110,24 @@ template<typename T> class RecordFieldPtr;
 // <br>If data have changed, the entire index will be recreated by
 // rereading and optionally resorting the data. This will be deferred
 // until the next key lookup.
+// <p>
+// Creating an index requires reading and sorting the key columns,
+// which is done each time a process creates the index.
+// Function <src>makePersistent</src> writes the index into a file in the
+// table directory, so it can be reused by other processes (or objects)
+// creating an index on the same columns. The file is only used if the
+// default compare function is used, the table is a plain table opened
+// readonly with locking, and the number of rows, the modify counter, and
+// the sizes and modification times of the table's data files match the
+// values at the time the file was written. The latter detects changes
+// made by processes not using locking (with a resolution of one second).
+// Otherwise the index is created in the normal way. In that case an
+// outdated file is rewritten if the table directory is writable, thus a
+// persistent index is kept up to date automatically when the table has
+// changed.
+// <br>Note that changes in a table only become visible to other
+// processes (and hence to the persistent index) after the table
+// has been flushed or unlocked.
 // </synopsis>
 
 // <example>
@@ -339,6 +357,28 @@ public:
     // The data type may differ.
     static void copyKeyField (void* field, int dtype, const Record& key);
 
+    // Write the index into a file in the table directory, so other
+    // processes do not need to read and sort the key columns again.
+    // If the table is writable, it is flushed first.
+    // An exception is thrown if the table is not a plain table, if a
+    // specific compare function or <src>noSort=True</src> is used, or if
+    // a floating point key column contains a NaN value.
+    void makePersistent();
+
+    // Test if a persistent index file exists for the given columns.
+    // It does not test if the file is up to date.
+    static Bool hasPersistent (const Table&, const Vector<String>& columnNames);
+
+    // Test if the persistent index file for the given columns can be used,
+    // thus if it exists and is up to date and if the table can use it
+    // (i.e., is a plain table opened readonly with locking).
+    // Only the header of the file is read.
+    static Bool canUsePersistent (const Table&,
+                                  const Vector<String>& columnNames);
+
+    // Tell if the index data have been read from a persistent index file.
+    Bool isFromFile() const;
+
 protected:
     // Copy that object to this.
     void copy (const ColumnsIndex& that);
@@ -380,6 +420,29 @@ protected:
     // <src>itsUniqueIndex</src> vector (end is not inclusive).
     void fillRowNumbers (Vector<uInt>& rows, uInt start, uInt end) const;
 
+    // Get the name of the persistent index file for the given columns.
+    static String persistentName (const Table&,
+                                  const Vector<String>& columnNames);
+
+    // Test if the index can be read from or written into a persistent file.
+    Bool canBePersistent() const;
+
+    // Test if the table can use a persistent index file.
+    static Bool canBePersistent (const Table&);
+
+    // Read the header of a persistent index file and test if it matches
+    // the table and the given columns.
+    static Bool readPersistentHeader (AipsIO&, const Table&,
+                                      const Vector<String>& columnNames,
+                                      const Block<Int>& dataTypes);
+
+    // Read the index from its persistent file. It returns False if there
+    // is no file or if it is not up to date.
+    Bool readPersistent();
+
+    // Write the index into its persistent file.
+    void writePersistent() const;
+
 private:
     // Fill the internal key fields from the corresponding external key.
     void copyKey (Block<void*> fields, const Record& key);
@@ -406,6 +469,7 @@ private:
     Block<Bool>  itsColumnChanged;
     Bool         itsChanged;
     Bool         itsNoSort;            //# True = sort is not needed
+    Bool         itsFromFile;          //# True = read from persistent file
     Compare*     itsCompare;           //# Compare function
     Vector<uInt> itsDataIndex;         //# Row numbers of all keys
     //# Indices in itsDataIndex for each unique key
@@ -419,6 +483,10 @@ inline Bool ColumnsIndex::isUnique() const
 {
     return (itsDataIndex.nelements() == itsUniqueIndex.nelements());
 }
+inline Bool ColumnsIndex::isFromFile() const
+{
+    return itsFromFile;
+}
 inline const Table& ColumnsIndex::table() const
 {
     return itsTable;
@@ -95,6 +95,27 @@ Bool PlainColumn::isWritable() const
 Bool PlainColumn::isStored() const
     { return dataManPtr_p->isStorageManager(); }
 
+const void* PlainColumn::getColumnView (uInt rownr, uInt& nrrow) const
+{
+    if (rtraceColumn_p) {
+        nrrow = 0;
+        return 0;
+    }
+    checkReadLock (True);
+    const void* ptr = dataColPtr_p->getColumnViewV (rownr, nrrow);
+    autoReleaseLock();
+    return ptr;
+}
+
+Bool PlainColumn::getZoneMap (Vector<uInt>& lastRow, Vector<Double>& minVal,
+                              Vector<Double>& maxVal) const
+{
+    checkReadLock (True);
+    Bool fnd = dataColPtr_p->getZoneMap (lastRow, minVal, maxVal);
+    autoReleaseLock();
+    return fnd;
+}
+
 ColumnCache& PlainColumn::columnCache()
     { return dataColPtr_p->columnCache(); }
 
@@ -97,6 +97,15 @@ public:
     // Test if the column is stored (otherwise it is virtual).
     virtual Bool isStored() const;
 
+    // Get a direct readonly pointer to the data of the given row
+    // from the data manager column.
+    // No pointer is returned if reads of the column are traced.
+    virtual const void* getColumnView (uInt rownr, uInt& nrrow) const;
+
+    // Get the zone map of the column from the data manager.
+    virtual Bool getZoneMap (Vector<uInt>& lastRow, Vector<Double>& minVal,
+                             Vector<Double>& maxVal) const;
+
     // Get access to the column keyword set.
     // <group>
     TableRecord& rwKeywordSet();
@@ -36,6 +36,7 @@
 #include <casacore/tables/Tables/TableTrace.h>
 #include <casacore/tables/Tables/PlainColumn.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/TableFlushHandle.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/BasicSL/String.h>
@@ -481,7 +482,7 @@ uInt PlainTable::getModifyCounter() const
 void PlainTable::flush (Bool fsync, Bool recursive)
 {
     if (openedForWrite()) {
-	putFile (False);
+	putFile (False, fsync);
 	// Flush subtables if wanted.
 	if (recursive) {
 	    keywordSet().flushTables (fsync);
@@ -515,7 +516,7 @@ void PlainTable::resync()
 }
 
 
-Bool PlainTable::putFile (Bool always)
+Bool PlainTable::putFile (Bool always, Bool fsync)
 {
     TableTrace::traceFile (itsTraceId, "flush");
     Bool writeTab = always || tableChanged_p;
@@ -530,13 +531,13 @@ Bool PlainTable::putFile (Bool always)
 	writeStart (ios, bigEndian_p);
 	ios << "PlainTable";
 	tdescPtr_p->putFile (ios, attr);                 // write description
-	colSetPtr_p->putFile (True, ios, attr, False);   // write column data
+	colSetPtr_p->putFile (True, ios, attr, fsync);   // write column data
 	writeEnd (ios);
 	//# Write the TableInfo.
 	flushTableInfo();
       } else {
         //# Tell the data managers to write their data only.
-        if (colSetPtr_p->putFile (False, ios, attr, False)) {
+        if (colSetPtr_p->putFile (False, ios, attr, fsync)) {
 	    written = True;
 #ifdef AIPS_TRACE
 	    cout << "  data PlainTable::putFile on " << tableName() << endl;
@@ -544,6 +545,11 @@ Bool PlainTable::putFile (Bool always)
 	}
       }
     }
+    // Make sure the table files themselves are on disk as well.
+    if (writeTab  &&  fsync) {
+        TableFlushHandle::fsyncFile (Table::fileName(name_p));
+        TableFlushHandle::fsyncFile (name_p + "/table.info");
+    }
     // Write the change info if anything has been written.
     if (written) {
         lockSync_p.write (nrrow_p, tdescPtr_p->ncolumn(), tableChanged_p,
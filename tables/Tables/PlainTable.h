@@ -278,7 +278,8 @@ private:
     // Tell the storage managers to flush and close their files.
     // It returns a switch to tell if the table control information has
     // been written.
-    Bool putFile (Bool always);
+    // If <src>fsync=True</src>, the files written are fsync-ed.
+    Bool putFile (Bool always, Bool fsync=False);
 
     // Synchronize the table after having acquired a lock which says
     // that main table data has changed.
@@ -123,10 +123,19 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
     tdescPtr_p = new TableDesc (btp->tableDesc(), TableDesc::Scratch);
     setup (btp, Vector<String>());
     //# Store the rownr if the mask is set.
+    //# Count first, so the row number vector is allocated only once.
     uInt nr = min (mask.nelements(), btp->nrow());
+    uInt nrsel = 0;
     for (uInt i=0; i<nr; i++) {
 	if (mask(i)) {
-	    addRownr (i);
+	    nrsel++;
+	}
+    }
+    rowStorage_p.resize (nrsel);
+    rows_p = getStorage (rowStorage_p);
+    for (uInt i=0; i<nr; i++) {
+	if (mask(i)) {
+	    rows_p[nrrow_p++] = i;
 	}
     }
     //# Adjust rownrs in case input table is a reference table.
@@ -527,6 +536,15 @@ void RefTable::setNrrow (uInt nrrow)
     changed_p = True;
 }
 
+//# Reference the given root rownrs.
+void RefTable::setRootRownrs (const Vector<uInt>& rownrs)
+{
+    rowStorage_p.reference (rownrs);
+    rows_p = getStorage (rowStorage_p);
+    nrrow_p = rowStorage_p.nelements();
+    changed_p = True;
+}
+
 
 //# Test if the parent table is writable.
 Bool RefTable::isWritable() const
@@ -782,6 +800,9 @@ void RefTable::removeRow (uInt rownr)
 	throw (TableInvOper ("removeRow: rownr out of bounds"));
     }
     if (rownr < nrrow_p - 1) {
+	//# The row numbers can be shared with another RefTable.
+	rowStorage_p.unique();
+	rows_p = getStorage (rowStorage_p);
 	objmove (rows_p+rownr, rows_p+rownr+1, nrrow_p-rownr-1);
     }
     nrrow_p--;
@@ -310,6 +310,13 @@ public:
     // An exception is thrown if more than current nrrow.
     void setNrrow (uInt nrrow);
 
+    // Replace the row numbers by the given row numbers in the root table.
+    // The vector is referenced, not copied. Thus when all rows of another
+    // RefTable are selected, its row numbers can be shared instead of
+    // materialising a new vector. Functions changing row numbers in place
+    // (like removeRow) make a private copy first.
+    void setRootRownrs (const Vector<uInt>& rownrs);
+
     // Adjust the row numbers to be the actual row numbers in the
     // root table. This is, for instance, used when a RefTable is sorted.
     // Optionally it also determines if the resulting rows are in row order.
@@ -181,6 +181,20 @@ public:
     // and stride of the rows to get..
     Vector<T> getColumnRange (const Slicer& rowRange) const;
 
+    // Get a readonly view of the values in the column starting at the
+    // given row. The view refers directly to the data in the storage
+    // manager (e.g. a memory-mapped file), so no data are copied.
+    // The view can contain fewer rows than remaining in the column
+    // (e.g. only till the end of a bucket), so the function has to be
+    // called repeatedly to iterate through the column.
+    // <br>False is returned (and the view is made empty) if no direct access
+    // is possible. In that case getColumnRange has to be used.
+    // Currently only StandardStMan can give direct access if the data are
+    // stored in the native format.
+    // <br>Note that the data in the view are readonly and are only valid
+    // as long as the column is not changed and the table is open.
+    Bool getColumnView (uInt rownr, Vector<T>& view) const;
+
     // Get the vector of some values in the column.
     // The Slicer object can be used to specify start, end (or length),
     // and stride of the rows to get.
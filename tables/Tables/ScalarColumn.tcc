@@ -37,6 +37,7 @@
 #include <casacore/casa/Utilities/ValTypeId.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -121,6 +122,22 @@ void ScalarColumn<T>::checkDataType() const
 }
 
 
+template<class T>
+Bool ScalarColumn<T>::getColumnView (uInt rownr, Vector<T>& view) const
+{
+    TABLECOLUMNCHECKROW(rownr);
+    uInt nr;
+    const T* ptr = static_cast<const T*>
+                           (baseColPtr_p->getColumnView (rownr, nr));
+    if (ptr == 0  ||  nr == 0) {
+	view.resize (0);
+	return False;
+    }
+    nr = std::min (nr, nrow() - rownr);
+    view.takeStorage (IPosition(1,nr), const_cast<T*>(ptr), SHARE);
+    return True;
+}
+
 template<class T>
 Vector<T> ScalarColumn<T>::getColumn() const
 {
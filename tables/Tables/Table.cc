@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/ConcatTable.h>
 #include <casacore/tables/Tables/NullTable.h>
 #include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableFlushHandle.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLock.h>
@@ -480,6 +481,41 @@ Table Table::copyToMemoryTable (const String& newName, Bool noRows) const
 }
 
 
+TableFlushHandle Table::flushAsync (SyncOption syncOption, Bool recursive)
+{
+    // Write the data without fsync-ing them.
+    flush (False, recursive);
+    if (syncOption == NoSync  ||  !isWritable()
+    ||  !File(tableName()).isDirectory()) {
+        return TableFlushHandle();
+    }
+    return TableFlushHandle (TableFlushHandle::tableFiles
+                             (tableName(), syncOption == SyncData, recursive));
+}
+
+Table Table::threadCopy() const
+{
+    throwIfNull();
+    // Do not link to the tables involved, because the reference count
+    // may be changed by other threads.
+    BaseTable* root = baseTabPtr_p->root();
+    if (dynamic_cast<PlainTable*>(root) == 0) {
+        throw TableInvOper ("Table::threadCopy: table " + tableName() +
+                            " is not a plain table or selection of it");
+    }
+    // Do not add the copy to the table cache and do not use locking,
+    // so it is independent of the table already open.
+    BaseTable* btab = makeBaseTable (root->tableName(), "", Table::Old,
+                                     TableLock(TableLock::NoLocking),
+                                     TSMOption(), False, 0);
+    Table tab(btab);
+    if (root == baseTabPtr_p) {
+        return tab;
+    }
+    return tab(baseTabPtr_p->rowNumbers());
+}
+
+
 //# Open the table file and read it in if necessary.
 void Table::open (const String& name, const String& type, int tableOption,
 		  const TableLock& lockOptions, const TSMOption& tsmOpt)
@@ -838,8 +874,8 @@ TableExprNode Table::nodeRandom () const
 
 //# Select rows based on an expression.
 Table Table::operator() (const TableExprNode& expr,
-                         uInt maxRow, uInt offset) const
-    { return Table (baseTabPtr_p->select (expr, maxRow, offset)); }
+                         uInt maxRow, uInt offset, uInt nthread) const
+    { return Table (baseTabPtr_p->select (expr, maxRow, offset, nthread)); }
 //# Select rows based on row numbers.
 Table Table::operator() (const Vector<uInt>& rownrs) const
     { return Table (baseTabPtr_p->select (rownrs)); }
@@ -48,6 +48,7 @@ class Record;
 class TableExprNode;
 class DataManager;
 class IPosition;
+class TableFlushHandle;
 template<class T> class Vector;
 template<class T> class Block;
 template<class T> class CountedPtr;
@@ -158,6 +159,8 @@ friend class TableIterator;
 friend class RODataManAccessor;
 friend class TableExprNode;
 friend class TableExprNodeRep;
+friend class TableExprPlanner;
+friend class ColumnsIndex;
 
 public:
     // Define the possible options how a table can be opened.
@@ -197,6 +200,16 @@ public:
 	AipsrcEndian
     };
 
+    // Define how an asynchronous flush ensures the data are on disk.
+    enum SyncOption {
+        // Do not fsync; the data are only handed over to the system.
+        NoSync,
+        // Fsync the data files of the data managers.
+        SyncData,
+        // Fsync all table files (thus also table.dat and table.info).
+        SyncAll
+    };
+
 
     // Define the signature of the function being called when the state
     // of a scratch table changes (i.e. created, closed, renamed,
@@ -491,6 +504,18 @@ public:
     // <br>If <src>recursive=True</src> all subtables are flushed too.
     void flush (Bool fsync=False, Bool recursive=False);
 
+    // Flush the table like <src>flush</src>, but fsync the files (as
+    // defined by <src>syncOption</src>) in a background thread.
+    // The data are written before the function returns, so the table can
+    // be changed again right away.
+    // The returned handle (see class
+    // <linkto class=TableFlushHandle>TableFlushHandle</linkto>) can be used
+    // to wait until the data written by this flush are on disk.
+    // <br>If <src>recursive=True</src> all subtables are flushed too.
+    // Only the files of subtables in the table directory are fsync-ed.
+    TableFlushHandle flushAsync (SyncOption syncOption=SyncAll,
+                                 Bool recursive=False);
+
     // Resynchronize the Table object with the table file.
     // This function is only useful if no read-locking is used, ie.
     // if the table lock option is UserNoReadLocking or AutoNoReadLocking.
@@ -687,6 +712,21 @@ public:
     // Use the given name for the memory table.
     Table copyToMemoryTable (const String& name, Bool noRows=False) const;
 
+    // Open a private readonly copy of this table meant to be used by
+    // another thread. The copy has its own data manager objects and
+    // caches and is not added to the table cache. In this way multiple
+    // threads can read the same table concurrently without any
+    // synchronization between them; each thread should make its own copy
+    // (before it is used by other threads) and use its own column objects.
+    // <br>The copy reads the table as stored on disk, so the table should
+    // be flushed before if it has been changed. It does not use locking,
+    // thus it does not see later changes made by other processes.
+    // Subtables are opened as usual, so they are shared between threads.
+    // <br>If this table is a selection of a plain table, the copy contains
+    // the same selection of a copy of the plain table.
+    // An exception is thrown for other types of tables (e.g. MemoryTable).
+    Table threadCopy() const;
+
     // Get the table type.
     TableType tableType() const;
 
@@ -800,7 +840,15 @@ public:
     // when <src>maxRow</src> rows are selected.
     // <br>The TableExprNode argument can be empty (null) meaning that only
     // the <src>maxRow/offset</src> arguments are taken into account.
-    Table operator() (const TableExprNode&, uInt maxRow=0, uInt offset=0) const;
+    // <br>If the expression is thread-safe (i.e., only uses scalar columns,
+    // constants and operators), it can be evaluated by multiple threads,
+    // each handling a part of the rows. The result is the same as
+    // sequential evaluation. <src>nthread=0</src> means using the value
+    // of the aipsrc variable <src>table.taql.nthreads</src> (default 1),
+    // where a value 0 means the number of OpenMP threads
+    // (see OMP_NUM_THREADS).
+    Table operator() (const TableExprNode&, uInt maxRow=0, uInt offset=0,
+                      uInt nthread=0) const;
 
     // Select rows using a vector of row numbers.
     // This can, for instance, be used to select the same rows as
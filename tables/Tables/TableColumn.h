@@ -373,6 +373,15 @@ public:
     void setMaximumCacheSize (uInt nbytes) const
         { baseColPtr_p->setMaximumCacheSize (nbytes); }
 
+    // Get the zone map of a scalar column, i.e. the minimum and maximum
+    // value in consecutive blocks of rows as kept by the storage manager
+    // (see <linkto class=DataManagerColumn>DataManagerColumn</linkto>).
+    // Block i ends at row <src>lastRow[i]</src>.
+    // False is returned if no zone map is available.
+    Bool getZoneMap (Vector<uInt>& lastRow, Vector<Double>& minVal,
+                     Vector<Double>& maxVal) const
+        { return baseColPtr_p->getZoneMap (lastRow, minVal, maxVal); }
+
 protected:
     BaseTable*  baseTabPtr_p;
     BaseColumn* baseColPtr_p;                //# pointer to real column object
@@ -0,0 +1,230 @@
+//# TableFlushHandle.cc: Handle to wait for a table flush done in the background
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/TableFlushHandle.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Containers/Block.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// The state of a flush shared by the copies of a TableFlushHandle.
+class TableFlushState
+{
+public:
+    explicit TableFlushState (const Vector<String>& fileNames);
+    ~TableFlushState();
+    Bool isDone();
+    // Wait for the thread and return the error message (empty if none).
+    String wait();
+    // Fsync all files and keep the first error message.
+    void doFsync();
+private:
+    Vector<String> itsFileNames;
+    String         itsError;
+#ifdef USE_THREADS
+    static void* run (void* state);
+    pthread_t       itsThread;
+    pthread_mutex_t itsMutex;
+    Bool            itsDone;
+    Bool            itsJoined;
+#endif
+};
+
+TableFlushState::TableFlushState (const Vector<String>& fileNames)
+  : itsFileNames (fileNames.copy())
+{
+#ifdef USE_THREADS
+    itsDone   = False;
+    itsJoined = False;
+    pthread_mutex_init (&itsMutex, 0);
+    if (pthread_create (&itsThread, 0, &TableFlushState::run, this) != 0) {
+        // Do it synchronously if no thread can be started.
+        itsJoined = True;
+        doFsync();
+    }
+#else
+    doFsync();
+#endif
+}
+
+TableFlushState::~TableFlushState()
+{
+    wait();
+#ifdef USE_THREADS
+    pthread_mutex_destroy (&itsMutex);
+#endif
+}
+
+void TableFlushState::doFsync()
+{
+    String error;
+    for (uInt i=0; i<itsFileNames.nelements(); ++i) {
+        String msg = TableFlushHandle::fsyncFile (itsFileNames[i]);
+        if (error.empty()) {
+            error = msg;
+        }
+    }
+#ifdef USE_THREADS
+    pthread_mutex_lock (&itsMutex);
+    itsError = error;
+    itsDone  = True;
+    pthread_mutex_unlock (&itsMutex);
+#else
+    itsError = error;
+#endif
+}
+
+#ifdef USE_THREADS
+void* TableFlushState::run (void* state)
+{
+    static_cast<TableFlushState*>(state)->doFsync();
+    return 0;
+}
+#endif
+
+Bool TableFlushState::isDone()
+{
+#ifdef USE_THREADS
+    pthread_mutex_lock (&itsMutex);
+    Bool done = itsDone;
+    pthread_mutex_unlock (&itsMutex);
+    return done;
+#else
+    return True;
+#endif
+}
+
+String TableFlushState::wait()
+{
+#ifdef USE_THREADS
+    if (! itsJoined) {
+        pthread_join (itsThread, 0);
+        itsJoined = True;
+    }
+#endif
+    return itsError;
+}
+
+
+TableFlushHandle::TableFlushHandle()
+{}
+
+TableFlushHandle::TableFlushHandle (const Vector<String>& fileNames)
+  : itsState (new TableFlushState (fileNames))
+{}
+
+TableFlushHandle::TableFlushHandle (const TableFlushHandle& that)
+  : itsState (that.itsState)
+{}
+
+TableFlushHandle& TableFlushHandle::operator= (const TableFlushHandle& that)
+{
+    itsState = that.itsState;
+    return *this;
+}
+
+TableFlushHandle::~TableFlushHandle()
+{}
+
+Bool TableFlushHandle::isDone() const
+{
+    return itsState.null()  ||  itsState->isDone();
+}
+
+void TableFlushHandle::wait()
+{
+    if (! itsState.null()) {
+        String error = itsState->wait();
+        if (! error.empty()) {
+            throw TableError ("TableFlushHandle: " + error);
+        }
+    }
+}
+
+String TableFlushHandle::fsyncFile (const String& fileName)
+{
+    int fd = ::open (fileName.chars(), O_RDONLY);
+    if (fd < 0) {
+        return "could not open " + fileName + ": " + strerror(errno);
+    }
+    String msg;
+    if (::fsync (fd) != 0) {
+        msg = "could not fsync " + fileName + ": " + strerror(errno);
+    }
+    ::close (fd);
+    return msg;
+}
+
+Vector<String> TableFlushHandle::tableFiles (const String& tableName,
+                                             Bool dataOnly, Bool recursive)
+{
+    Block<String> names;
+    uInt nr = 0;
+    Directory dir(tableName);
+    DirectoryIterator iter(dir);
+    while (! iter.pastEnd()) {
+        String name = iter.name();
+        String fullName = dir.path().absoluteName() + '/' + name;
+        File file(fullName);
+        if (file.isDirectory()) {
+            if (recursive  &&  Table::isReadable (fullName)) {
+                Vector<String> subNames = tableFiles (fullName, dataOnly,
+                                                      recursive);
+                names.resize (nr + subNames.nelements());
+                for (uInt i=0; i<subNames.nelements(); ++i) {
+                    names[nr++] = subNames[i];
+                }
+            }
+        } else if (file.isRegular()) {
+            if (!dataOnly  ||  (name != "table.dat"  &&  name != "table.info"
+                                &&  name != "table.lock")) {
+                names.resize (nr+1);
+                names[nr++] = fullName;
+            }
+        }
+        iter++;
+    }
+    Vector<String> result(nr);
+    for (uInt i=0; i<nr; ++i) {
+        result[i] = names[i];
+    }
+    return result;
+}
+
+} //# NAMESPACE CASACORE - END
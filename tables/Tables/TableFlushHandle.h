@@ -0,0 +1,126 @@
+//# TableFlushHandle.h: Handle to wait for a table flush done in the background
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TABLEFLUSHHANDLE_H
+#define TABLES_TABLEFLUSHHANDLE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class TableFlushState;
+
+
+// <summary>
+// Handle to wait for a table flush done in the background
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTableFlush.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=Table>Table</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A TableFlushHandle is returned by <src>Table::flushAsync</src>.
+// The table data are written to the files when <src>flushAsync</src>
+// is called, but making sure they are physically on disk (using fsync)
+// is done in a background thread. Fsync-ing can take a long time
+// (especially on network file systems), so in this way a writer can
+// continue while the data are synced to disk.
+// <br>The handle can be used to test if the fsync has finished or
+// to wait for it. Copies of a handle refer to the same flush. The destructor
+// of the last copy waits for the fsync to finish.
+// <p>
+// If casacore is built without thread support, the fsync is done
+// synchronously when the handle is created.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms", Table::Update);
+//   ... write data
+//   TableFlushHandle handle = tab.flushAsync (Table::SyncData);
+//   ... continue computing and writing
+//   handle.wait();     // the data of the flush are on disk now
+// </srcblock>
+// </example>
+
+class TableFlushHandle
+{
+public:
+    // Create a handle for which nothing has to be done.
+    TableFlushHandle();
+
+    // Fsync the given files in a background thread.
+    explicit TableFlushHandle (const Vector<String>& fileNames);
+
+    // Copy constructor and assignment (reference semantics).
+    // <group>
+    TableFlushHandle (const TableFlushHandle&);
+    TableFlushHandle& operator= (const TableFlushHandle&);
+    // </group>
+
+    // The destructor of the last copy waits until the fsync has finished.
+    ~TableFlushHandle();
+
+    // Test if the fsync has finished.
+    Bool isDone() const;
+
+    // Wait until the fsync has finished.
+    // An exception is thrown if a file could not be fsync-ed.
+    void wait();
+
+    // Get the names of the files to fsync for a table.
+    // If <src>dataOnly=True</src>, only the data files are returned, thus
+    // not table.dat, table.info and table.lock.
+    // If <src>recursive=True</src>, the files of the subtables in the
+    // table directory are returned as well.
+    static Vector<String> tableFiles (const String& tableName,
+                                      Bool dataOnly, Bool recursive);
+
+    // Fsync the file with the given name.
+    // It returns an empty string if successful, otherwise the error message.
+    static String fsyncFile (const String& fileName);
+
+private:
+    CountedPtr<TableFlushState> itsState;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -31,15 +31,19 @@
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/Tables/TableLock.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayUtil.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Containers/RecordField.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/GenSort.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/stdio.h>
+#include <unistd.h>
 
 
 #include <casacore/casa/namespace.h>
@@ -325,6 +329,109 @@ void d()
     cout << "<<<" << endl;
 }
 
+// Get the rows in the table matching the keys by scanning the columns.
+Vector<uInt> scanRows (const Table& tab, Bool boolKey, uInt uintKey)
+{
+    ScalarColumn<Bool> abool(tab, "abool");
+    ScalarColumn<uInt> auint(tab, "auint");
+    Vector<uInt> rows(tab.nrow());
+    uInt nr = 0;
+    for (uInt i=0; i<tab.nrow(); i++) {
+        if (abool(i) == boolKey  &&  auint(i) == uintKey) {
+	    rows[nr++] = i;
+	}
+    }
+    rows.resize (nr, True);
+    return rows;
+}
+
+// Check the row numbers found by the index on abool,auint.
+void checkIndex (ColumnsIndex& colInx)
+{
+    const Table& tab = colInx.table();
+    RecordFieldPtr<Bool> abool (colInx.accessKey(), "abool");
+    RecordFieldPtr<uInt> auint (colInx.accessKey(), "auint");
+    for (uInt i=0; i<10; i++) {
+        *abool = (i%2 == 0);
+        *auint = i;
+	Vector<uInt> rows = colInx.getRowNumbers();
+	GenSort<uInt>::sort (rows);
+	AlwaysAssertExit (allEQ (rows, scanRows (tab, i%2 == 0, i)));
+    }
+}
+
+// Test persistent indices.
+void e()
+{
+    Vector<String> names = stringToVector("abool,auint");
+    {
+        Table tab("tColumnsIndex_tmp.data", Table::Update);
+	ColumnsIndex colInx (tab, names);
+	colInx.makePersistent();
+	AlwaysAssertExit (ColumnsIndex::hasPersistent (tab, names));
+	AlwaysAssertExit (! colInx.isFromFile());
+	// A writable table cannot use the persistent index.
+	ColumnsIndex colInx1 (tab, names);
+	AlwaysAssertExit (! colInx1.isFromFile());
+	checkIndex (colInx1);
+    }
+    {
+        // The index is read from the file, unless noSort is used.
+        Table tab("tColumnsIndex_tmp.data");
+	ColumnsIndex colInx (tab, names);
+	AlwaysAssertExit (colInx.isFromFile());
+	checkIndex (colInx);
+	ColumnsIndex colInx1 (tab, names, 0, True);
+	AlwaysAssertExit (! colInx1.isFromFile());
+    }
+    {
+        // Change the table, which makes the index outdated.
+        Table tab("tColumnsIndex_tmp.data", Table::Update);
+	ScalarColumn<uInt> auint(tab, "auint");
+	for (uInt i=0; i<tab.nrow(); i++) {
+	    auint.put (i, (i*7)%10);
+	}
+    }
+    {
+        // The outdated index is recreated and rewritten.
+        Table tab("tColumnsIndex_tmp.data");
+	ColumnsIndex colInx (tab, names);
+	AlwaysAssertExit (! colInx.isFromFile());
+	checkIndex (colInx);
+	ColumnsIndex colInx1 (tab, names);
+	AlwaysAssertExit (colInx1.isFromFile());
+	checkIndex (colInx1);
+    }
+    {
+        // Change the table in place without locking, so the modify counter
+        // is not updated. Wait a second to be sure the file time changes.
+        sleep (1);
+        Table tab("tColumnsIndex_tmp.data", TableLock(TableLock::NoLocking),
+		  Table::Update);
+	ScalarColumn<uInt> auint(tab, "auint");
+	for (uInt i=0; i<tab.nrow(); i++) {
+	    auint.put (i, (i*3)%10);
+	}
+    }
+    {
+        // A table opened without locking does not use the index.
+        Table tab("tColumnsIndex_tmp.data", TableLock(TableLock::NoLocking));
+	ColumnsIndex colInx (tab, names);
+	AlwaysAssertExit (! colInx.isFromFile());
+	checkIndex (colInx);
+    }
+    {
+        // The change is detected, so the index is recreated.
+        Table tab("tColumnsIndex_tmp.data");
+	ColumnsIndex colInx (tab, names);
+	AlwaysAssertExit (! colInx.isFromFile());
+	checkIndex (colInx);
+	ColumnsIndex colInx1 (tab, names);
+	AlwaysAssertExit (colInx1.isFromFile());
+	checkIndex (colInx1);
+    }
+}
+
 int main()
 {
     try {
@@ -332,6 +439,7 @@ int main()
 	b();
 	c();
 	d();
+	e();
     } catch (AipsError x) {
         cout << "Exception caught: " << x.getMesg() << endl;
 	return 1;
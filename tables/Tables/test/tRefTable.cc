@@ -30,6 +30,9 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
@@ -108,6 +111,39 @@ void makeRef()
   readTab ("tRefTable_tmp.dataref", 10, 4);
 }
 
+void selectChain()
+{
+  Table tab("tRefTable_tmp.data");
+  Table sel1 = tab(tab.col("ab") >= 2);
+  AlwaysAssertExit (sel1.nrow() == 8);
+  // Selecting all rows shares the row numbers.
+  Table sel2 = sel1(sel1.col("ab") < 100);
+  AlwaysAssertExit (allEQ (sel2.rowNumbers(tab), sel1.rowNumbers(tab)));
+  // Removing a row must not affect the table it was selected from.
+  sel2.removeRow (0);
+  AlwaysAssertExit (sel2.nrow() == 7);
+  AlwaysAssertExit (sel1.nrow() == 8);
+  AlwaysAssertExit (sel1.rowNumbers(tab)(0) == 2);
+  AlwaysAssertExit (sel2.rowNumbers(tab)(0) == 3);
+  // A partial selection maps to row numbers in the root table.
+  Table sel3 = sel1(sel1.col("ab") % 2 == 0);
+  Vector<uInt> exp(4);
+  exp(0) = 2; exp(1) = 4; exp(2) = 6; exp(3) = 8;
+  AlwaysAssertExit (allEQ (sel3.rowNumbers(tab), exp));
+  AlwaysAssertExit (sel3(sel3.col("ab") > 100).nrow() == 0);
+  // Limited number of rows and offset.
+  Table sel4 = tab(tab.col("ab") >= 2, 3, 1);
+  AlwaysAssertExit (sel4.nrow() == 3);
+  AlwaysAssertExit (sel4.rowNumbers(tab)(0) == 3);
+  // Selection using a mask.
+  Block<Bool> mask(8, False);
+  mask[1] = mask[5] = True;
+  Table sel5 = sel1(mask);
+  AlwaysAssertExit (sel5.nrow() == 2);
+  AlwaysAssertExit (sel5.rowNumbers(tab)(0) == 3);
+  AlwaysAssertExit (sel5.rowNumbers(tab)(1) == 7);
+}
+
 int main()
 {
   try {
@@ -115,6 +151,7 @@ int main()
     makeRef();
     readTab ("tRefTable_tmp.data", 10, 5);
     readTab ("tRefTable_tmp.dataref", 10, 4);
+    selectChain();
   } catch (AipsError x) {
     cout << "Caught an exception: " << x.getMesg() << endl;
     return 1;
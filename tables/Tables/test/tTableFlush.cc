@@ -0,0 +1,140 @@
+//# tTableFlush.cc: Test program for flushing a table asynchronously
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableFlushHandle.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for Table::flushAsync and class TableFlushHandle.
+// </summary>
+
+
+// Check if the file name is in the vector.
+Bool hasFile (const Vector<String>& names, const String& name)
+{
+  for (uInt i=0; i<names.nelements(); ++i) {
+    String tail = '/' + name;
+    if (names[i].length() >= tail.length()  &&
+        names[i].substr (names[i].length() - tail.length()) == tail) {
+      return True;
+    }
+  }
+  return False;
+}
+
+void testFiles()
+{
+  Vector<String> all = TableFlushHandle::tableFiles ("tTableFlush_tmp.tab",
+                                                     False, False);
+  Vector<String> data = TableFlushHandle::tableFiles ("tTableFlush_tmp.tab",
+                                                      True, False);
+  AlwaysAssertExit (hasFile (all, "table.dat"));
+  AlwaysAssertExit (hasFile (all, "table.f0"));
+  AlwaysAssertExit (hasFile (all, "table.f1"));
+  AlwaysAssertExit (! hasFile (data, "table.dat"));
+  AlwaysAssertExit (! hasFile (data, "table.lock"));
+  AlwaysAssertExit (hasFile (data, "table.f0"));
+  AlwaysAssertExit (hasFile (data, "table.f1"));
+  AlwaysAssertExit (TableFlushHandle::fsyncFile
+                    ("tTableFlush_tmp.tab/table.dat").empty());
+  AlwaysAssertExit (! TableFlushHandle::fsyncFile
+                    ("tTableFlush_tmp.tab/nonexisting").empty());
+}
+
+void testFlush()
+{
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("ssm"));
+    td.addColumn (ScalarColumnDesc<Int>("ism"));
+    SetupNewTable newtab("tTableFlush_tmp.tab", td, Table::New);
+    StandardStMan ssm;
+    IncrementalStMan ism;
+    newtab.bindAll (ssm);
+    newtab.bindColumn ("ism", ism);
+    Table tab(newtab);
+    ScalarColumn<Int> ssmCol(tab, "ssm");
+    ScalarColumn<Int> ismCol(tab, "ism");
+    // Flush after each batch of rows; wait for the previous flush only.
+    TableFlushHandle handle;
+    for (uInt j=0; j<10; ++j) {
+      uInt first = tab.nrow();
+      tab.addRow (100);
+      for (uInt i=first; i<tab.nrow(); ++i) {
+        ssmCol.put (i, i);
+        ismCol.put (i, i/10);
+      }
+      handle.wait();
+      AlwaysAssertExit (handle.isDone());
+      handle = tab.flushAsync (j%2==0 ? Table::SyncData : Table::SyncAll);
+    }
+    testFiles();
+    // Copies refer to the same flush.
+    TableFlushHandle handle2(handle);
+    handle2.wait();
+    AlwaysAssertExit (handle.isDone());
+    // Nothing has to be done without fsync.
+    TableFlushHandle handle3 = tab.flushAsync (Table::NoSync);
+    AlwaysAssertExit (handle3.isDone());
+    // A synchronous flush with fsync.
+    ssmCol.put (0, -1);
+    tab.flush (True);
+  }
+  Table tab("tTableFlush_tmp.tab");
+  AlwaysAssertExit (tab.nrow() == 1000);
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (ssmCol(i) == (i==0 ? -1 : Int(i)));
+    AlwaysAssertExit (ismCol(i) == Int(i/10));
+  }
+  // Nothing is done for a readonly table.
+  AlwaysAssertExit (tab.flushAsync().isDone());
+}
+
+int main()
+{
+  try {
+    testFlush();
+  } catch (AipsError& x) {
+    cout << "Exception caught: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
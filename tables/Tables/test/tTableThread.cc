@@ -0,0 +1,162 @@
+//# tTableThread.cc: Test program for reading a table in multiple threads
+//# Copyright (C) 2016
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for reading the same table in multiple threads using
+// Table::threadCopy.
+// </summary>
+
+
+void createTable (uInt nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ssm"));
+  td.addColumn (ScalarColumnDesc<Double>("ism"));
+  td.addColumn (ArrayColumnDesc<Float>("tsm", IPosition(1,4),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTableThread_tmp.tab", td, Table::New);
+  StandardStMan ssm("SSM", 512);
+  IncrementalStMan ism("ISM", 1000);
+  TiledColumnStMan tsm("TSM", IPosition(2,4,64));
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("ism", ism);
+  newtab.bindColumn ("tsm", tsm);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Double> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  Vector<Float> arr(4);
+  indgen (arr);
+  for (uInt i=0; i<nrrow; ++i) {
+    ssmCol.put (i, i);
+    ismCol.put (i, i/10);
+    tsmCol.put (i, arr + Float(i));
+  }
+}
+
+// Read all rows of the table and check the values.
+// It returns the number of errors found.
+uInt readTable (const Table& tab)
+{
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Double> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  Vector<Float> arr(4);
+  indgen (arr);
+  uInt nerr = 0;
+  // Read some rows more than once to exercise the caches.
+  for (uInt j=0; j<3; ++j) {
+    for (uInt i=0; i<tab.nrow(); ++i) {
+      uInt row = ssmCol(i);
+      if (ismCol(i) != row/10  ||  !allEQ (tsmCol(i), arr + Float(row))) {
+        nerr++;
+      }
+    }
+  }
+  return nerr;
+}
+
+void testThreads (uInt nrrow)
+{
+  Table tab("tTableThread_tmp.tab");
+  Table sel = tab(tab.col("ssm") >= Int(nrrow/2));
+  AlwaysAssertExit (sel.nrow() == nrrow - nrrow/2);
+  // Each thread makes its own copy of the table or selection.
+  Int nthread = 8;
+  Block<uInt> nerr(nthread, 0u);
+  Block<uInt> nread(nthread, 0u);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread)
+#endif
+  for (Int i=0; i<nthread; ++i) {
+    try {
+      Table copy = (i%2 == 0  ?  tab.threadCopy() : sel.threadCopy());
+      nread[i] = copy.nrow();
+      nerr[i] = readTable (copy);
+    } catch (AipsError&) {
+      nerr[i] = 1;
+    }
+  }
+  for (Int i=0; i<nthread; ++i) {
+    AlwaysAssertExit (nerr[i] == 0);
+    AlwaysAssertExit (nread[i] == (i%2==0 ? nrrow : nrrow - nrrow/2));
+  }
+  // The copy is not the table in the cache.
+  Table copy = tab.threadCopy();
+  AlwaysAssertExit (copy.isRootTable());
+  AlwaysAssertExit (copy.tableName() == tab.tableName());
+  AlwaysAssertExit (! copy.isWritable());
+  AlwaysAssertExit (readTable(copy) == 0);
+  AlwaysAssertExit (allEQ (sel.threadCopy().rowNumbers(), sel.rowNumbers()));
+}
+
+void testMemoryTable()
+{
+  Table tab("tTableThread_tmp.tab");
+  Table mtab = tab.copyToMemoryTable ("tTableThread_tmp.mem");
+  Bool failed = False;
+  try {
+    mtab.threadCopy();
+  } catch (TableInvOper&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    createTable (1000);
+    testThreads (1000);
+    testMemoryTable();
+  } catch (AipsError& x) {
+    cout << "Exception caught: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}